@@ -782,6 +782,252 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 int json_arr_encode(const struct json_obj_descr *descr, const void *val,
 		    json_append_bytes_t append_bytes, void *data);
 
+/** Deepest nesting of objects and arrays for the streaming parser and encoder. */
+#define JSON_STREAM_MAX_DEPTH 32
+
+/**
+ * @brief Token returned by the streaming parser
+ */
+struct json_stream_token {
+	/** JSON_TOK_OBJECT_START, JSON_TOK_OBJECT_END, JSON_TOK_ARRAY_START,
+	 * JSON_TOK_ARRAY_END, JSON_TOK_STRING, JSON_TOK_NUMBER, JSON_TOK_TRUE,
+	 * JSON_TOK_FALSE, JSON_TOK_NULL, or JSON_TOK_EOF at the end of the
+	 * value.
+	 */
+	enum json_tokens type;
+	/** True if the string is the key of an object member. */
+	bool key;
+	/** Text of a string, without the quotes and not unescaped, of a number
+	 * or of a literal. Only valid until the next call to the parser.
+	 */
+	const char *start;
+	/** Length of the text. */
+	size_t length;
+};
+
+/**
+ * @brief State of the streaming parser
+ *
+ * Members are internal, see @ref json_stream_parser_init.
+ */
+struct json_stream_parser {
+	const char *pos;
+	const char *end;
+	char *buf;
+	size_t buf_size;
+	size_t buf_len;
+	/* Bit set for each level of nesting which is an object */
+	uint32_t nesting;
+	uint8_t depth;
+	uint8_t expect;
+	/* Type of the token split between chunks, JSON_TOK_NONE if none */
+	uint8_t lex;
+	/* Position in a literal, or state of an escape sequence in a string */
+	uint8_t lex_pos;
+	bool last;
+};
+
+/**
+ * @brief Initialize the streaming parser
+ *
+ * Unlike json_obj_parse(), the streaming parser does not need the whole
+ * payload at once: it is fed chunks with json_stream_parser_feed(), as they are
+ * received, and the tokens are pulled one at a time with
+ * json_stream_parser_next(). The structure of the payload is validated, with
+ * the same liberties as json_obj_parse() for strings and numbers.
+ *
+ * Strings and numbers which are entirely in a chunk are returned in place. Those
+ * split between chunks are copied to @a buf, which must be large enough for
+ * the longest of them.
+ *
+ * @param parser Parser
+ * @param buf Buffer for the tokens split between chunks, or NULL
+ * @param buf_size Size of the buffer
+ */
+void json_stream_parser_init(struct json_stream_parser *parser, char *buf,
+			     size_t buf_size);
+
+/**
+ * @brief Give the next chunk of the payload to the streaming parser
+ *
+ * To be called at first, and then each time json_stream_parser_next() returns
+ * -EAGAIN. The chunk must be kept until then.
+ *
+ * @param parser Parser
+ * @param data Chunk
+ * @param len Length of the chunk, 0 at the end of the payload
+ */
+void json_stream_parser_feed(struct json_stream_parser *parser,
+			     const char *data, size_t len);
+
+/**
+ * @brief Get the next token from the streaming parser
+ *
+ * Commas and colons are checked but not returned. Once the value at the top
+ * level is complete, a JSON_TOK_EOF token is returned.
+ *
+ * @param parser Parser
+ * @param tok Token
+ *
+ * @retval 0 if a token was returned
+ * @retval -EAGAIN if the chunk is consumed, see json_stream_parser_feed()
+ * @retval -ENOMEM if the buffer is too small for a token
+ * @retval -EINVAL if the payload is not valid, or too deeply nested
+ */
+int json_stream_parser_next(struct json_stream_parser *parser,
+			    struct json_stream_token *tok);
+
+/**
+ * @brief State of the streaming encoder
+ *
+ * Members are internal, see @ref json_stream_encoder_init.
+ */
+struct json_stream_encoder {
+	char *buf;
+	size_t buf_size;
+	size_t used;
+	json_append_bytes_t flush;
+	void *data;
+	/* Bit set for each level of nesting which is an object */
+	uint32_t nesting;
+	/* Bit set for each level of nesting which has a member already */
+	uint32_t members;
+	uint8_t depth;
+};
+
+/**
+ * @brief Initialize the streaming encoder
+ *
+ * The streaming encoder writes values one at a time, without a descriptor,
+ * to @a buf. Each time the buffer is full, and at the end, its content is
+ * given to @a flush.
+ *
+ * Each value is given with its key when in an object, and with a NULL key
+ * otherwise. For example, {"a":[1,true]} is encoded with:
+ *
+ *    json_stream_encode_obj_start(&enc, NULL);
+ *    json_stream_encode_arr_start(&enc, "a");
+ *    json_stream_encode_number(&enc, NULL, 1);
+ *    json_stream_encode_bool(&enc, NULL, true);
+ *    json_stream_encode_arr_end(&enc);
+ *    json_stream_encode_obj_end(&enc);
+ *    json_stream_encoder_flush(&enc);
+ *
+ * @param enc Encoder
+ * @param buf Buffer
+ * @param buf_size Size of the buffer, at least 1
+ * @param flush Function writing out the content of the buffer
+ * @param data Data pointer to be passed to the flush function
+ *
+ * @return 0 on success, or -EINVAL if the buffer is empty.
+ */
+int json_stream_encoder_init(struct json_stream_encoder *enc, char *buf,
+			     size_t buf_size, json_append_bytes_t flush,
+			     void *data);
+
+/**
+ * @brief Start an object
+ *
+ * @param enc Encoder
+ * @param key Key in the enclosing object, NULL otherwise
+ *
+ * @return 0 on success, negative error code from the flush function, or
+ * -EINVAL if the key is wrong or the nesting too deep.
+ */
+int json_stream_encode_obj_start(struct json_stream_encoder *enc,
+				 const char *key);
+
+/**
+ * @brief End an object
+ *
+ * @param enc Encoder
+ *
+ * @return 0 on success, negative error code from the flush function, or
+ * -EINVAL if not in an object.
+ */
+int json_stream_encode_obj_end(struct json_stream_encoder *enc);
+
+/**
+ * @brief Start an array
+ *
+ * @param enc Encoder
+ * @param key Key in the enclosing object, NULL otherwise
+ *
+ * @return 0 on success, negative error code from the flush function, or
+ * -EINVAL if the key is wrong or the nesting too deep.
+ */
+int json_stream_encode_arr_start(struct json_stream_encoder *enc,
+				 const char *key);
+
+/**
+ * @brief End an array
+ *
+ * @param enc Encoder
+ *
+ * @return 0 on success, negative error code from the flush function, or
+ * -EINVAL if not in an array.
+ */
+int json_stream_encode_arr_end(struct json_stream_encoder *enc);
+
+/**
+ * @brief Encode a string, escaped
+ *
+ * @param enc Encoder
+ * @param key Key in the enclosing object, NULL otherwise
+ * @param str String
+ *
+ * @return 0 on success, negative error code from the flush function, or
+ * -EINVAL if the key is wrong.
+ */
+int json_stream_encode_string(struct json_stream_encoder *enc, const char *key,
+			      const char *str);
+
+/**
+ * @brief Encode an integer number
+ *
+ * @param enc Encoder
+ * @param key Key in the enclosing object, NULL otherwise
+ * @param num Number
+ *
+ * @return 0 on success, negative error code from the flush function, or
+ * -EINVAL if the key is wrong.
+ */
+int json_stream_encode_number(struct json_stream_encoder *enc, const char *key,
+			      int64_t num);
+
+/**
+ * @brief Encode a boolean
+ *
+ * @param enc Encoder
+ * @param key Key in the enclosing object, NULL otherwise
+ * @param value Value
+ *
+ * @return 0 on success, negative error code from the flush function, or
+ * -EINVAL if the key is wrong.
+ */
+int json_stream_encode_bool(struct json_stream_encoder *enc, const char *key,
+			    bool value);
+
+/**
+ * @brief Encode null
+ *
+ * @param enc Encoder
+ * @param key Key in the enclosing object, NULL otherwise
+ *
+ * @return 0 on success, negative error code from the flush function, or
+ * -EINVAL if the key is wrong.
+ */
+int json_stream_encode_null(struct json_stream_encoder *enc, const char *key);
+
+/**
+ * @brief Write out the content of the buffer of the encoder
+ *
+ * @param enc Encoder
+ *
+ * @return 0 on success, or negative error code from the flush function.
+ */
+int json_stream_encoder_flush(struct json_stream_encoder *enc);
+
 #ifdef __cplusplus
 }
 #endif
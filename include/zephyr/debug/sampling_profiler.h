@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/kernel/thread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup sampling_profiler Sampling profiler
+ *  @ingroup os_services
+ *  @brief Statistical profiler sampling the code interrupted by a timer
+ *
+ *  The profiler records, at a fixed frequency, the thread running and the
+ *  return addresses of the code it was running, in a buffer per CPU. The
+ *  samples are symbolised on the host, see
+ *  scripts/profiling/stackcollapse.py.
+ *  @{
+ */
+
+/** A sample taken by the profiler */
+struct sampling_profiler_sample {
+	/** The thread running when the sample was taken */
+	const struct k_thread *thread;
+	/** Return addresses, from the innermost, 0 after the last one.
+	 *  Only the first is ever set for the CPUs other than the one taking
+	 *  the samples: see @ref sampling_profiler_start.
+	 */
+	uintptr_t pc[CONFIG_SAMPLING_PROFILER_DEPTH];
+};
+
+/** @brief Start sampling
+ *
+ *  The samples are taken by a periodic timer, and are lost when the buffer
+ *  of their CPU is full. On SMP, only the thread running is recorded for
+ *  the CPUs other than the one running the timer.
+ *
+ *  @param frequency Samples per second, at most the tick rate
+ *
+ *  @retval 0 on success
+ *  @retval -EINVAL if the frequency is out of range
+ *  @retval -EALREADY if sampling already
+ */
+int sampling_profiler_start(uint32_t frequency);
+
+/** @brief Stop sampling
+ *
+ *  The samples taken are kept until read.
+ */
+void sampling_profiler_stop(void);
+
+/** @brief Read the samples of a CPU
+ *
+ *  Samples are read in the order taken, and can be read while sampling.
+ *  Each CPU must only be read by one thread at a time.
+ *
+ *  @param cpu CPU index
+ *  @param samples Array to copy the samples to
+ *  @param max Size of the array
+ *
+ *  @return Number of samples copied
+ */
+size_t sampling_profiler_read(unsigned int cpu,
+			      struct sampling_profiler_sample *samples,
+			      size_t max);
+
+/** @brief Get the number of samples lost because of a full buffer
+ *
+ *  @param cpu CPU index
+ *
+ *  @return Number of samples lost since sampling started
+ */
+uint32_t sampling_profiler_dropped(unsigned int cpu);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_ */
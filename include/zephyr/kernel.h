@@ -1481,7 +1481,6 @@ struct k_timer {
 	.timeout = { \
 		.node = {},\
 		.fn = z_timer_expiration_handler, \
-		.dticks = 0, \
 	}, \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
 	.expiry_fn = expiry, \
@@ -2894,6 +2893,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_worker;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
 
@@ -3469,6 +3469,44 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+/** @brief Add a thread to a work queue.
+ *
+ * This configures another thread to process the items submitted to the
+ * queue, concurrently with the work queue thread and the threads added
+ * before, and starts it running.  The thread has the priority of the work
+ * queue thread.
+ *
+ * Work items submitted to the queue may then run concurrently with each
+ * other, in the order they were submitted, but a given work item never runs
+ * concurrently with itself: if it is resubmitted while running, it is only
+ * processed again once its handler returns.  Flushing and cancelling work
+ * items behave the same as with a single thread.
+ *
+ * Requires CONFIG_WORKQUEUE_WORKERS.
+ *
+ * @param queue pointer to the queue structure, which must be started.
+ *
+ * @param worker pointer to the worker structure.  It must not be in use.
+ *
+ * @param stack pointer to the worker thread stack area.
+ *
+ * @param stack_size size of the worker thread stack area, in bytes.
+ *
+ * @param cpu the CPU the worker thread is pinned to, or -1 to let it run on
+ * any CPU.  Pinning requires CONFIG_SCHED_CPU_MASK.
+ *
+ * @param cfg optional additional configuration parameters.  Only the name
+ * and essential fields are used.  Pass @c NULL if not required.
+ *
+ * @retval 0 if the worker was added
+ * @retval -ENODEV if the queue is not started
+ * @retval -EINVAL if the worker can't be pinned to @p cpu
+ */
+int k_work_queue_worker_add(struct k_work_q *queue,
+			    struct k_work_q_worker *worker,
+			    k_thread_stack_t *stack, size_t stack_size,
+			    int cpu, const struct k_work_queue_config *cfg);
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -3954,6 +3992,12 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	/* The work item being flushed, which the flusher must not overtake
+	 * on a queue with several threads.
+	 */
+	struct k_work *target;
+#endif
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -4045,6 +4089,28 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	/* List of k_work_q_worker threads animating the work along with
+	 * the queue thread.
+	 */
+	sys_slist_t workers;
+
+	/* Number of threads running a work item. */
+	uint32_t busy;
+#endif
+};
+
+/** @brief A structure used to add a thread to a work queue.
+ *
+ * See k_work_queue_worker_add().
+ */
+struct k_work_q_worker {
+	/* The thread that animates the work. */
+	struct k_thread thread;
+
+	/* Node to link into the k_work_q workers list. */
+	sys_snode_t node;
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4609,6 +4675,69 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages from @a data
+ * to message queue @a msgq, in order.  Messages are handed to waiting
+ * readers first, and the rest are copied into the queue at once.  This
+ * takes the queue's lock, and wakes up the readers, only once for the
+ * whole batch.
+ *
+ * Fewer messages than requested are sent when the queue fills up.  If it
+ * is already full, this waits up to @a timeout for room for the first
+ * message only, which is then the only one sent.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num_msgs Number of messages at @a data.
+ * @param timeout Waiting period to add the first message, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages sent, a positive value.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL @a num_msgs is zero.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a msgq in a "first in, first out" manner, and stores them
+ * consecutively at @a data.  They are copied out at once, then the
+ * freed room is filled with the messages of waiting writers.  This takes
+ * the queue's lock, and wakes up the writers, only once for the whole
+ * batch.
+ *
+ * Fewer messages than requested are received when the queue runs empty.
+ * If it is already empty, this waits up to @a timeout for one message,
+ * which is then the only one received.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold the received messages.
+ * @param num_msgs Number of messages that fit at @a data.
+ * @param timeout Waiting period to receive the first message, or one of
+ *                the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages received, a positive value.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL @a num_msgs is zero.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4870,6 +4999,8 @@ struct k_pipe {
 	size_t         bytes_used;      /**< Number of bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+	size_t         put_claimed;     /**< Bytes claimed for writing */
+	size_t         get_claimed;     /**< Bytes claimed for reading */
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -4900,6 +5031,8 @@ struct k_pipe {
 	.bytes_used = 0,                                            \
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0,                                           \
 	.lock = {},                                                 \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
@@ -5020,6 +5153,103 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
 			 size_t min_xfer, k_timeout_t timeout);
 
+/**
+ * @brief Claim an area of a pipe's buffer to write data into.
+ *
+ * This routine gives direct access to the free space of @a pipe's buffer,
+ * so that data can be produced in place rather than copied in with
+ * k_pipe_put(). The claimed area is contiguous, hence it may be smaller
+ * than @a bytes_to_claim when the free space wraps around the end of the
+ * buffer.
+ *
+ * The claim must be released with k_pipe_put_finish(), which makes the
+ * data written into the area available to readers. Only one area can be
+ * claimed for writing at a time; in the meantime, other writers can only
+ * hand their data over to waiting readers.
+ *
+ * @note This routine is not available to user mode threads, as the
+ *       pipe's buffer is kernel memory.
+ *
+ * @param pipe Address of the pipe; it must have a buffer.
+ * @param data Address of area to hold the address of the claimed area.
+ * @param bytes_to_claim Maximum number of bytes to claim.
+ * @param bytes_claimed Address of area to hold the number of bytes claimed.
+ * @param timeout Waiting period for free space in the buffer,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Between one and @a bytes_to_claim bytes were claimed.
+ * @retval -EINVAL Invalid parameters supplied, or the pipe has no buffer.
+ * @retval -EBUSY An area is already claimed for writing.
+ * @retval -EIO Returned without waiting; the buffer is full.
+ * @retval -EAGAIN Waiting period timed out; the buffer is still full.
+ */
+int k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data,
+		     size_t bytes_to_claim, size_t *bytes_claimed,
+		     k_timeout_t timeout);
+
+/**
+ * @brief Release an area of a pipe's buffer claimed for writing.
+ *
+ * This routine makes the first @a bytes_written bytes of the area claimed
+ * with k_pipe_put_claim() available to readers, waking them up as needed.
+ * The rest of the area is returned to the free space.
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes_written Number of bytes written into the claimed area.
+ *
+ * @retval 0 The claim was released.
+ * @retval -EINVAL No area is claimed, or @a bytes_written exceeds its size.
+ */
+int k_pipe_put_finish(struct k_pipe *pipe, size_t bytes_written);
+
+/**
+ * @brief Claim an area of a pipe's buffer to read data from.
+ *
+ * This routine gives direct access to the data held in @a pipe's buffer,
+ * so that it can be consumed in place rather than copied out with
+ * k_pipe_get(). The claimed area is contiguous, hence it may be smaller
+ * than @a bytes_to_claim when the data wraps around the end of the buffer.
+ *
+ * The claim must be released with k_pipe_get_finish(). Only one area can
+ * be claimed for reading at a time; in the meantime, other readers wait.
+ * Data still held by waiting writers only becomes readable in place once
+ * it has been moved into the buffer.
+ *
+ * @note This routine is not available to user mode threads, as the
+ *       pipe's buffer is kernel memory.
+ *
+ * @param pipe Address of the pipe; it must have a buffer.
+ * @param data Address of area to hold the address of the claimed area.
+ * @param bytes_to_claim Maximum number of bytes to claim.
+ * @param bytes_claimed Address of area to hold the number of bytes claimed.
+ * @param timeout Waiting period for data in the buffer,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Between one and @a bytes_to_claim bytes were claimed.
+ * @retval -EINVAL Invalid parameters supplied, or the pipe has no buffer.
+ * @retval -EBUSY An area is already claimed for reading.
+ * @retval -EIO Returned without waiting; the buffer is empty.
+ * @retval -EAGAIN Waiting period timed out; the buffer is still empty.
+ */
+int k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data,
+		     size_t bytes_to_claim, size_t *bytes_claimed,
+		     k_timeout_t timeout);
+
+/**
+ * @brief Release an area of a pipe's buffer claimed for reading.
+ *
+ * This routine frees the first @a bytes_read bytes of the area claimed
+ * with k_pipe_get_claim(), refilling the buffer from waiting writers as
+ * needed. The rest of the area stays in the pipe, to be read next.
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes_read Number of bytes consumed from the claimed area.
+ *
+ * @retval 0 The claim was released.
+ * @retval -EINVAL No area is claimed, or @a bytes_read exceeds its size.
+ */
+int k_pipe_get_finish(struct k_pipe *pipe, size_t bytes_read);
+
 /**
  * @brief Query the number of bytes that may be read from @a pipe.
  *
@@ -5080,12 +5310,27 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Free blocks held by one CPU, linked like the shared free list.
+ * They still count as used in the slab's info.num_used.  The lock is
+ * only contended when other CPUs reclaim the blocks.
+ */
+struct z_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
 	char *buffer;
 	char *free_list;
 	struct k_mem_slab_info info;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct z_mem_slab_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
@@ -5228,6 +5473,12 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
 
+/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+uint32_t z_mem_slab_cached_get(struct k_mem_slab *slab);
+#endif
+/** @endcond */
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5240,7 +5491,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	return slab->info.num_used - z_mem_slab_cached_get(slab);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5275,7 +5530,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5424,7 +5679,11 @@ void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
+#ifdef CONFIG_SYS_HEAP_ALLOC_TLSF
+#define Z_HEAP_MIN_SIZE ((sizeof(void *) > 4) ? 224 : 212)
+#else
 #define Z_HEAP_MIN_SIZE ((sizeof(void *) > 4) ? 56 : 44)
+#endif
 
 /**
  * @brief Define a static k_heap in the specified linker section
@@ -5543,6 +5802,29 @@ void *k_malloc(size_t size);
  */
 void k_free(void *ptr);
 
+/**
+ * @brief Return cached blocks to the heap memory pool.
+ *
+ * With CONFIG_HEAP_MEM_POOL_CACHE, blocks freed with k_free() may be
+ * kept in per-CPU caches for reuse by k_malloc(). This routine returns
+ * all of them to the heap memory pool, e.g. before inspecting its
+ * runtime statistics.  It is a no-op otherwise.
+ */
+void k_malloc_cache_flush(void);
+
+/**
+ * @brief Get the number of bytes held in the heap memory pool caches.
+ *
+ * With CONFIG_HEAP_MEM_POOL_CACHE, blocks kept in the per-CPU caches
+ * still count as allocated in the runtime statistics of the heap memory
+ * pool. This routine returns the usable bytes of these blocks, to be
+ * subtracted from the allocated bytes of the statistics. It returns 0
+ * otherwise.
+ *
+ * @return Number of bytes held in the caches.
+ */
+size_t k_malloc_cache_size_get(void);
+
 /**
  * @brief Allocate memory from heap, array style
  *
@@ -5893,6 +6175,86 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Poll set
+ *
+ * A poll set keeps poll events registered on their objects between waits,
+ * and the events signaled on a ready list.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set The poll set to initialize.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add a poll event to a poll set.
+ *
+ * This routine registers @a event on its object until it is removed from
+ * @a set, where k_poll() registers its events anew on each call. The event
+ * must have been initialized with k_poll_event_init() or
+ * K_POLL_EVENT_INITIALIZER(), and must not be passed to k_poll() while in
+ * @a set.
+ *
+ * @param set The poll set.
+ * @param event The event to add.
+ *
+ * @retval 0 The event was added.
+ * @retval -EINVAL The event type is K_POLL_TYPE_IGNORE.
+ * @retval -EBUSY The event is already registered.
+ */
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove a poll event from a poll set.
+ *
+ * @param set The poll set.
+ * @param event The event to remove.
+ *
+ * @retval 0 The event was removed.
+ * @retval -EINVAL The event is not in @a set.
+ */
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready
+ *
+ * This routine returns the events of @a set that are ready, without
+ * looking at the other events: the cost of a call depends on the number
+ * of events ready, not on the number of events in the set.
+ *
+ * Readiness is level-triggered: an event returned is checked again by the
+ * next call, and returned again as long as its condition is met, e.g. as
+ * long as a semaphore is available. The state field of the events returned
+ * is set as by k_poll().
+ *
+ * If @a events is NULL, the routine only waits for an event to be ready,
+ * and leaves it to the next call.
+ *
+ * @param set The poll set.
+ * @param events Array where to store the events ready, or NULL.
+ * @param num_events Size of @a events.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @a events, or 0 if @a events is NULL.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int num_events, k_timeout_t timeout);
+
 /** @} */
 
 /**
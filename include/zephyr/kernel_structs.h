@@ -35,6 +35,16 @@
 #define K_NUM_THREAD_PRIO (CONFIG_NUM_PREEMPT_PRIORITIES + CONFIG_NUM_COOP_PRIORITIES + 1)
 #define PRIQ_BITMAP_SIZE  (DIV_ROUND_UP(K_NUM_THREAD_PRIO, BITS_PER_LONG))
 
+/* On 64-bit targets, a multi-queue with more than one bitmap word also
+ * keeps a summary word with one bit per non-empty bitmap word, so that
+ * finding the best priority takes two find-first-set operations
+ * however many priorities are configured. Bitmap words are 64 bits there,
+ * the size is not used as DIV_ROUND_UP() is not usable in #if from assembly.
+ */
+#if defined(CONFIG_64BIT) && (K_NUM_THREAD_PRIO > 64)
+#define PRIQ_BITMAP_SUMMARY 1
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -120,8 +130,12 @@ struct _priq_rb {
  * to represent their requirements.
  */
 struct _priq_mq {
-	sys_dlist_t queues[K_NUM_THREAD_PRIO];
+	/* Bitmaps first, so the lookup touches a single cache line */
+#ifdef PRIQ_BITMAP_SUMMARY
+	unsigned long summary;
+#endif
 	unsigned long bitmask[PRIQ_BITMAP_SIZE];
+	sys_dlist_t queues[K_NUM_THREAD_PRIO];
 };
 
 struct _ready_q {
@@ -154,7 +168,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_RUNQ
 	struct _ready_q ready_q;
 #endif
 
@@ -210,7 +224,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_CPU_RUNQ
 	struct _ready_q ready_q;
 #endif
 
@@ -296,7 +310,14 @@ typedef void (*_timeout_func_t)(struct _timeout *t);
 struct _timeout {
 	sys_dnode_t node;
 	_timeout_func_t fn;
-#ifdef CONFIG_TIMEOUT_64BIT
+#if defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
+	/* Absolute tick at which the timeout expires */
+	uint64_t expiry;
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* CPU whose timeout queue the timeout was last armed on */
+	uint8_t cpu;
+#endif
+#elif defined(CONFIG_TIMEOUT_64BIT)
 	/* Can't use k_ticks_t for header dependency reasons */
 	int64_t dticks;
 #else
@@ -284,6 +284,19 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage);
  */
 int log_mem_get_max_usage(uint32_t *max);
 
+/**
+ * @brief Get number of messages dropped by a CPU.
+ *
+ * Requires CONFIG_LOG_PER_CPU_BUFFERS option. Messages are counted on the CPU
+ * which failed to allocate them, or in whose buffer they were overwritten.
+ * Unlike the count reported to the backends, it is not reset when read.
+ *
+ * @param cpu CPU index.
+ *
+ * @return Number of messages dropped, 0 if the option is disabled.
+ */
+uint32_t log_cpu_dropped_get(unsigned int cpu);
+
 #if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MODE_MINIMAL)
 #define LOG_CORE_INIT() log_core_init()
 #define LOG_PANIC() log_panic()
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_LOGGING_LOG_FRONTEND_BINARY_H_
+#define ZEPHYR_INCLUDE_LOGGING_LOG_FRONTEND_BINARY_H_
+
+#include <string.h>
+#include <zephyr/sys/cbprintf.h>
+#include <zephyr/sys/mpsc_packet.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Binary records logging frontend
+ * @defgroup log_frontend_binary Binary records frontend
+ * @ingroup logger
+ * @{
+ */
+
+/**
+ * @file
+ *
+ * With CONFIG_LOG_FRONTEND_BINARY, a LOG_* call writes a fixed record to the
+ * buffer of the frontend: a header, followed by the raw arguments. The type of
+ * each argument is found at compile time, so no string package is created.
+ * Records are written out in the background, and decoded on the host by
+ * scripts/logging/binary/log_parser.py, which takes the format strings and the
+ * source names from the ELF file of the build.
+ *
+ * An argument of type 0 takes a word, of types 1 (64 bit integer or pointer)
+ * and 2 (double) two words. An argument of type 3 is a string: a word with the
+ * length of the string, followed by the string padded to a word.
+ *
+ * Messages with a character pointer argument, a long double, more than
+ * @ref LOG_FRONTEND_BINARY_MAX_ARGS arguments, hexdumps and messages from user
+ * mode are formatted on target instead, in records with the format
+ * @ref LOG_FRONTEND_BINARY_FMT_TEXT whose first argument is the text and the
+ * second one, if any, the hexdump data. Whether a character pointer is a
+ * string or only printed with %p is only known from the format string, which
+ * is not parsed at the call site.
+ */
+
+/** Most arguments in a record. */
+#define LOG_FRONTEND_BINARY_MAX_ARGS 14
+
+/** Format of a record with text formatted on target. */
+#define LOG_FRONTEND_BINARY_FMT_TEXT 0xFFFFFFFFU
+
+/** Format of a record with the number of records dropped as argument. */
+#define LOG_FRONTEND_BINARY_FMT_DROPPED 0xFFFFFFFEU
+
+/** Argument types. */
+#define LOG_FRONTEND_BINARY_ARG_WORD 0U
+#define LOG_FRONTEND_BINARY_ARG_DWORD 1U
+#define LOG_FRONTEND_BINARY_ARG_DOUBLE 2U
+#define LOG_FRONTEND_BINARY_ARG_STR 3U
+
+/**
+ * @brief Function writing out a record.
+ *
+ * @param data Record.
+ * @param len Length of the record in bytes.
+ * @param ctx Context given to @ref log_frontend_binary_output_set.
+ *
+ * @return Number of bytes written.
+ */
+typedef int (*log_frontend_binary_output_t)(const uint8_t *data, size_t len, void *ctx);
+
+/** @brief Header of a record. */
+struct log_frontend_binary_hdr {
+	MPSC_PBUF_HDR;
+	/** Length of the record in words, header included. */
+	uint32_t wlen: 10;
+	/** Severity level. */
+	uint32_t level: 3;
+	/** Source ID, see @ref log_const_source_id. */
+	uint32_t source: 16;
+	uint32_t reserved: 1;
+	/** Offset of the format string in the log_strings section. */
+	uint32_t fmt;
+	/** Timestamp, lowest 32 bits. */
+	uint32_t timestamp;
+	/** Types of the arguments, 2 bits each, and their number in the 4 upper bits. */
+	uint32_t desc;
+};
+
+/** @cond INTERNAL_HIDDEN */
+
+#define Z_LOG_BINARY_HDR_WLEN (sizeof(struct log_frontend_binary_hdr) / sizeof(uint32_t))
+
+#define Z_LOG_BINARY_ARG_OK(idx, arg) \
+	COND_CODE_0(idx, (), \
+		    (&& _Generic((arg) + 0, long double : false, default : true) && \
+		     !Z_CBPRINTF_IS_PCHAR(arg, 0)))
+
+#define Z_LOG_BINARY_ARG_TYPE(arg) \
+	_Generic((arg) + 0, float : LOG_FRONTEND_BINARY_ARG_DOUBLE, \
+		 double : LOG_FRONTEND_BINARY_ARG_DOUBLE, \
+		 default : (sizeof((arg) + 0) > sizeof(uint32_t) ? \
+			    LOG_FRONTEND_BINARY_ARG_DWORD : LOG_FRONTEND_BINARY_ARG_WORD))
+
+/* The modulo only keeps the shift in range where the record is not used */
+#define Z_LOG_BINARY_ARG_DESC(idx, arg) \
+	COND_CODE_0(idx, (), \
+		    (| (Z_LOG_BINARY_ARG_TYPE(arg) << (2 * (((idx) - 1) % LOG_FRONTEND_BINARY_MAX_ARGS)))))
+
+/* Length of the argument in bytes, in _l<idx> */
+#define Z_LOG_BINARY_ARG_LEN(idx, arg) \
+	COND_CODE_0(idx, (), (size_t _l##idx = Z_CBPRINTF_ARG_SIZE(arg)))
+
+#define Z_LOG_BINARY_ARG_WLEN(idx, arg) \
+	COND_CODE_0(idx, (), (+ DIV_ROUND_UP(_l##idx, sizeof(uint32_t))))
+
+#define Z_LOG_BINARY_ARG_PUT(idx, arg) \
+	COND_CODE_0(idx, (), ( \
+	{ \
+		__auto_type _v = (Z_CONSTIFY(arg)) + 0; \
+		double _d = _Generic((arg) + 0, float : (arg) + 0, default : 0.0); \
+		(void)_v; \
+		(void)_d; \
+		memcpy(_p, _Generic((arg) + 0, float : (void *)&_d, default : (void *)&_v), \
+		       _l##idx); \
+	} \
+	_p += DIV_ROUND_UP(_l##idx, sizeof(uint32_t))))
+
+/** @endcond */
+
+#ifdef __cplusplus
+/* Argument types are only found with C11 generic selections */
+#define Z_LOG_BINARY_CHECK(_domain_id, _dlen, ...) false
+#define Z_LOG_BINARY_CREATE(_source, _level, ...) do { } while (false)
+#else
+/**
+ * @brief Check if a message can be written as a binary record at once
+ *
+ * @param _domain_id Domain ID.
+ * @param _dlen Hexdump length.
+ * @param ... Format string with arguments.
+ */
+#define Z_LOG_BINARY_CHECK(_domain_id, _dlen, ...) \
+	COND_CODE_0(NUM_VA_ARGS_LESS_1(_, ##__VA_ARGS__), (false), \
+		    (((_domain_id) == 0) && ((_dlen) == 0) && \
+		     (NUM_VA_ARGS_LESS_1(__VA_ARGS__) <= LOG_FRONTEND_BINARY_MAX_ARGS) \
+		     FOR_EACH_IDX(Z_LOG_BINARY_ARG_OK, (), __VA_ARGS__)))
+
+/**
+ * @brief Write a message as a binary record
+ *
+ * Only to be used when @ref Z_LOG_BINARY_CHECK is true.
+ *
+ * @param _source Source, constant or dynamic data.
+ * @param _level Severity level.
+ * @param ... Format string with arguments.
+ */
+#define Z_LOG_BINARY_CREATE(_source, _level, ...) do { \
+	_Pragma("GCC diagnostic push") \
+	_Pragma("GCC diagnostic ignored \"-Wpointer-arith\"") \
+	FOR_EACH_IDX(Z_LOG_BINARY_ARG_LEN, (;), __VA_ARGS__); \
+	uint32_t *_rec = z_log_frontend_binary_alloc(Z_LOG_BINARY_HDR_WLEN \
+				FOR_EACH_IDX(Z_LOG_BINARY_ARG_WLEN, (), __VA_ARGS__)); \
+	if (_rec != NULL) { \
+		uint32_t *_p = &_rec[Z_LOG_BINARY_HDR_WLEN]; \
+		(void)_p; \
+		FOR_EACH_IDX(Z_LOG_BINARY_ARG_PUT, (;), __VA_ARGS__); \
+		z_log_frontend_binary_commit(_rec, (const void *)(_source), _level, \
+			GET_ARG_N(1, __VA_ARGS__), \
+			((uint32_t)NUM_VA_ARGS_LESS_1(__VA_ARGS__) << 28) \
+			FOR_EACH_IDX(Z_LOG_BINARY_ARG_DESC, (), __VA_ARGS__)); \
+	} \
+	_Pragma("GCC diagnostic pop") \
+} while (false)
+#endif /* __cplusplus */
+
+/**
+ * @brief Allocate a record
+ *
+ * @param wlen Length of the record in words, header included.
+ *
+ * @return Record, or NULL if the buffer is full.
+ */
+uint32_t *z_log_frontend_binary_alloc(uint32_t wlen);
+
+/**
+ * @brief Fill the header of a record and commit it
+ *
+ * @param rec Record, with the arguments written.
+ * @param source Source.
+ * @param level Severity level.
+ * @param fmt Format string, in the log_strings section.
+ * @param desc Types of the arguments and their number.
+ */
+void z_log_frontend_binary_commit(uint32_t *rec, const void *source, uint32_t level,
+				  const char *fmt, uint32_t desc);
+
+/**
+ * @brief Set the function writing out the records
+ *
+ * The function is called with one record at a time. By default, records are
+ * printed as hexadecimal strings on the console, one per line after
+ * "LOGBIN:", if CONFIG_PRINTK is enabled.
+ *
+ * @param func Output function, or NULL to restore the default.
+ * @param ctx Context passed to the function.
+ */
+void log_frontend_binary_output_set(log_frontend_binary_output_t func, void *ctx);
+
+/**
+ * @brief Write out the records pending
+ *
+ * Records are written out periodically, and at once after a panic.
+ *
+ * @return Number of records written.
+ */
+int log_frontend_binary_flush(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_LOGGING_LOG_FRONTEND_BINARY_H_ */
@@ -14,6 +14,9 @@
 #include <zephyr/sys/util.h>
 #include <string.h>
 #include <zephyr/toolchain.h>
+#ifdef CONFIG_LOG_FRONTEND_BINARY
+#include <zephyr/logging/log_frontend_binary.h>
+#endif
 
 #ifdef __GNUC__
 #ifndef alloca
@@ -143,6 +146,9 @@ enum z_log_msg_mode {
 
 	/* Mode optimized for simple messages with 0 to 2 32 bit word arguments.*/
 	Z_LOG_MSG_MODE_SIMPLE,
+
+	/* Mode writing a binary record to the frontend, with no string package. */
+	Z_LOG_MSG_MODE_BINARY,
 };
 
 #define Z_LOG_MSG_DESC_INITIALIZER(_domain_id, _level, _plen, _dlen) \
@@ -513,10 +519,29 @@ do {\
 	(_mode) = Z_LOG_MSG_MODE_RUNTIME; \
 } while (false)
 #else /* CONFIG_LOG_ALWAYS_RUNTIME || !CONFIG_LOG */
+/* Binary record written to the frontend when arguments allow it. Not wrapped
+ * in IF_ENABLED as _Pragma cannot be used in a macro argument.
+ */
+#ifdef CONFIG_LOG_FRONTEND_BINARY
+#define Z_LOG_MSG_BINARY_CREATE(_mode, _domain_id, _source, _level, _dlen, ...) \
+	_Pragma("GCC diagnostic push") \
+	_Pragma("GCC diagnostic ignored \"-Wpointer-arith\"") \
+	if (Z_LOG_BINARY_CHECK(_domain_id, _dlen, __VA_ARGS__) && !k_is_user_context()) { \
+		Z_LOG_BINARY_CREATE(_source, _level, __VA_ARGS__); \
+		(_mode) = Z_LOG_MSG_MODE_BINARY; \
+		break; \
+	} \
+	_Pragma("GCC diagnostic pop")
+#else
+#define Z_LOG_MSG_BINARY_CREATE(_mode, _domain_id, _source, _level, _dlen, ...)
+#endif
+
 #define Z_LOG_MSG_CREATE3(_try_0cpy, _mode,  _cstr_cnt, _domain_id, _source,\
 			  _level, _data, _dlen, ...) \
 do { \
 	Z_LOG_MSG_STR_VAR(_fmt, ##__VA_ARGS__); \
+	Z_LOG_MSG_BINARY_CREATE(_mode, _domain_id, _source, _level, _dlen, \
+				Z_LOG_FMT_ARGS(_fmt, ##__VA_ARGS__)); \
 	bool has_rw_str = CBPRINTF_MUST_RUNTIME_PACKAGE( \
 					Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt), \
 					__VA_ARGS__); \
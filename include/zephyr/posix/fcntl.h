@@ -22,6 +22,8 @@
 #define O_APPEND   0x0400
 #define O_EXCL	   0x0800
 #define O_NONBLOCK 0x4000
+#define O_SYNC     0x2000
+#define O_DSYNC    O_SYNC
 
 #define F_DUPFD 0
 #define F_GETFL 3
@@ -301,8 +301,11 @@
 #define NZERO      (20)
 
 /* Runtime invariant values */
-#define AIO_LISTIO_MAX     _POSIX_AIO_LISTIO_MAX
-#define AIO_MAX            _POSIX_AIO_MAX
+#define AIO_LISTIO_MAX \
+	COND_CODE_1(CONFIG_POSIX_ASYNCHRONOUS_IO, (CONFIG_POSIX_AIO_LISTIO_MAX), \
+		    (_POSIX_AIO_LISTIO_MAX))
+#define AIO_MAX \
+	COND_CODE_1(CONFIG_POSIX_ASYNCHRONOUS_IO, (CONFIG_POSIX_AIO_MAX), (_POSIX_AIO_MAX))
 #define AIO_PRIO_DELTA_MAX (0)
 #define DELAYTIMER_MAX     _POSIX_DELAYTIMER_MAX
 #define HOST_NAME_MAX      _POSIX_HOST_NAME_MAX
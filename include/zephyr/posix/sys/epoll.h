@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_
+#define ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_
+
+#include <zephyr/zvfs/epoll.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EPOLL_CLOEXEC ZVFS_EPOLL_CLOEXEC
+
+#define EPOLLIN  ZVFS_EPOLLIN
+#define EPOLLOUT ZVFS_EPOLLOUT
+#define EPOLLERR ZVFS_EPOLLERR
+#define EPOLLHUP ZVFS_EPOLLHUP
+
+#define EPOLL_CTL_ADD ZVFS_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZVFS_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZVFS_EPOLL_CTL_MOD
+
+typedef union zvfs_epoll_data epoll_data_t;
+
+#define epoll_event zvfs_epoll_event
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @param size Ignored, but must be greater than zero
+ *
+ * @return New epoll file descriptor on success, -1 on error
+ */
+int epoll_create(int size);
+
+/**
+ * @brief Create an epoll instance
+ *
+ * An epoll instance keeps a set of file descriptors registered with
+ * epoll_ctl(), and reports those ready with epoll_wait(). Readiness is
+ * level-triggered.
+ *
+ * @param flags 0 or EPOLL_CLOEXEC, which has no effect
+ *
+ * @return New epoll file descriptor on success, -1 on error
+ */
+int epoll_create1(int flags);
+
+/**
+ * @brief Add, modify or remove a file descriptor of an epoll instance
+ *
+ * @param epfd Epoll file descriptor
+ * @param op EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ * @param fd File descriptor
+ * @param event Events to wait for, EPOLLIN and/or EPOLLOUT, and the data
+ *        returned with them
+ *
+ * @return 0 on success, -1 on error
+ */
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+
+/**
+ * @brief Wait for the file descriptors of an epoll instance
+ *
+ * @param epfd Epoll file descriptor
+ * @param events Array to store the file descriptors ready
+ * @param maxevents Size of the array
+ * @param timeout Time to wait in milliseconds, -1 to wait forever
+ *
+ * @return Number of file descriptors ready, 0 on timeout, -1 on error
+ */
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_ */
@@ -318,6 +318,18 @@ typedef int (*cbprintf_cb_local)(int c, void *ctx);
  */
 typedef int (*cbprintf_convert_cb)(const void *buf, size_t len, void *ctx);
 
+/** @brief Signature for a cbprintf bulk output callback function.
+ *
+ * @param buf characters to output, not null-terminated.
+ * @param len number of characters.
+ * @param ctx a pointer to an object that provides context for the
+ * output operation.
+ *
+ * @return a non-negative value, or a negative error code that will be
+ * returned from cbvprintf_bulk().
+ */
+typedef int (*cbprintf_bulk_cb)(const char *buf, size_t len, void *ctx);
+
 /** @brief Signature for a external formatter function identical to cbvprintf.
  *
  * This function expects the following parameters:
@@ -753,6 +765,63 @@ int cbvprintf(cbprintf_cb out, void *ctx, const char *format, va_list ap)
 }
 #endif
 
+/** @brief varargs-aware *printf-like output through a bulk callback.
+ *
+ * Identical to z_cbvprintf_impl() except that the output is passed to
+ * @p out in sequences of characters.
+ *
+ * @param out the function used to emit the generated characters.
+ *
+ * @param ctx context provided when invoking out
+ *
+ * @param format a standard ISO C format string with characters and conversion
+ * specifications.
+ *
+ * @param ap a reference to the values to be converted.
+ *
+ * @param flags flags on how to process the inputs.
+ *              @see Z_CBVPRINTF_PROCESS_FLAGS.
+ *
+ * @return the number of characters generated, or a negative error value
+ * returned from invoking @p out.
+ */
+int z_cbvprintf_bulk_impl(cbprintf_bulk_cb out, void *ctx, const char *format,
+			  va_list ap, uint32_t flags);
+
+/** @brief varargs-aware *printf-like output through a bulk callback.
+ *
+ * This is cbvprintf() with the output passed to @p out in sequences of
+ * characters rather than one at a time: literal text and converted values
+ * are passed as they are, and characters generated one at a time like
+ * padding are gathered in a small buffer first. This saves most of the
+ * calls to the output function when it copies to a buffer.
+ *
+ * The output is byte-identical to cbvprintf(). As characters may be held
+ * until the next call to @p out, an error is reported from the call
+ * where it occurred, possibly after more characters were counted.
+ *
+ * @note The complete formatter is used even with CONFIG_PICOLIBC. With
+ * @kconfig{CONFIG_CBPRINTF_NANO}, characters are gathered from the
+ * character-by-character output.
+ *
+ * @param out the function used to emit the generated characters.
+ *
+ * @param ctx context provided when invoking out
+ *
+ * @param format a standard ISO C format string with characters and conversion
+ * specifications.
+ *
+ * @param ap a reference to the values to be converted.
+ *
+ * @return the number of characters generated, or a negative error value
+ * returned from invoking @p out.
+ */
+static inline
+int cbvprintf_bulk(cbprintf_bulk_cb out, void *ctx, const char *format, va_list ap)
+{
+	return z_cbvprintf_bulk_impl(out, ctx, format, ap, 0);
+}
+
 /** @brief varargs-aware *printf-like output through a callback with tagged arguments.
  *
  * This is essentially vsprintf() except the output is generated
@@ -822,6 +891,62 @@ int cbpprintf(cbprintf_cb out, void *ctx, void *packaged)
 	return cbpprintf_external(out, cbvprintf, ctx, packaged);
 }
 
+/** @cond INTERNAL_HIDDEN */
+
+/* External formatters for cbpprintf_bulk(). The bulk callback goes through
+ * cbpprintf_external() as a cbprintf_cb.
+ */
+static inline
+int z_cbvprintf_bulk_formatter(cbprintf_cb out, void *ctx,
+			       const char *format, va_list ap)
+{
+	return z_cbvprintf_bulk_impl((cbprintf_bulk_cb)out, ctx, format, ap, 0);
+}
+
+static inline
+int z_cbvprintf_bulk_tagged_formatter(cbprintf_cb out, void *ctx,
+				      const char *format, va_list ap)
+{
+	return z_cbvprintf_bulk_impl((cbprintf_bulk_cb)out, ctx, format, ap,
+				     Z_CBVPRINTF_PROCESS_FLAG_TAGGED_ARGS);
+}
+
+/** @endcond */
+
+/** @brief Generate the output for a previously captured format
+ * operation through a bulk callback.
+ *
+ * This is cbpprintf() with the output generated as by cbvprintf_bulk().
+ *
+ * @param out the function used to emit the generated characters.
+ *
+ * @param ctx context provided when invoking out
+ *
+ * @param packaged the data required to generate the formatted output, as
+ * captured by cbprintf_package() or cbvprintf_package().
+ *
+ * @return the number of characters printed, or a negative error value
+ * returned from invoking @p out.
+ */
+static inline
+int cbpprintf_bulk(cbprintf_bulk_cb out, void *ctx, void *packaged)
+{
+#if defined(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS)
+	union cbprintf_package_hdr *hdr =
+		(union cbprintf_package_hdr *)packaged;
+
+	if ((hdr->desc.pkg_flags & CBPRINTF_PACKAGE_ARGS_ARE_TAGGED)
+	    == CBPRINTF_PACKAGE_ARGS_ARE_TAGGED) {
+		return cbpprintf_external((cbprintf_cb)out,
+					  z_cbvprintf_bulk_tagged_formatter,
+					  ctx, packaged);
+	}
+#endif
+
+	return cbpprintf_external((cbprintf_cb)out, z_cbvprintf_bulk_formatter,
+				  ctx, packaged);
+}
+
 #ifdef CONFIG_CBPRINTF_LIBC_SUBSTS
 
 #ifdef CONFIG_PICOLIBC
@@ -29,6 +29,11 @@ struct sys_hashmap_oa_lp_data {
 	size_t n_buckets;
 	size_t size;
 	size_t n_tombstones;
+	/* table being migrated to @a buckets, if any */
+	void *old_buckets;
+	size_t old_n_buckets;
+	/* buckets of @a old_buckets below this one were migrated */
+	size_t old_pos;
 };
 
 /**
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SYS_MPMC_LOCKFREE_H_
+#define ZEPHYR_SYS_MPMC_LOCKFREE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Multiple Producer Multiple Consumer (MPMC) Lockfree Queue API
+ * @defgroup mpmc_lockfree MPMC Lockfree Queue API
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * @file mpmc_lockfree.h
+ *
+ * @brief A lock-free bounded multi producer multi consumer (MPMC) queue of
+ * fixed size elements. Ordering is First-In-First-Out.
+ *
+ * Based on the bounded MPMC queue described by Dmitry Vyukov: each slot of
+ * the array has a sequence number, telling the producers and consumers for
+ * which turn around the array the slot is ready to be written or read.
+ * A producer or consumer claims one or more slots with a single compare and
+ * swap of the shared position, then copies the elements without contention
+ * and publishes each slot by updating its sequence number.
+ *
+ * Claiming several slots at once with @ref mpmc_put_many and
+ * @ref mpmc_get_many amortizes the compare and swap over the batch.
+ *
+ * An MPMC queue is safe to put to or get from in any number of ISRs and
+ * threads. It is not wait-free: a thread preempted between claiming a slot
+ * and publishing it delays the consumers of that slot, which see the queue
+ * empty until then.
+ */
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Only separate the positions where another CPU could share their line */
+#if defined(CONFIG_DCACHE_LINE_SIZE) && (CONFIG_DCACHE_LINE_SIZE != 0)
+#define Z_MPMC_ALIGN CONFIG_DCACHE_LINE_SIZE
+#elif defined(CONFIG_SMP)
+#define Z_MPMC_ALIGN 64
+#else
+#define Z_MPMC_ALIGN sizeof(atomic_t)
+#endif
+
+/* The sequence numbers are stored less the index of their slot, so that a
+ * zeroed queue is an empty one.
+ */
+#define z_mpmc_seq_get(q, pos)                                                                     \
+	((unsigned long)__atomic_load_n(&(q)->seq[(pos) & (q)->mask], __ATOMIC_ACQUIRE) +         \
+	 ((pos) & (q)->mask))
+#define z_mpmc_seq_set(q, pos, val)                                                                \
+	__atomic_store_n(&(q)->seq[(pos) & (q)->mask],                                             \
+			 (atomic_val_t)((val) - ((pos) & (q)->mask)), __ATOMIC_RELEASE)
+#define z_mpmc_slot(q, pos) (&(q)->buffer[((pos) & (q)->mask) * (q)->elem_size])
+
+/** @endcond */
+
+/**
+ * @brief A lock-free MPMC queue
+ *
+ * @warning Not to be manipulated without the functions below!
+ */
+struct mpmc {
+	/** @cond INTERNAL_HIDDEN */
+	atomic_t *const seq;
+	uint8_t *const buffer;
+	const size_t elem_size;
+	const unsigned long mask;
+
+	/* next slot to put to */
+	atomic_t put_pos __aligned(Z_MPMC_ALIGN);
+
+	/* next slot to get from */
+	atomic_t get_pos __aligned(Z_MPMC_ALIGN);
+	/** @endcond */
+};
+
+/**
+ * @brief Define and initialize an MPMC queue
+ *
+ * The queue is ready to be used without @ref mpmc_init.
+ *
+ * @param name Name of the queue
+ * @param esize Size of an element in bytes
+ * @param sz Number of elements, must be a power of 2
+ */
+#define MPMC_DEFINE(name, esize, sz)                                                               \
+	BUILD_ASSERT(IS_POWER_OF_TWO(sz));                                                         \
+	static atomic_t __mpmc_seq_##name[sz];                                                     \
+	static uint8_t __noinit __mpmc_buf_##name[(sz) * (esize)] __aligned(sizeof(void *));       \
+	struct mpmc name = {                                                                       \
+		.seq = __mpmc_seq_##name,                                                          \
+		.buffer = __mpmc_buf_##name,                                                       \
+		.elem_size = esize,                                                                \
+		.mask = (sz) - 1,                                                                  \
+	}
+
+/**
+ * @brief Initialize/reset an MPMC queue such that it is empty
+ *
+ * Not safe to call while the queue is used.
+ *
+ * @param q Queue
+ */
+static inline void mpmc_init(struct mpmc *q)
+{
+	for (unsigned long i = 0; i <= q->mask; i++) {
+		atomic_clear(&q->seq[i]);
+	}
+
+	atomic_set(&q->put_pos, 0);
+	atomic_set(&q->get_pos, 0);
+}
+
+/**
+ * @brief Put elements to an MPMC queue
+ *
+ * Puts as many elements as there are slots free, in a single batch: the
+ * elements of a batch are consecutive in the queue.
+ *
+ * @param q Queue
+ * @param elems Array of elements to copy to the queue
+ * @param count Number of elements
+ *
+ * @return Number of elements put, 0 if the queue is full
+ */
+static inline size_t mpmc_put_many(struct mpmc *q, const void *elems, size_t count)
+{
+	const uint8_t *src = elems;
+	unsigned long pos;
+	size_t n;
+
+	if (count == 0) {
+		return 0;
+	}
+
+	do {
+		pos = (unsigned long)atomic_get(&q->put_pos);
+
+		/* Count the slots emptied for this turn */
+		for (n = 0; n < count; n++) {
+			if (z_mpmc_seq_get(q, pos + n) != pos + n) {
+				break;
+			}
+		}
+
+		if (n == 0) {
+			/* Full, unless another producer moved on */
+			if ((long)(z_mpmc_seq_get(q, pos) - pos) < 0) {
+				return 0;
+			}
+			continue;
+		}
+	} while (!atomic_cas(&q->put_pos, (atomic_val_t)pos, (atomic_val_t)(pos + n)));
+
+	for (size_t i = 0; i < n; i++) {
+		memcpy(z_mpmc_slot(q, pos + i), &src[i * q->elem_size], q->elem_size);
+		z_mpmc_seq_set(q, pos + i, pos + i + 1);
+	}
+
+	return n;
+}
+
+/**
+ * @brief Get elements from an MPMC queue
+ *
+ * Gets as many elements as available, in a single batch: the elements of a
+ * batch were consecutive in the queue.
+ *
+ * @param q Queue
+ * @param elems Array to copy the elements to
+ * @param count Size of the array in elements
+ *
+ * @return Number of elements got, 0 if the queue is empty
+ */
+static inline size_t mpmc_get_many(struct mpmc *q, void *elems, size_t count)
+{
+	uint8_t *dst = elems;
+	unsigned long pos;
+	size_t n;
+
+	if (count == 0) {
+		return 0;
+	}
+
+	do {
+		pos = (unsigned long)atomic_get(&q->get_pos);
+
+		/* Count the slots filled for this turn */
+		for (n = 0; n < count; n++) {
+			if (z_mpmc_seq_get(q, pos + n) != pos + n + 1) {
+				break;
+			}
+		}
+
+		if (n == 0) {
+			/* Empty, unless another consumer moved on */
+			if ((long)(z_mpmc_seq_get(q, pos) - (pos + 1)) < 0) {
+				return 0;
+			}
+			continue;
+		}
+	} while (!atomic_cas(&q->get_pos, (atomic_val_t)pos, (atomic_val_t)(pos + n)));
+
+	for (size_t i = 0; i < n; i++) {
+		memcpy(&dst[i * q->elem_size], z_mpmc_slot(q, pos + i), q->elem_size);
+		z_mpmc_seq_set(q, pos + i, pos + i + q->mask + 1);
+	}
+
+	return n;
+}
+
+/**
+ * @brief Put an element to an MPMC queue
+ *
+ * @param q Queue
+ * @param elem Element to copy to the queue
+ *
+ * @return true if put, false if the queue is full
+ */
+static inline bool mpmc_put(struct mpmc *q, const void *elem)
+{
+	return mpmc_put_many(q, elem, 1) == 1;
+}
+
+/**
+ * @brief Get an element from an MPMC queue
+ *
+ * @param q Queue
+ * @param elem Buffer to copy the element to
+ *
+ * @return true if got, false if the queue is empty
+ */
+static inline bool mpmc_get(struct mpmc *q, void *elem)
+{
+	return mpmc_get_many(q, elem, 1) == 1;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_SYS_MPMC_LOCKFREE_H_ */
@@ -64,6 +64,20 @@ extern "C" {
 /** @brief Flag indicated that buffer is currently full. */
 #define MPSC_PBUF_FULL BIT(3)
 
+/** @brief Flag indicating that producers do not take the buffer lock.
+ *
+ * Space is reserved with a compare and swap of the write index, and packets
+ * are committed by atomically setting their valid bit, so producers only
+ * contend on the lock when they must drop packets or wait for space. The
+ * lock is still used by the consumer.
+ *
+ * Requires CONFIG_MPSC_PBUF_LOCKFREE and a buffer size which is a power of
+ * 2, the flag is ignored otherwise. In overwrite mode, the oldest packet is
+ * not dropped while it is claimed: allocations fail until it is freed. Drop
+ * notifications are called with the buffer lock held.
+ */
+#define MPSC_PBUF_MODE_LOCKFREE BIT(4)
+
 /**@} */
 
 /* Forward declaration */
@@ -11,8 +11,8 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
+ * With CONFIG_SYS_MUTEX_FAST_PATH, uncontended sys_mutexes are locked and
+ * unlocked with simple atomic ops instead of syscalls, similar to Linux's
  * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
  */
 
@@ -21,14 +21,15 @@ extern "C" {
 #endif
 
 #ifdef CONFIG_USERSPACE
+#include <zephyr/kernel.h>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/types.h>
 #include <zephyr/sys_clock.h>
 
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* Owner word: the owning thread, or 0 if the mutex is free. The
+	 * owner locks and unlocks the mutex with atomic ops as long as no
+	 * other thread waits for it; the kernel takes over from then on.
 	 */
 	atomic_t val;
 };
@@ -89,6 +90,9 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * A thread is permitted to lock a mutex it has already locked. The operation
  * completes immediately and the lock count is increased by 1.
  *
+ * With CONFIG_SYS_MUTEX_FAST_PATH, a free mutex is locked without a system
+ * call: @a mutex is then only checked by the kernel once contended.
+ *
  * @param mutex Address of the mutex, which may reside in user memory
  * @param timeout Waiting period to lock the mutex,
  *                or one of the special values K_NO_WAIT and K_FOREVER.
@@ -97,11 +101,17 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * @retval -EBUSY Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
  * @retval -EACCES Caller has no access to provided mutex address
- * @retval -EINVAL Provided mutex not recognized by the kernel
+ * @retval -EINVAL Provided mutex not recognized by the kernel, or its memory
+ *                 was corrupted
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	if (atomic_cas(&mutex->val, 0, (atomic_val_t)k_current_get())) {
+		return 0;
+	}
+#endif
+
 	return z_sys_mutex_kernel_lock(mutex, timeout);
 }
 
@@ -119,12 +129,17 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  * @retval 0 Mutex unlocked
  * @retval -EACCES Caller has no access to provided mutex address
  * @retval -EINVAL Provided mutex not recognized by the kernel or mutex wasn't
- *                 locked
+ *                 locked, or its memory was corrupted
  * @retval -EPERM Caller does not own the mutex
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	if (atomic_cas(&mutex->val, (atomic_val_t)k_current_get(), 0)) {
+		return 0;
+	}
+#endif
+
 	return z_sys_mutex_kernel_unlock(mutex);
 }
 
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SYS_SPSC_RING_BUF_H_
+#define ZEPHYR_SYS_SPSC_RING_BUF_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Single Producer Single Consumer (SPSC) Lockfree Ring Buffer API
+ * @defgroup spsc_ring_buf SPSC Lockfree Ring Buffer API
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * @file spsc_ring_buf.h
+ *
+ * @brief A lock-free byte ring buffer for one producer and one consumer.
+ *
+ * This is a variant of @ref ring_buf where the producer and the consumer
+ * never need to be serialized by the caller: the producer only writes the
+ * head index and the consumer only writes the tail index, each published
+ * with release semantics and read by the other side with acquire
+ * semantics. The two indices are kept on cache lines of their own, along
+ * with a copy of the other index, so that the two sides only share a cache
+ * line when the copy runs out of data or space.
+ *
+ * The size of the buffer must be a power of two.
+ *
+ * @warning Only one execution context may put, and only one may get, at a
+ * time. Safe usage would be an ISR putting and a thread getting, or the
+ * other way around.
+ */
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Only separate the indices where another CPU could share their line */
+#if defined(CONFIG_DCACHE_LINE_SIZE) && (CONFIG_DCACHE_LINE_SIZE != 0)
+#define Z_SPSC_RING_BUF_ALIGN CONFIG_DCACHE_LINE_SIZE
+#elif defined(CONFIG_SMP)
+#define Z_SPSC_RING_BUF_ALIGN 64
+#else
+#define Z_SPSC_RING_BUF_ALIGN sizeof(uint32_t)
+#endif
+
+#define z_spsc_ring_buf_load_acquire(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define z_spsc_ring_buf_store_release(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+
+/** @endcond */
+
+/**
+ * @brief A lock-free SPSC ring buffer
+ *
+ * @warning Not to be manipulated without the functions below!
+ */
+struct spsc_ring_buf {
+	/** @cond INTERNAL_HIDDEN */
+	uint8_t *const buffer;
+	const uint32_t mask;
+
+	struct {
+		/* producer mutable, consumer readable */
+		uint32_t head;
+		/* private copy of the consumer tail */
+		uint32_t tail;
+	} prod __aligned(Z_SPSC_RING_BUF_ALIGN);
+
+	struct {
+		/* consumer mutable, producer readable */
+		uint32_t tail;
+		/* private copy of the producer head */
+		uint32_t head;
+	} cons __aligned(Z_SPSC_RING_BUF_ALIGN);
+	/** @endcond */
+};
+
+/**
+ * @brief Statically initialize an SPSC ring buffer
+ *
+ * @param sz Size of the buffer in bytes, must be a power of 2
+ * @param buf Buffer pointer
+ */
+#define SPSC_RING_BUF_INITIALIZER(sz, buf)                                                         \
+	{                                                                                          \
+		.buffer = buf,                                                                     \
+		.mask = (sz) - 1,                                                                  \
+	}
+
+/**
+ * @brief Define and initialize an SPSC ring buffer
+ *
+ * @param name Name of the ring buffer
+ * @param sz Size of the buffer in bytes, must be a power of 2
+ */
+#define SPSC_RING_BUF_DEFINE(name, sz)                                                             \
+	BUILD_ASSERT(IS_POWER_OF_TWO(sz));                                                         \
+	static uint8_t __noinit __spsc_ring_buf_data_##name[sz];                                   \
+	struct spsc_ring_buf name = SPSC_RING_BUF_INITIALIZER(sz, __spsc_ring_buf_data_##name)
+
+/**
+ * @brief Size of an SPSC ring buffer
+ *
+ * @param rb Ring buffer
+ *
+ * @return Size of the buffer in bytes
+ */
+static inline uint32_t spsc_ring_buf_capacity_get(const struct spsc_ring_buf *rb)
+{
+	return rb->mask + 1U;
+}
+
+/**
+ * @brief Reset an SPSC ring buffer such that it is empty
+ *
+ * Not safe to call while the ring buffer is used by the producer or the
+ * consumer.
+ *
+ * @param rb Ring buffer
+ */
+static inline void spsc_ring_buf_reset(struct spsc_ring_buf *rb)
+{
+	rb->prod.head = 0U;
+	rb->prod.tail = 0U;
+	rb->cons.tail = 0U;
+	rb->cons.head = 0U;
+}
+
+/**
+ * @brief Space free in an SPSC ring buffer
+ *
+ * Only to be called by the producer.
+ *
+ * @param rb Ring buffer
+ *
+ * @return Number of bytes which can be put
+ */
+static inline uint32_t spsc_ring_buf_space_get(struct spsc_ring_buf *rb)
+{
+	rb->prod.tail = z_spsc_ring_buf_load_acquire(&rb->cons.tail);
+
+	return spsc_ring_buf_capacity_get(rb) - (rb->prod.head - rb->prod.tail);
+}
+
+/**
+ * @brief Data in an SPSC ring buffer
+ *
+ * Only to be called by the consumer.
+ *
+ * @param rb Ring buffer
+ *
+ * @return Number of bytes which can be got
+ */
+static inline uint32_t spsc_ring_buf_size_get(struct spsc_ring_buf *rb)
+{
+	rb->cons.head = z_spsc_ring_buf_load_acquire(&rb->prod.head);
+
+	return rb->cons.head - rb->cons.tail;
+}
+
+/**
+ * @brief Check if an SPSC ring buffer is empty
+ *
+ * Only to be called by the consumer.
+ *
+ * @param rb Ring buffer
+ *
+ * @return true if the ring buffer is empty
+ */
+static inline bool spsc_ring_buf_is_empty(struct spsc_ring_buf *rb)
+{
+	return spsc_ring_buf_size_get(rb) == 0U;
+}
+
+/**
+ * @brief Put data into an SPSC ring buffer
+ *
+ * Copies as much of the data as fits, and makes it available to the
+ * consumer at once.
+ *
+ * @param rb Ring buffer
+ * @param data Data to put
+ * @param size Size of the data in bytes
+ *
+ * @return Number of bytes put
+ */
+static inline uint32_t spsc_ring_buf_put(struct spsc_ring_buf *rb, const uint8_t *data,
+					 uint32_t size)
+{
+	uint32_t head = rb->prod.head;
+	uint32_t space = spsc_ring_buf_capacity_get(rb) - (head - rb->prod.tail);
+	uint32_t offset, first;
+
+	if (space < size) {
+		space = spsc_ring_buf_space_get(rb);
+	}
+
+	size = MIN(size, space);
+	offset = head & rb->mask;
+	first = MIN(size, spsc_ring_buf_capacity_get(rb) - offset);
+
+	memcpy(&rb->buffer[offset], data, first);
+	memcpy(rb->buffer, &data[first], size - first);
+
+	z_spsc_ring_buf_store_release(&rb->prod.head, head + size);
+
+	return size;
+}
+
+/**
+ * @brief Get data from an SPSC ring buffer
+ *
+ * Copies as much data as available, up to @a size bytes, and makes the
+ * space it took available to the producer at once.
+ *
+ * @param rb Ring buffer
+ * @param data Buffer to copy the data to, or NULL to discard the data
+ * @param size Size of the buffer in bytes
+ *
+ * @return Number of bytes got
+ */
+static inline uint32_t spsc_ring_buf_get(struct spsc_ring_buf *rb, uint8_t *data,
+					 uint32_t size)
+{
+	uint32_t tail = rb->cons.tail;
+	uint32_t avail = rb->cons.head - tail;
+	uint32_t offset, first;
+
+	if (avail < size) {
+		avail = spsc_ring_buf_size_get(rb);
+	}
+
+	size = MIN(size, avail);
+
+	if (data != NULL) {
+		offset = tail & rb->mask;
+		first = MIN(size, spsc_ring_buf_capacity_get(rb) - offset);
+
+		memcpy(data, &rb->buffer[offset], first);
+		memcpy(&data[first], rb->buffer, size - first);
+	}
+
+	z_spsc_ring_buf_store_release(&rb->cons.tail, tail + size);
+
+	return size;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_SYS_SPSC_RING_BUF_H_ */
@@ -427,6 +427,21 @@
  */
 #define sys_port_trace_k_work_queue_start_exit(queue)
 
+/**
+ * @brief Trace Work Queue worker add call entry
+ * @param queue Work Queue structure
+ * @param worker Work Queue worker structure
+ */
+#define sys_port_trace_k_work_queue_worker_add_enter(queue, worker)
+
+/**
+ * @brief Trace Work Queue worker add call exit
+ * @param queue Work Queue structure
+ * @param worker Work Queue worker structure
+ * @param ret Return value
+ */
+#define sys_port_trace_k_work_queue_worker_add_exit(queue, worker, ret)
+
 /**
  * @brief Trace Work Queue drain call entry
  * @param queue Work Queue structure
@@ -1419,6 +1434,50 @@
  */
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
 
+/**
+ * @brief Trace Message Queue put many attempt entry
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue put many attempt blocking
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue put many attempt outcome
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)
+
+/**
+ * @brief Trace Message Queue get many attempt entry
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue get many attempt blocking
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue get many attempt outcome
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)
+
 /**
  * @brief Trace Message Queue peek
  * @param msgq Message Queue object
@@ -1633,6 +1692,50 @@
  */
 #define sys_port_trace_k_pipe_get_exit(pipe, timeout, ret)
 
+/**
+ * @brief Trace Pipe put claim attempt entry
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_put_claim_enter(pipe, timeout)
+
+/**
+ * @brief Trace Pipe put claim attempt blocking
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_put_claim_blocking(pipe, timeout)
+
+/**
+ * @brief Trace Pipe put claim attempt outcome
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_pipe_put_claim_exit(pipe, timeout, ret)
+
+/**
+ * @brief Trace Pipe get claim attempt entry
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_get_claim_enter(pipe, timeout)
+
+/**
+ * @brief Trace Pipe get claim attempt blocking
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_get_claim_blocking(pipe, timeout)
+
+/**
+ * @brief Trace Pipe get claim attempt outcome
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_pipe_get_claim_exit(pipe, timeout, ret)
+
 /** @} */ /* end of subsys_tracing_apis_pipe */
 
 /**
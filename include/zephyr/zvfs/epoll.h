@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZVFS_EPOLL_CLOEXEC 02000000
+
+#define ZVFS_EPOLLIN  0x1
+#define ZVFS_EPOLLOUT 0x4
+#define ZVFS_EPOLLERR 0x8
+#define ZVFS_EPOLLHUP 0x10
+
+#define ZVFS_EPOLL_CTL_ADD 1
+#define ZVFS_EPOLL_CTL_DEL 2
+#define ZVFS_EPOLL_CTL_MOD 3
+
+union zvfs_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+};
+
+struct zvfs_epoll_event {
+	uint32_t events;
+	union zvfs_epoll_data data;
+};
+
+/**
+ * @brief Create a ZVFS epoll instance
+ *
+ * An epoll instance holds a set of file descriptors, and reports those
+ * ready for the I/O they are registered for. Unlike with poll(), the file
+ * descriptors are registered once, with @ref zvfs_epoll_ctl, and stay
+ * registered between waits: the cost of a wait depends on the number of
+ * file descriptors ready, not on the number registered.
+ *
+ * Any file descriptor supporting poll(), such as sockets and eventfds, can
+ * be registered. Readiness is level-triggered.
+ *
+ * @param flags 0 or ZVFS_EPOLL_CLOEXEC, which has no effect
+ *
+ * @return New ZVFS epoll file descriptor on success, -1 on error
+ */
+int zvfs_epoll_create1(int flags);
+
+/**
+ * @brief Add, modify or remove a file descriptor of a ZVFS epoll instance
+ *
+ * @param epfd ZVFS epoll file descriptor
+ * @param op ZVFS_EPOLL_CTL_ADD, ZVFS_EPOLL_CTL_MOD or ZVFS_EPOLL_CTL_DEL
+ * @param fd File descriptor
+ * @param event Events to wait for, ZVFS_EPOLLIN and/or ZVFS_EPOLLOUT, and
+ *        the data returned with them. Ignored by ZVFS_EPOLL_CTL_DEL.
+ *        ZVFS_EPOLLERR and ZVFS_EPOLLHUP are always reported.
+ *
+ * @return 0 on success, -1 on error
+ */
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event);
+
+/**
+ * @brief Wait for the file descriptors of a ZVFS epoll instance
+ *
+ * @param epfd ZVFS epoll file descriptor
+ * @param events Array to store the file descriptors ready
+ * @param maxevents Size of the array
+ * @param timeout Time to wait in milliseconds, -1 to wait forever
+ *
+ * @return Number of file descriptors ready, 0 on timeout, -1 on error
+ */
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents,
+		    int timeout);
+
+/**
+ * @internal
+ * @brief Remove a file descriptor about to be closed from all epoll instances
+ *
+ * @param fd File descriptor
+ */
+void zvfs_epoll_fd_close(int fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_ */
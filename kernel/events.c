@@ -30,6 +30,7 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/sys/check.h>
+#include <limits.h>
 /* private kernel APIs */
 #include <wait_q.h>
 #include <ksched.h>
@@ -40,10 +41,11 @@
 
 #define K_EVENT_WAIT_RESET    0x02   /* Reset events prior to waiting */
 
-struct event_walk_data {
-	struct k_thread  *head;
-	uint32_t events;
-};
+#if CONFIG_EVENTS_WAKE_BATCH > 0
+#define EVENT_WAKE_BATCH      CONFIG_EVENTS_WAKE_BATCH
+#else
+#define EVENT_WAKE_BATCH      UINT_MAX
+#endif /* CONFIG_EVENTS_WAKE_BATCH > 0 */
 
 #ifdef CONFIG_OBJ_CORE_EVENT
 static struct k_obj_type obj_type_event;
@@ -98,45 +100,31 @@ static bool are_wait_conditions_met(uint32_t desired, uint32_t current,
 	return match != 0;
 }
 
-static int event_walk_op(struct k_thread *thread, void *data)
+static bool event_wake_match(struct k_thread *thread, void *data)
 {
-	unsigned int      wait_condition;
-	struct event_walk_data *event_data = data;
+	uint32_t events = *(uint32_t *)data;
+	unsigned int wait_condition;
 
 	wait_condition = thread->event_options & K_EVENT_WAIT_MASK;
 
-	if (are_wait_conditions_met(thread->events, event_data->events,
-				    wait_condition)) {
-
-		/*
-		 * Events create a list of threads to wake up. We do
-		 * not want z_thread_timeout to wake these threads; they
-		 * will be woken up by k_event_post_internal once they
-		 * have been processed.
-		 */
-		thread->no_wake_on_timeout = true;
-
-		/*
-		 * The wait conditions have been satisfied. Add this
-		 * thread to the list of threads to unpend.
-		 */
-		thread->next_event_link = event_data->head;
-		event_data->head = thread;
-		z_abort_timeout(&thread->base.timeout);
+	if (!are_wait_conditions_met(thread->events, events, wait_condition)) {
+		return false;
 	}
 
-	return 0;
+	/* Report the events posted to the thread once woken */
+	arch_thread_return_value_set(thread, 0);
+	thread->events = events;
+
+	return true;
 }
 
 static uint32_t k_event_post_internal(struct k_event *event, uint32_t events,
 				  uint32_t events_mask)
 {
 	k_spinlock_key_t  key;
-	struct k_thread  *thread;
-	struct event_walk_data data;
 	uint32_t previous_events;
+	unsigned int woken;
 
-	data.head = NULL;
 	key = k_spin_lock(&event->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_event, post, event, events,
@@ -146,30 +134,26 @@ static uint32_t k_event_post_internal(struct k_event *event, uint32_t events,
 	events = (event->events & ~events_mask) |
 		 (events & events_mask);
 	event->events = events;
-	data.events = events;
+
 	/*
 	 * Posting an event has the potential to wake multiple pended threads.
-	 * It is desirable to unpend all affected threads simultaneously. This
-	 * is done in three steps:
-	 *
-	 * 1. Walk the waitq and create a linked list of threads to unpend.
-	 * 2. Unpend each of the threads in the linked list
-	 * 3. Ready each of the threads in the linked list
+	 * All the threads whose wait conditions are met are woken together,
+	 * with the run queue updated once. With CONFIG_EVENTS_WAKE_BATCH,
+	 * they are woken by batches, and interrupts are let in between
+	 * batches. Threads woken by a later batch still see the events as
+	 * posted here.
 	 */
+	do {
+		woken = z_sched_waitq_wake_matching(&event->wait_q,
+						    event_wake_match, &events,
+						    EVENT_WAKE_BATCH);
+		if (woken < EVENT_WAKE_BATCH) {
+			break;
+		}
 
-	z_sched_waitq_walk(&event->wait_q, event_walk_op, &data);
-
-	if (data.head != NULL) {
-		thread = data.head;
-		struct k_thread *next;
-		do {
-			arch_thread_return_value_set(thread, 0);
-			thread->events = events;
-			next = thread->next_event_link;
-			z_sched_wake_thread(thread, false);
-			thread = next;
-		} while (thread != NULL);
-	}
+		k_spin_unlock(&event->lock, key);
+		key = k_spin_lock(&event->lock);
+	} while (true);
 
 	z_reschedule(&event->lock, key);
 
@@ -180,6 +180,15 @@ void z_mem_domain_exit_thread(struct k_thread *thread);
  * not recommended.
  */
 extern struct k_spinlock z_mem_domain_lock;
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/* Lock and unlock @a mutex on behalf of a sys_mutex, whose owner word
+ * (in user memory) can be updated without the kernel when uncontended.
+ */
+int z_mutex_word_lock(struct k_mutex *mutex, atomic_t *word,
+		      k_timeout_t timeout);
+int z_mutex_word_unlock(struct k_mutex *mutex, atomic_t *word);
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_GDBSTUB
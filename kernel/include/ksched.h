@@ -263,6 +263,29 @@ int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
 int z_sched_waitq_walk(_wait_q_t *wait_q,
 		       int (*func)(struct k_thread *, void *), void *data);
 
+/**
+ * @brief Wake the waiting threads matching a condition
+ *
+ * This function walks @a wait_q, and wakes the threads for which @a match
+ * returns true, up to @a max of them, in a single pass of the scheduler:
+ * the run queue is updated once, and each other CPU is sent at most one
+ * IPI, whatever the number of threads woken. The threads are woken in wait
+ * queue order.
+ *
+ * @a match is called with the scheduler locked: it may set the return value
+ * of the thread, but must not call into the scheduler.
+ *
+ * @param wait_q Identifies the wait queue to walk
+ * @param match  Callback telling whether to wake a waiting thread
+ * @param data   Custom data passed to the callback
+ * @param max    Maximum number of threads to wake
+ *
+ * @return Number of threads woken
+ */
+unsigned int z_sched_waitq_wake_matching(_wait_q_t *wait_q,
+					 bool (*match)(struct k_thread *, void *),
+					 void *data, unsigned int max);
+
 /** @brief Halt thread cycle usage accounting.
  *
  * Halts the accumulation of thread cycle usage and adds the current
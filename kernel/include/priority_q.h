@@ -118,6 +118,20 @@ static ALWAYS_INLINE struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 	return thread;
 }
 
+#ifdef PRIQ_BITMAP_SUMMARY
+static ALWAYS_INLINE struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
+{
+	if (pq->summary == 0) {
+		return NULL;
+	}
+
+	unsigned int i = u64_count_trailing_zeros(pq->summary);
+	sys_dlist_t *l = &pq->queues[i * 64 + u64_count_trailing_zeros(pq->bitmask[i])];
+
+	return CONTAINER_OF(sys_dlist_peek_head_not_empty(l),
+			    struct k_thread, base.qnode_dlist);
+}
+#else
 static ALWAYS_INLINE struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 {
 	struct k_thread *thread = NULL;
@@ -142,7 +156,7 @@ static ALWAYS_INLINE struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 
 	return thread;
 }
-
+#endif /* PRIQ_BITMAP_SUMMARY */
 
 #ifdef CONFIG_SCHED_MULTIQ
 
@@ -170,16 +184,32 @@ static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 
 	sys_dlist_append(&pq->queues[pos.offset_prio], &thread->base.qnode_dlist);
 	pq->bitmask[pos.idx] |= BIT(pos.bit);
+#ifdef PRIQ_BITMAP_SUMMARY
+	pq->summary |= BIT(pos.idx);
+#endif
 }
 
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 					   struct k_thread *thread)
 {
 	struct prio_info pos = get_prio_info(thread->base.prio);
+	sys_dnode_t *node = &thread->base.qnode_dlist;
 
-	sys_dlist_remove(&thread->base.qnode_dlist);
-	if (sys_dlist_is_empty(&pq->queues[pos.offset_prio])) {
+	/* A node whose neighbours are the same is the only one on its
+	 * list: both point to the list head.  Testing this on the node,
+	 * which is in the cache anyway, saves reading back the head
+	 * after the removal.
+	 */
+	bool last = (node->next == node->prev);
+
+	sys_dlist_remove(node);
+	if (last) {
 		pq->bitmask[pos.idx] &= ~BIT(pos.bit);
+#ifdef PRIQ_BITMAP_SUMMARY
+		if (pq->bitmask[pos.idx] == 0) {
+			pq->summary &= ~BIT(pos.idx);
+		}
+#endif
 	}
 }
 #endif /* CONFIG_SCHED_MULTIQ */
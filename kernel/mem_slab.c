@@ -33,6 +33,9 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	((struct k_mem_slab_info *)stats)->num_used = k_mem_slab_num_used_get(slab);
+#endif
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -48,9 +51,9 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
+	ptr->allocated_bytes = k_mem_slab_num_used_get(slab) *
+			       slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -178,6 +181,9 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->buffer = buffer;
 	slab->info.num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	memset(slab->cpu_cache, 0, sizeof(slab->cpu_cache));
+#endif
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
@@ -216,13 +222,204 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 }
 #endif
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+
+/* Blocks moved at once between a CPU cache and the shared free list */
+#define CACHE_BATCH (CONFIG_MEM_SLAB_CPU_CACHE_DEPTH / 2)
+
+uint32_t z_mem_slab_cached_get(struct k_mem_slab *slab)
+{
+	uint32_t n = 0U;
+
+	/* A snapshot, unless called with the slab's lock held */
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		n += *(volatile uint32_t *)&slab->cpu_cache[i].count;
+	}
+
+	return n;
+}
+
+/* Moves the blocks of all CPU caches back to the shared free list.
+ * Called with the slab's lock held, when that list runs empty.
+ */
+static void cache_reclaim_locked(struct k_mem_slab *slab)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct z_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		while (cache->free_list != NULL) {
+			char *p = cache->free_list;
+
+			cache->free_list = *(char **)p;
+			*(char **)p = slab->free_list;
+			slab->free_list = p;
+		}
+		slab->info.num_used -= cache->count;
+		cache->count = 0U;
+
+		k_spin_unlock(&cache->lock, key);
+	}
+}
+
+/* Moves a batch of blocks from the shared free list into the current
+ * CPU's cache, if empty.  Called with the slab's lock held.
+ */
+static void cache_refill_locked(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_cpu_cache *cache = &slab->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	char *last = NULL;
+	uint32_t n = 0U;
+
+	if (cache->count != 0U) {
+		k_spin_unlock(&cache->lock, key);
+		return;
+	}
+
+	for (char *p = slab->free_list; (p != NULL) && (n < CACHE_BATCH);
+	     p = *(char **)p) {
+		last = p;
+		n++;
+	}
+
+	if (n != 0U) {
+		slab->info.num_used += n;
+		cache->free_list = slab->free_list;
+		cache->count = n;
+		slab->free_list = *(char **)last;
+		*(char **)last = NULL;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+}
+
+/* Returns a batch of blocks from a CPU cache to the shared free list,
+ * handing them to waiting threads first.
+ */
+static void cache_drain(struct k_mem_slab *slab, char *first, char *last,
+			uint32_t n)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	bool woken = false;
+
+	while ((first != NULL) && (slab->free_list == NULL)) {
+		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		/* The block stays in use, just by somebody else */
+		z_thread_return_value_set_with_data(pending_thread, 0, first);
+		z_ready_thread(pending_thread);
+		first = *(char **)first;
+		n--;
+		woken = true;
+	}
+
+	if (first != NULL) {
+		*(char **)last = slab->free_list;
+		slab->free_list = first;
+		slab->info.num_used -= n;
+	}
+
+	if (woken) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
+	}
+}
+
+/* Cache locks nest inside the slab's lock, so an empty cache is refilled
+ * by the regular path rather than from here.
+ */
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int key = arch_irq_lock();
+	struct z_mem_slab_cpu_cache *cache = &slab->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t cache_key = k_spin_lock(&cache->lock);
+	bool ret = cache->count != 0U;
+
+	if (ret) {
+		*mem = cache->free_list;
+		cache->free_list = *(char **)cache->free_list;
+		cache->count--;
+	}
+
+	k_spin_unlock(&cache->lock, cache_key);
+	arch_irq_unlock(key);
+
+	return ret;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	unsigned int key = arch_irq_lock();
+	struct z_mem_slab_cpu_cache *cache = &slab->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t cache_key;
+	char *first = NULL, *last = NULL;
+
+	/* Threads only wait for blocks while the shared list is empty,
+	 * and then the regular path has to hand them this one.  The
+	 * unlocked peek may race with a thread about to pend, which
+	 * will then get the next block freed instead.
+	 */
+	if (*(char *volatile *)&slab->free_list == NULL) {
+		arch_irq_unlock(key);
+		return false;
+	}
+
+	cache_key = k_spin_lock(&cache->lock);
+
+	*(char **)mem = cache->free_list;
+	cache->free_list = mem;
+	cache->count++;
+
+	if (cache->count > CONFIG_MEM_SLAB_CPU_CACHE_DEPTH) {
+		first = cache->free_list;
+		last = first;
+		for (int i = 1; i < CACHE_BATCH; i++) {
+			last = *(char **)last;
+		}
+		cache->free_list = *(char **)last;
+		cache->count -= CACHE_BATCH;
+		*(char **)last = NULL;
+	}
+
+	k_spin_unlock(&cache->lock, cache_key);
+	arch_irq_unlock(key);
+
+	if (first != NULL) {
+		cache_drain(slab, first, last, CACHE_BATCH);
+	}
+
+	return true;
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Blocks cached by other CPUs before failing or waiting */
+	if (slab->free_list == NULL) {
+		cache_reclaim_locked(slab);
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -238,6 +435,10 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 					  slab->info.max_used);
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		cache_refill_locked(slab);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
 		   !IS_ENABLED(CONFIG_MULTITHREADING)) {
@@ -267,6 +468,16 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	__ASSERT(slab_ptr_is_good(slab, mem), "Invalid memory pointer provided");
+
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
 	__ASSERT(slab_ptr_is_good(slab, mem), "Invalid memory pointer provided");
@@ -301,8 +512,9 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	stats->allocated_bytes = k_mem_slab_num_used_get(slab) *
+				 slab->info.block_size;
+	stats->free_bytes = k_mem_slab_num_free_get(slab) *
 			    slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
@@ -40,6 +40,12 @@ static void *z_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t size
 	return mem;
 }
 
+#if (K_HEAP_MEM_POOL_SIZE > 0) && defined(CONFIG_HEAP_MEM_POOL_CACHE)
+static bool malloc_cache_put(struct k_heap *heap, void *ptr);
+#else
+#define malloc_cache_put(heap, ptr) false
+#endif
+
 void k_free(void *ptr)
 {
 	struct k_heap **heap_ref;
@@ -47,6 +53,11 @@ void k_free(void *ptr)
 	if (ptr != NULL) {
 		heap_ref = ptr;
 		--heap_ref;
+
+		if (malloc_cache_put(*heap_ref, ptr)) {
+			return;
+		}
+
 		ptr = heap_ref;
 
 		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_free, *heap_ref, heap_ref);
@@ -62,6 +73,162 @@ void k_free(void *ptr)
 K_HEAP_DEFINE(_system_heap, K_HEAP_MEM_POOL_SIZE);
 #define _SYSTEM_HEAP (&_system_heap)
 
+#ifdef CONFIG_HEAP_MEM_POOL_CACHE
+
+/* Per-CPU cache of small system heap blocks.  Each CPU keeps a bounded
+ * stack of free blocks per power-of-two size class, so that the common
+ * short-lived small allocations neither take the heap lock nor search
+ * its free lists.  The cache is chosen by the CPU we run on, but only
+ * as a hint: each has its own lock, so a thread migrating in between
+ * merely uses another CPU's cache.  Cached blocks remain allocated as
+ * far as the heap is concerned, the bytes they hold are accounted for
+ * separately.  A free cached block holds its usable size.
+ */
+#define CACHE_MIN_SHIFT 4	/* smallest class: 16 bytes */
+#define CACHE_CLASSES   5	/* 16, 32, 64, 128 and 256 bytes */
+
+#define CACHE_CLASS_SIZE(c) ((size_t)1 << ((c) + CACHE_MIN_SHIFT))
+
+struct malloc_cache {
+	struct k_spinlock lock;
+	size_t bytes;
+	uint8_t count[CACHE_CLASSES];
+	void *blocks[CACHE_CLASSES][CONFIG_HEAP_MEM_POOL_CACHE_DEPTH];
+};
+
+static struct malloc_cache malloc_caches[CONFIG_MP_MAX_NUM_CPUS];
+
+static struct malloc_cache *local_cache(void)
+{
+#ifdef CONFIG_SMP
+	return &malloc_caches[arch_curr_cpu()->id];
+#else
+	return &malloc_caches[0];
+#endif /* CONFIG_SMP */
+}
+
+/* Smallest class that can hold size bytes, or -1 if too big */
+static int cache_class(size_t size)
+{
+	if (size <= CACHE_CLASS_SIZE(0)) {
+		return 0;
+	}
+	if (size > CACHE_CLASS_SIZE(CACHE_CLASSES - 1)) {
+		return -1;
+	}
+
+	return 32 - u32_count_leading_zeros(size - 1) - CACHE_MIN_SHIFT;
+}
+
+static void *malloc_cache_get(int c)
+{
+	struct malloc_cache *cache = local_cache();
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	void *ptr = NULL;
+
+	if (cache->count[c] > 0) {
+		ptr = cache->blocks[c][--cache->count[c]];
+		cache->bytes -= *(size_t *)ptr;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	return ptr;
+}
+
+static bool malloc_cache_put(struct k_heap *heap, void *ptr)
+{
+	struct malloc_cache *cache;
+	k_spinlock_key_t key;
+	size_t usable;
+	bool cached = false;
+	int c;
+
+	if (heap != _SYSTEM_HEAP) {
+		return false;
+	}
+
+	/* File the block under the largest class it can hold, which
+	 * need not be the one it was allocated for.  Blocks of twice
+	 * the largest class or more are not worth withholding.
+	 */
+	usable = sys_heap_usable_size(&heap->heap, (struct k_heap **)ptr - 1) -
+		 sizeof(struct k_heap *);
+	if ((usable < CACHE_CLASS_SIZE(0)) ||
+	    (usable >= 2 * CACHE_CLASS_SIZE(CACHE_CLASSES - 1))) {
+		return false;
+	}
+	c = MIN(31 - (int)u32_count_leading_zeros(usable) - CACHE_MIN_SHIFT,
+		CACHE_CLASSES - 1);
+
+	cache = local_cache();
+	key = k_spin_lock(&cache->lock);
+
+	/* Past the high-water mark, blocks go back to the heap */
+	if ((cache->count[c] < CONFIG_HEAP_MEM_POOL_CACHE_DEPTH) &&
+	    ((cache->bytes + usable) <= CONFIG_HEAP_MEM_POOL_CACHE_HIGH_WATER)) {
+		*(size_t *)ptr = usable;
+		cache->blocks[c][cache->count[c]++] = ptr;
+		cache->bytes += usable;
+		cached = true;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	return cached;
+}
+
+void k_malloc_cache_flush(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(malloc_caches); i++) {
+		struct malloc_cache *cache = &malloc_caches[i];
+
+		for (int c = 0; c < CACHE_CLASSES; c++) {
+			void *ptr;
+
+			/* One at a time: k_heap_free() may reschedule,
+			 * which it must not do with our lock held.
+			 */
+			do {
+				k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+				ptr = NULL;
+				if (cache->count[c] > 0) {
+					ptr = cache->blocks[c][--cache->count[c]];
+					cache->bytes -= *(size_t *)ptr;
+				}
+				k_spin_unlock(&cache->lock, key);
+
+				if (ptr != NULL) {
+					k_heap_free(_SYSTEM_HEAP,
+						    (struct k_heap **)ptr - 1);
+				}
+			} while (ptr != NULL);
+		}
+	}
+}
+
+size_t k_malloc_cache_size_get(void)
+{
+	size_t bytes = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(malloc_caches); i++) {
+		K_SPINLOCK(&malloc_caches[i].lock) {
+			bytes += malloc_caches[i].bytes;
+		}
+	}
+
+	return bytes;
+}
+#else
+void k_malloc_cache_flush(void)
+{
+}
+
+size_t k_malloc_cache_size_get(void)
+{
+	return 0;
+}
+#endif /* CONFIG_HEAP_MEM_POOL_CACHE */
+
 void *k_aligned_alloc(size_t align, size_t size)
 {
 	__ASSERT(align / sizeof(void *) >= 1
@@ -73,7 +240,28 @@ void *k_aligned_alloc(size_t align, size_t size)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP);
 
+#ifdef CONFIG_HEAP_MEM_POOL_CACHE
+	/* Cached blocks are only guaranteed pointer alignment */
+	int c = (align <= sizeof(void *)) ? cache_class(size) : -1;
+	void *ret = NULL;
+
+	if (c >= 0) {
+		ret = malloc_cache_get(c);
+		size = CACHE_CLASS_SIZE(c);
+	}
+
+	if (ret == NULL) {
+		ret = z_heap_aligned_alloc(_SYSTEM_HEAP, align, size);
+	}
+
+	if (ret == NULL) {
+		/* The caches may be what is holding the memory */
+		k_malloc_cache_flush();
+		ret = z_heap_aligned_alloc(_SYSTEM_HEAP, align, size);
+	}
+#else
 	void *ret = z_heap_aligned_alloc(_SYSTEM_HEAP, align, size);
+#endif /* CONFIG_HEAP_MEM_POOL_CACHE */
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP, ret);
 
@@ -155,6 +343,15 @@ void k_thread_system_pool_assign(struct k_thread *thread)
 }
 #else
 #define _SYSTEM_HEAP	NULL
+
+void k_malloc_cache_flush(void)
+{
+}
+
+size_t k_malloc_cache_size_get(void)
+{
+	return 0;
+}
 #endif /* K_HEAP_MEM_POOL_SIZE */
 
 void *z_thread_aligned_alloc(size_t align, size_t size)
@@ -293,6 +293,207 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <zephyr/syscalls/k_msgq_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Copies messages into the ring buffer: one memcpy, or two when the
+ * write pointer wraps around.
+ */
+static void msgq_ring_write(struct k_msgq *msgq, const char *data,
+			    uint32_t num_msgs)
+{
+	size_t bytes = num_msgs * msgq->msg_size;
+	size_t bytes_to_end = msgq->buffer_end - msgq->write_ptr;
+
+	if (bytes < bytes_to_end) {
+		(void)memcpy(msgq->write_ptr, data, bytes);
+		msgq->write_ptr += bytes;
+	} else {
+		(void)memcpy(msgq->write_ptr, data, bytes_to_end);
+		(void)memcpy(msgq->buffer_start, data + bytes_to_end,
+			     bytes - bytes_to_end);
+		msgq->write_ptr = msgq->buffer_start + (bytes - bytes_to_end);
+	}
+	msgq->used_msgs += num_msgs;
+}
+
+/* Same for taking messages out of the ring buffer */
+static void msgq_ring_read(struct k_msgq *msgq, char *data, uint32_t num_msgs)
+{
+	size_t bytes = num_msgs * msgq->msg_size;
+	size_t bytes_to_end = msgq->buffer_end - msgq->read_ptr;
+
+	if (bytes < bytes_to_end) {
+		(void)memcpy(data, msgq->read_ptr, bytes);
+		msgq->read_ptr += bytes;
+	} else {
+		(void)memcpy(data, msgq->read_ptr, bytes_to_end);
+		(void)memcpy(data + bytes_to_end, msgq->buffer_start,
+			     bytes - bytes_to_end);
+		msgq->read_ptr = msgq->buffer_start + (bytes - bytes_to_end);
+	}
+	msgq->used_msgs -= num_msgs;
+}
+
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *msg = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t sent = 0U;
+	uint32_t n;
+	int result;
+
+	CHECKIF(num_msgs == 0U) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_many, msgq, timeout);
+
+	/* readers only wait on an empty queue: serve them first */
+	while ((sent < num_msgs) && (msgq->used_msgs == 0U)) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+		(void)memcpy(pending_thread->base.swap_data, msg,
+			     msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		msg += msgq->msg_size;
+		sent++;
+		woken = true;
+	}
+
+	n = MIN(num_msgs - sent, msgq->max_msgs - msgq->used_msgs);
+	if (n != 0U) {
+		msgq_ring_write(msgq, msg, n);
+		sent += n;
+#ifdef CONFIG_POLL
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+
+	if (sent != 0U) {
+		result = sent;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for message space to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put_many, msgq, timeout);
+
+		/* wait for room for the first message, like k_msgq_put() */
+		_current->base.swap_data = (void *)data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		if (result == 0) {
+			result = 1;
+		}
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout, result);
+		return result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout, result);
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_put_many(msgq, data, num_msgs, timeout);
+}
+#include <zephyr/syscalls/k_msgq_put_many_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t n;
+	int result;
+
+	CHECKIF(num_msgs == 0U) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get_many, msgq, timeout);
+
+	n = MIN(num_msgs, msgq->used_msgs);
+	if (n != 0U) {
+		msgq_ring_read(msgq, data, n);
+
+		/* writers only wait on a full queue: let them refill it */
+		while (msgq->used_msgs < msgq->max_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+			msgq_ring_write(msgq, pending_thread->base.swap_data, 1);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			woken = true;
+		}
+		result = n;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get_many, msgq, timeout);
+
+		/* wait for the first message, like k_msgq_get() */
+		_current->base.swap_data = data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		if (result == 0) {
+			result = 1;
+		}
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout, result);
+		return result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout, result);
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *msgq, void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_get_many(msgq, data, num_msgs, timeout);
+}
+#include <zephyr/syscalls/k_msgq_get_many_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -102,48 +102,16 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
-int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+/*
+ * Wait for a mutex owned by another thread, boosting the owner's priority
+ * in the meantime. Called with the lock held, returns with it released.
+ */
+static int mutex_pend(struct k_mutex *mutex, k_spinlock_key_t key,
+		      k_timeout_t timeout)
 {
 	int new_prio;
-	k_spinlock_key_t key;
 	bool resched = false;
 
-	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
-
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
-
-	key = k_spin_lock(&lock);
-
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
-
-		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
-
-		mutex->lock_count++;
-		mutex->owner = _current;
-
-		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
-
-		k_spin_unlock(&lock, key);
-
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
-
-		return 0;
-	}
-
-	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
-		k_spin_unlock(&lock, key);
-
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EBUSY);
-
-		return -EBUSY;
-	}
-
-	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
-
 	new_prio = new_prio_for_inheritance(_current->base.prio,
 					    mutex->owner->base.prio);
 
@@ -161,7 +129,6 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		got_mutex ? 'y' : 'n');
 
 	if (got_mutex == 0) {
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 		return 0;
 	}
 
@@ -193,11 +160,57 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		k_spin_unlock(&lock, key);
 	}
 
-	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EAGAIN);
-
 	return -EAGAIN;
 }
 
+int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+
+	key = k_spin_lock(&lock);
+
+	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+
+		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
+					_current->base.prio :
+					mutex->owner_orig_prio;
+
+		mutex->lock_count++;
+		mutex->owner = _current;
+
+		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
+			_current, mutex, mutex->lock_count,
+			mutex->owner_orig_prio);
+
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+
+		return 0;
+	}
+
+	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
+
+	ret = mutex_pend(mutex, key, timeout);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, ret);
+
+	return ret;
+}
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_mutex_lock(struct k_mutex *mutex,
 				      k_timeout_t timeout)
@@ -208,10 +221,44 @@ static inline int z_vrfy_k_mutex_lock(struct k_mutex *mutex,
 #include <zephyr/syscalls/k_mutex_lock_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-int z_impl_k_mutex_unlock(struct k_mutex *mutex)
+/*
+ * Release a mutex for good, handing it over to the first waiter if any.
+ * Called with the lock held.
+ *
+ * Returns the new owner, which is ready to run, or NULL.
+ */
+static struct k_thread *mutex_handover(struct k_mutex *mutex)
 {
 	struct k_thread *new_owner;
 
+	adjust_owner_prio(mutex, mutex->owner_orig_prio);
+
+	/* Get the new owner, if any */
+	new_owner = z_unpend_first_thread(&mutex->wait_q);
+
+	mutex->owner = new_owner;
+
+	LOG_DBG("new owner of mutex %p: %p (prio: %d)",
+		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
+
+	if (new_owner != NULL) {
+		/*
+		 * new owner is already of higher or equal prio than first
+		 * waiter since the wait queue is priority-based: no need to
+		 * adjust its priority
+		 */
+		mutex->owner_orig_prio = new_owner->base.prio;
+		arch_thread_return_value_set(new_owner, 0);
+		z_ready_thread(new_owner);
+	} else {
+		mutex->lock_count = 0U;
+	}
+
+	return new_owner;
+}
+
+int z_impl_k_mutex_unlock(struct k_mutex *mutex)
+{
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, unlock, mutex);
@@ -251,28 +298,9 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	adjust_owner_prio(mutex, mutex->owner_orig_prio);
-
-	/* Get the new owner, if any */
-	new_owner = z_unpend_first_thread(&mutex->wait_q);
-
-	mutex->owner = new_owner;
-
-	LOG_DBG("new owner of mutex %p: %p (prio: %d)",
-		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
-
-	if (new_owner != NULL) {
-		/*
-		 * new owner is already of higher or equal prio than first
-		 * waiter since the wait queue is priority-based: no need to
-		 * adjust its priority
-		 */
-		mutex->owner_orig_prio = new_owner->base.prio;
-		arch_thread_return_value_set(new_owner, 0);
-		z_ready_thread(new_owner);
+	if (mutex_handover(mutex) != NULL) {
 		z_reschedule(&lock, key);
 	} else {
-		mutex->lock_count = 0U;
 		k_spin_unlock(&lock, key);
 	}
 
@@ -292,6 +320,165 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 #include <zephyr/syscalls/k_mutex_unlock_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/*
+ * Mutexes with a user mode fast path, see sys_mutex.
+ *
+ * The owner word holds the owning thread, or 0 when the mutex is free. As
+ * long as nobody waits for the mutex, the owner word is updated by the
+ * threads themselves with atomic operations and the kernel mutex is not
+ * used at all. The first thread to wait hands the ownership over to the
+ * kernel mutex and sets MUTEX_WORD_KERNEL in the owner word, so that the
+ * owner can no longer release the mutex without the kernel knowing, and
+ * waiting threads get priority inheritance. The kernel mutex keeps the
+ * ownership until it is released with no thread waiting.
+ */
+#define MUTEX_WORD_KERNEL BIT(0)
+
+BUILD_ASSERT(__alignof__(struct k_thread) > MUTEX_WORD_KERNEL);
+
+/*
+ * The owner word lives in user memory, so check it against the kernel
+ * mutex before acting on it: the kernel mutex is held if and only if the
+ * word is flagged, and then by the thread the word names.
+ */
+static bool mutex_word_valid(struct k_mutex *mutex, atomic_val_t val)
+{
+	struct k_thread *owner = (struct k_thread *)(val & ~MUTEX_WORD_KERNEL);
+
+	if ((val & MUTEX_WORD_KERNEL) == 0) {
+		return mutex->lock_count == 0U;
+	}
+
+	return (mutex->lock_count != 0U) && (mutex->owner != NULL) &&
+	       (mutex->owner == owner);
+}
+
+int z_mutex_word_lock(struct k_mutex *mutex, atomic_t *word,
+		      k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	struct k_thread *owner;
+	atomic_val_t val;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	key = k_spin_lock(&lock);
+
+	while (true) {
+		val = atomic_get(word);
+		owner = (struct k_thread *)(val & ~MUTEX_WORD_KERNEL);
+
+		if (!mutex_word_valid(mutex, val)) {
+			k_spin_unlock(&lock, key);
+
+			return -EINVAL;
+		}
+
+		if (val == 0) {
+			if (atomic_cas(word, 0, (atomic_val_t)_current)) {
+				k_spin_unlock(&lock, key);
+
+				return 0;
+			}
+
+			/* Taken in the meantime, try again */
+			continue;
+		}
+
+		if ((val & MUTEX_WORD_KERNEL) != 0) {
+			/* Already handed over to the kernel mutex */
+			break;
+		}
+
+		if ((owner != _current) && K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+
+			return -EBUSY;
+		}
+
+		/* Do not trust the owner word to point to a thread */
+		if (k_object_validate(k_object_find(owner), K_OBJ_THREAD,
+				      _OBJ_INIT_TRUE) != 0) {
+			k_spin_unlock(&lock, key);
+
+			return -EINVAL;
+		}
+
+		if (atomic_cas(word, val, val | MUTEX_WORD_KERNEL)) {
+			mutex->owner = owner;
+			mutex->lock_count = 1U;
+			mutex->owner_orig_prio = owner->base.prio;
+
+			LOG_DBG("%p handed mutex %p over to the kernel",
+				owner, mutex);
+			break;
+		}
+
+		/* Released in the meantime, try again */
+	}
+
+	if (mutex->owner == _current) {
+		mutex->lock_count++;
+		k_spin_unlock(&lock, key);
+
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&lock, key);
+
+		return -EBUSY;
+	}
+
+	/* The owner word was checked against the kernel mutex, which is held */
+	__ASSERT_NO_MSG(mutex->owner != NULL);
+
+	return mutex_pend(mutex, key, timeout);
+}
+
+int z_mutex_word_unlock(struct k_mutex *mutex, atomic_t *word)
+{
+	k_spinlock_key_t key;
+	struct k_thread *owner;
+	struct k_thread *new_owner;
+	atomic_val_t val;
+	int ret = 0;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	key = k_spin_lock(&lock);
+
+	val = atomic_get(word);
+	owner = (struct k_thread *)(val & ~MUTEX_WORD_KERNEL);
+
+	if ((owner == NULL) || !mutex_word_valid(mutex, val)) {
+		ret = -EINVAL;
+	} else if (owner != _current) {
+		ret = -EPERM;
+	} else if ((val & MUTEX_WORD_KERNEL) == 0) {
+		/* Only the owner may change the owner word now */
+		atomic_set(word, 0);
+	} else if (mutex->lock_count > 1U) {
+		mutex->lock_count--;
+	} else {
+		new_owner = mutex_handover(mutex);
+		if (new_owner != NULL) {
+			atomic_set(word, (atomic_val_t)new_owner | MUTEX_WORD_KERNEL);
+			z_reschedule(&lock, key);
+
+			return 0;
+		}
+
+		atomic_set(word, 0);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 #ifdef CONFIG_OBJ_CORE_MUTEX
 static int init_mutex_obj_core_list(void)
 {
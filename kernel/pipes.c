@@ -43,6 +43,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0U;
 	pipe->read_index = 0U;
 	pipe->write_index = 0U;
+	pipe->put_claimed = 0U;
+	pipe->get_claimed = 0U;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -163,7 +165,8 @@ int k_pipe_cleanup(struct k_pipe *pipe)
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
 	CHECKIF((z_waitq_head(&pipe->wait_q.readers) != NULL) ||
-			(z_waitq_head(&pipe->wait_q.writers) != NULL)) {
+			(z_waitq_head(&pipe->wait_q.writers) != NULL) ||
+			(pipe->put_claimed != 0U) || (pipe->get_claimed != 0U)) {
 		k_spin_unlock(&pipe->lock, key);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, cleanup, pipe, -EAGAIN);
@@ -346,6 +349,17 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 		src->buffer         += bytes_copied;
 		src->bytes_to_xfer  -= bytes_copied;
 
+		if (src->thread == NULL) {
+
+			/* Reading from the pipe buffer. Update details. */
+
+			pipe->bytes_used -= bytes_copied;
+			pipe->read_index += bytes_copied;
+			if (pipe->read_index >= pipe->size) {
+				pipe->read_index -= pipe->size;
+			}
+		}
+
 		if (dest->thread == NULL) {
 
 			/* Writing to the pipe buffer. Update details. */
@@ -409,13 +423,20 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, const void *data,
 	/*
 	 * First, write to any waiting readers, if any exist.
 	 * Second, write to the pipe buffer, if it exists.
+	 *
+	 * Readers may only be waiting while the pipe buffer holds data if
+	 * that data is claimed; they must get it first. The pipe buffer can
+	 * not be written to while an area of it is claimed for writing.
 	 */
 
-	bytes_can_write = pipe_waiter_list_populate(&dest_list,
-						    &pipe->wait_q.readers,
-						    bytes_to_write);
+	bytes_can_write = 0U;
+	if (pipe->get_claimed == 0U) {
+		bytes_can_write = pipe_waiter_list_populate(&dest_list,
+							    &pipe->wait_q.readers,
+							    bytes_to_write);
+	}
 
-	if (pipe->bytes_used != pipe->size) {
+	if ((pipe->bytes_used != pipe->size) && (pipe->put_claimed == 0U)) {
 		bytes_can_write += pipe_buffer_list_populate(&dest_list,
 							     pipe_desc,
 							     pipe->buffer,
@@ -548,22 +569,27 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 	 * 1. Copy data from the pipe buffer to the receive buffer.
 	 * 2. Copy data from the waiting writer(s) to the receive buffer.
 	 * 3. Refill the pipe buffer from the waiting writer(s).
+	 *
+	 * Nothing can be read while an area of the pipe buffer is claimed
+	 * for reading, as its data must be read first.
 	 */
 
 	sys_dlist_init(&src_list);
 
-	if (pipe->bytes_used != 0) {
-		bytes_can_read = pipe_buffer_list_populate(&src_list,
-							   pipe_desc,
-							   pipe->buffer,
-							   pipe->size,
-							   pipe->read_index,
-							   pipe->write_index);
-	}
+	if (pipe->get_claimed == 0U) {
+		if (pipe->bytes_used != 0) {
+			bytes_can_read = pipe_buffer_list_populate(&src_list,
+								   pipe_desc,
+								   pipe->buffer,
+								   pipe->size,
+								   pipe->read_index,
+								   pipe->write_index);
+		}
 
-	bytes_can_read += pipe_waiter_list_populate(&src_list,
-						    &pipe->wait_q.writers,
-						    bytes_to_read);
+		bytes_can_read += pipe_waiter_list_populate(&src_list,
+							    &pipe->wait_q.writers,
+							    bytes_to_read);
+	}
 
 	if ((bytes_can_read < min_xfer) &&
 	    (K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
@@ -625,7 +651,7 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	}
 
-	if (pipe->bytes_used != pipe->size) {
+	if ((pipe->bytes_used != pipe->size) && (pipe->put_claimed == 0U)) {
 		sys_dlist_t         pipe_list;
 
 		/*
@@ -736,6 +762,306 @@ int z_vrfy_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 #include <zephyr/syscalls/k_pipe_get_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/**
+ * @brief Move data between the pipe buffer and waiting threads
+ *
+ * Readers and writers may have been waiting on an area of the pipe buffer
+ * that was claimed. Once the claim is released, hand the buffered data over
+ * to the waiting readers, then refill the pipe buffer from the waiting
+ * writers.
+ */
+static void pipe_waiters_service(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc   pipe_desc[2];
+	struct _pipe_desc  *desc;
+	struct k_thread    *thread;
+	sys_dlist_t         src_list;
+	sys_dlist_t         dest_list;
+
+	if ((pipe->bytes_used != 0U) && (pipe->get_claimed == 0U)) {
+		sys_dlist_init(&src_list);
+		sys_dlist_init(&dest_list);
+
+		(void) pipe_buffer_list_populate(&src_list, pipe_desc,
+						 pipe->buffer, pipe->size,
+						 pipe->read_index,
+						 pipe->write_index);
+
+		(void) pipe_waiter_list_populate(&dest_list,
+						 &pipe->wait_q.readers,
+						 pipe->bytes_used);
+
+		(void) pipe_write(pipe, &src_list, &dest_list, reschedule);
+	}
+
+	if ((pipe->bytes_used != pipe->size) && (pipe->put_claimed == 0U)) {
+		sys_dlist_init(&src_list);
+		sys_dlist_init(&dest_list);
+
+		(void) pipe_waiter_list_populate(&src_list,
+						 &pipe->wait_q.writers,
+						 pipe->size - pipe->bytes_used);
+
+		(void) pipe_buffer_list_populate(&dest_list, pipe_desc,
+						 pipe->buffer, pipe->size,
+						 pipe->write_index,
+						 pipe->read_index);
+
+		(void) pipe_write(pipe, &src_list, &dest_list, reschedule);
+	}
+
+	/* Wake up the writers that have nothing left to write */
+
+	thread = z_waitq_head(&pipe->wait_q.writers);
+	while (thread != NULL) {
+		desc = (struct _pipe_desc *)thread->base.swap_data;
+		if (desc->bytes_to_xfer != 0U) {
+			break;
+		}
+
+		z_unpend_thread(thread);
+		z_ready_thread(thread);
+		*reschedule = true;
+
+		thread = z_waitq_head(&pipe->wait_q.writers);
+	}
+}
+
+/**
+ * @brief Wait for an area of the pipe buffer to become claimable
+ *
+ * The waiting thread is queued with an empty descriptor, so that the
+ * readers and writers walking the wait queue wake it up as they go.
+ */
+static void pipe_claim_wait(struct k_pipe *pipe, k_spinlock_key_t key,
+			    _wait_q_t *wait_q, k_timeout_t timeout)
+{
+	struct _pipe_desc *desc = &_current->pipe_desc;
+
+	desc->buffer        = NULL;
+	desc->bytes_to_xfer = 0U;
+	desc->thread        = _current;
+
+	_current->base.swap_data = desc;
+
+	(void) z_sched_wait(&pipe->lock, key, wait_q, timeout, NULL);
+}
+
+int k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data,
+		     size_t bytes_to_claim, size_t *bytes_claimed,
+		     k_timeout_t timeout)
+{
+	k_timepoint_t    end = sys_timepoint_calc(timeout);
+	k_timeout_t      wait = timeout;
+	k_spinlock_key_t key;
+	size_t           bytes_free;
+	int              ret;
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, put_claim, pipe, timeout);
+
+	CHECKIF((pipe->buffer == NULL) || (data == NULL) ||
+		(bytes_claimed == NULL) || (bytes_to_claim == 0U)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put_claim, pipe,
+					       timeout, -EINVAL);
+
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	while (true) {
+		if (pipe->put_claimed != 0U) {
+			ret = -EBUSY;
+			break;
+		}
+
+		if (pipe->bytes_used == 0U) {
+			/* Make the whole pipe buffer contiguous */
+
+			pipe->read_index = 0U;
+			pipe->write_index = 0U;
+		}
+
+		if (pipe->bytes_used == pipe->size) {
+			bytes_free = 0U;
+		} else if (pipe->write_index < pipe->read_index) {
+			bytes_free = pipe->read_index - pipe->write_index;
+		} else {
+			bytes_free = pipe->size - pipe->write_index;
+		}
+
+		if (bytes_free != 0U) {
+			pipe->put_claimed = MIN(bytes_free, bytes_to_claim);
+			*data = &pipe->buffer[pipe->write_index];
+			*bytes_claimed = pipe->put_claimed;
+			ret = 0;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = -EIO;
+			break;
+		}
+
+		wait = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(wait, K_NO_WAIT)) {
+			ret = -EAGAIN;
+			break;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_pipe, put_claim, pipe,
+						   timeout);
+
+		pipe_claim_wait(pipe, key, &pipe->wait_q.writers, wait);
+
+		key = k_spin_lock(&pipe->lock);
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put_claim, pipe, timeout, ret);
+
+	return ret;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t bytes_written)
+{
+	bool reschedule_needed = false;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if ((pipe->put_claimed == 0U) || (bytes_written > pipe->put_claimed)) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0U;
+	pipe->bytes_used += bytes_written;
+	pipe->write_index += bytes_written;
+	if (pipe->write_index >= pipe->size) {
+		pipe->write_index -= pipe->size;
+	}
+
+	pipe_waiters_service(pipe, &reschedule_needed);
+
+	if ((pipe->bytes_used != 0U) && (bytes_written != 0U)) {
+		handle_poll_events(pipe);
+	}
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+int k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data,
+		     size_t bytes_to_claim, size_t *bytes_claimed,
+		     k_timeout_t timeout)
+{
+	k_timepoint_t    end = sys_timepoint_calc(timeout);
+	k_timeout_t      wait = timeout;
+	k_spinlock_key_t key;
+	size_t           bytes_avail;
+	int              ret;
+
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, get_claim, pipe, timeout);
+
+	CHECKIF((pipe->buffer == NULL) || (data == NULL) ||
+		(bytes_claimed == NULL) || (bytes_to_claim == 0U)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get_claim, pipe,
+					       timeout, -EINVAL);
+
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	while (true) {
+		if (pipe->get_claimed != 0U) {
+			ret = -EBUSY;
+			break;
+		}
+
+		if (pipe->bytes_used == 0U) {
+			bytes_avail = 0U;
+		} else if (pipe->read_index < pipe->write_index) {
+			bytes_avail = pipe->write_index - pipe->read_index;
+		} else {
+			bytes_avail = pipe->size - pipe->read_index;
+		}
+
+		if (bytes_avail != 0U) {
+			pipe->get_claimed = MIN(bytes_avail, bytes_to_claim);
+			*data = &pipe->buffer[pipe->read_index];
+			*bytes_claimed = pipe->get_claimed;
+			ret = 0;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = -EIO;
+			break;
+		}
+
+		wait = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(wait, K_NO_WAIT)) {
+			ret = -EAGAIN;
+			break;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_pipe, get_claim, pipe,
+						   timeout);
+
+		pipe_claim_wait(pipe, key, &pipe->wait_q.readers, wait);
+
+		key = k_spin_lock(&pipe->lock);
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get_claim, pipe, timeout, ret);
+
+	return ret;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t bytes_read)
+{
+	bool reschedule_needed = false;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if ((pipe->get_claimed == 0U) || (bytes_read > pipe->get_claimed)) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0U;
+	pipe->bytes_used -= bytes_read;
+	pipe->read_index += bytes_read;
+	if (pipe->read_index >= pipe->size) {
+		pipe->read_index -= pipe->size;
+	}
+
+	pipe_waiters_service(pipe, &reschedule_needed);
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
@@ -35,10 +35,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -114,17 +115,22 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 {
 	struct k_poll_event *pending;
 
+	/* Poll sets have no thread: they come after the polling threads,
+	 * in the order they registered.
+	 */
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	if ((pending == NULL) || (poller->mode == MODE_SET) ||
+		((pending->poller->mode != MODE_SET) &&
+		 (z_sched_prio_cmp(poller_thread(pending->poller),
+				   poller_thread(poller)) > 0))) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if ((pending->poller->mode == MODE_SET) ||
+		    (z_sched_prio_cmp(poller_thread(poller),
+				      poller_thread(pending->poller)) > 0)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -443,6 +449,11 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
+	if ((poller != NULL) && (poller->mode == MODE_SET)) {
+		/* The event stays in its set */
+		return signal_set(event, state);
+	}
+
 	if (poller != NULL) {
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
@@ -477,6 +488,214 @@ void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 	k_spin_unlock(&lock, key);
 }
 
+/* must be called with interrupts locked */
+static void set_event_signaled(struct k_poll_set *set,
+			       struct k_poll_event *event)
+{
+	struct k_thread *thread;
+
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+
+/* must be called with interrupts locked */
+static int signal_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set =
+		CONTAINER_OF(event->poller, struct k_poll_set, poller);
+
+	event->state |= state;
+	set_event_signaled(set, event);
+
+	return 0;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = false;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	z_waitq_init(&set->wait_q);
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key;
+	uint32_t state;
+
+	if (event->type == K_POLL_TYPE_IGNORE) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (is_condition_met(event, &state)) {
+		event->poller = &set->poller;
+		event->state = state;
+		set_event_signaled(set, event);
+	} else {
+		register_event(event, &set->poller);
+	}
+
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	/* The event is either on its object's list, or on the ready list */
+	event->poller = NULL;
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+/*
+ * Markers are put on the ready list of a set by the calls collecting its
+ * events, to know where they started. They are not in the set.
+ */
+static inline bool is_marker(struct k_poll_set *set, sys_dnode_t *node)
+{
+	return CONTAINER_OF(node, struct k_poll_event, _node)->poller != &set->poller;
+}
+
+/* First node of the ready list, skipping the markers of other calls */
+static sys_dnode_t *poll_set_next(struct k_poll_set *set, sys_dnode_t *marker)
+{
+	sys_dnode_t *node = sys_dlist_peek_head(&set->ready);
+
+	while ((node != NULL) && (node != marker) && is_marker(set, node)) {
+		node = sys_dlist_peek_next(&set->ready, node);
+	}
+
+	return node;
+}
+
+/* must be called with interrupts locked */
+static int poll_set_collect(struct k_poll_set *set,
+			    struct k_poll_event **events, int num_events,
+			    k_spinlock_key_t *key)
+{
+	struct k_poll_event marker = { .poller = NULL };
+	int ready = 0;
+
+	/* Go through the events signaled so far once, up to the marker: the
+	 * events ready are put back at the end of the list, to be checked
+	 * again by the next call. The marker, unlike the last event, cannot
+	 * be removed meanwhile. Without @a events, stop at the first event
+	 * ready.
+	 */
+	sys_dlist_append(&set->ready, &marker._node);
+
+	while ((events != NULL) ? (ready < num_events) : (ready == 0)) {
+		sys_dnode_t *node = poll_set_next(set, &marker._node);
+		struct k_poll_event *event;
+		uint32_t cancelled;
+		uint32_t state;
+
+		if (node == &marker._node) {
+			break;
+		}
+
+		sys_dlist_remove(node);
+		event = CONTAINER_OF(node, struct k_poll_event, _node);
+		cancelled = event->state & K_POLL_STATE_CANCELLED;
+
+		if (is_condition_met(event, &state)) {
+			event->state = state | cancelled;
+			sys_dlist_append(&set->ready, node);
+			if (events != NULL) {
+				events[ready] = event;
+			}
+			ready++;
+		} else if ((cancelled != 0U) && (events == NULL)) {
+			/* Leave the cancellation to the next call */
+			sys_dlist_append(&set->ready, node);
+			ready++;
+		} else {
+			/* Report a cancellation once, then wait for the
+			 * object again.
+			 */
+			event->state = cancelled;
+			if (cancelled != 0U) {
+				events[ready++] = event;
+			}
+			register_event(event, &set->poller);
+		}
+
+		k_spin_unlock(&lock, *key);
+		*key = k_spin_lock(&lock);
+	}
+
+	sys_dlist_remove(&marker._node);
+
+	return ready;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int num_events, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int ready;
+	int rc;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT((events == NULL) || (num_events > 0), "no events\n");
+
+	key = k_spin_lock(&lock);
+
+	while (true) {
+		ready = poll_set_collect(set, events, num_events, &key);
+		if (ready > 0) {
+			k_spin_unlock(&lock, key);
+			return (events != NULL) ? ready : 0;
+		}
+
+		/* Events signaled while the others were checked */
+		if (poll_set_next(set, NULL) != NULL) {
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		rc = z_pend_curr(&lock, key, &set->wait_q, timeout);
+		if (rc != 0) {
+			return rc;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+		key = k_spin_lock(&lock);
+	}
+}
+
 void z_impl_k_poll_signal_init(struct k_poll_signal *sig)
 {
 	sys_dlist_init(&sig->poll_events);
@@ -100,6 +100,24 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	 */
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
+	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_WORK_STEALING)
+	/* Queue the thread where it last ran, where its working set
+	 * is most likely to still be cached.  The queue can't change
+	 * while the thread sits in it: base.cpu is only updated when
+	 * the thread is switched in, and the CPU mask only while it
+	 * is not runnable.
+	 */
+	int cpu = thread->base.cpu;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	int m = thread->base.cpu_mask;
+
+	if ((m != 0) && ((m & BIT(cpu)) == 0)) {
+		cpu = u32_count_trailing_zeros(m);
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
 	return &_kernel.cpus[cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
@@ -109,11 +127,11 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_RUNQ
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
@@ -130,9 +148,42 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 	_priq_run_remove(thread_runq(thread), thread);
 }
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+/* Look for a thread in the other CPUs' queues with a strictly higher
+ * priority than best, the best thread of our own queue (if any).
+ * Ties stay with the local queue, so threads of equal priority keep
+ * running where they were queued and CPUs only steal when they would
+ * otherwise idle or run lower priority work.  The victims are visited
+ * starting with our neighbour, so that the CPUs looking for work
+ * don't all go after the same queue first.  The priq "best" routines
+ * already skip threads whose CPU mask excludes the current CPU.
+ */
+static struct k_thread *runq_steal(struct k_thread *best)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int id = _current_cpu->id;
+
+	for (unsigned int i = 1; i < num_cpus; i++) {
+		struct _cpu *cpu = &_kernel.cpus[(id + i) % num_cpus];
+		struct k_thread *thread = _priq_run_best(&cpu->ready_q.runq);
+
+		if ((thread != NULL) &&
+		    ((best == NULL) || (z_sched_prio_cmp(thread, best) > 0))) {
+			best = thread;
+		}
+	}
+
+	return best;
+}
+#endif /* CONFIG_SCHED_WORK_STEALING */
+
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_WORK_STEALING
+	return runq_steal(_priq_run_best(curr_cpu_runq()));
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_WORK_STEALING */
 }
 
 /* _current is never in the run queue until context switch on
@@ -638,16 +689,6 @@ void z_sched_wake_thread(struct k_thread *thread, bool is_timeout)
 		bool killed = (thread->base.thread_state &
 				(_THREAD_DEAD | _THREAD_ABORTING));
 
-#ifdef CONFIG_EVENTS
-		bool do_nothing = thread->no_wake_on_timeout && is_timeout;
-
-		thread->no_wake_on_timeout = false;
-
-		if (do_nothing) {
-			continue;
-		}
-#endif /* CONFIG_EVENTS */
-
 		if (!killed) {
 			/* The thread is not being killed */
 			if (thread->base.pended_on != NULL) {
@@ -1012,7 +1053,7 @@ void init_ready_q(struct _ready_q *ready_q)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(ready_q->runq.queues); i++) {
 		sys_dlist_init(&ready_q->runq.queues[i]);
 	}
 #else
@@ -1022,13 +1063,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_RUNQ
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -1600,3 +1641,67 @@ int z_sched_waitq_walk(_wait_q_t  *wait_q,
 
 	return status;
 }
+
+#ifdef CONFIG_EVENTS
+unsigned int z_sched_waitq_wake_matching(_wait_q_t *wait_q,
+					 bool (*match)(struct k_thread *, void *),
+					 void *data, unsigned int max)
+{
+	struct k_thread *thread;
+	struct k_thread *head = NULL;
+	struct k_thread **tail = &head;
+	unsigned int woken = 0U;
+	__maybe_unused uint32_t ipi_mask = 0U;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		/* The wait queue can't be modified while it is walked: link
+		 * the matching threads, in wait queue order, to wake them
+		 * afterwards.
+		 */
+		_WAIT_Q_FOR_EACH(wait_q, thread) {
+			if (woken == max) {
+				break;
+			}
+			if ((thread->base.thread_state &
+			     (_THREAD_DEAD | _THREAD_ABORTING)) != 0U) {
+				continue;
+			}
+			if (!match(thread, data)) {
+				continue;
+			}
+
+			thread->next_event_link = NULL;
+			*tail = thread;
+			tail = &thread->next_event_link;
+			woken++;
+		}
+
+		for (thread = head; thread != NULL;
+		     thread = thread->next_event_link) {
+			unpend_thread_no_timeout(thread);
+			(void)z_abort_thread_timeout(thread);
+			z_mark_thread_as_started(thread);
+
+			if (!z_is_thread_queued(thread) &&
+			    z_is_thread_ready(thread)) {
+				SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready,
+							  thread);
+				queue_thread(thread);
+#ifdef CONFIG_SMP
+				ipi_mask |= ipi_mask_create(thread);
+#endif /* CONFIG_SMP */
+			}
+		}
+
+		/* Pick the next thread and flag the other CPUs once for the
+		 * whole batch, not once per thread.
+		 */
+		if (head != NULL) {
+			update_cache(0);
+			flag_ipi(ipi_mask);
+		}
+	}
+
+	return woken;
+}
+#endif /* CONFIG_EVENTS */
@@ -11,10 +11,14 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/barrier.h>
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif /* !CONFIG_TIMEOUT_QUEUE_WHEEL */
 
 static struct k_spinlock timeout_lock;
 
@@ -36,6 +40,512 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+static int32_t elapsed(void)
+{
+	/* While sys_clock_announce() is executing, new relative timeouts will be
+	 * scheduled relatively to the currently firing timeout's original tick
+	 * value (=curr_tick) rather than relative to the current
+	 * sys_clock_elapsed().
+	 *
+	 * This means that timeouts being scheduled from within timeout callbacks
+	 * will be scheduled at well-defined offsets from the currently firing
+	 * timeout.
+	 *
+	 * As a side effect, the same will happen if an ISR with higher priority
+	 * preempts a timeout callback and schedules a timeout.
+	 *
+	 * The distinction is implemented by looking at announce_remaining which
+	 * will be non-zero while sys_clock_announce() is executing and zero
+	 * otherwise.
+	 */
+	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+#define WHEEL_BITS	6
+#define WHEEL_SLOTS	BIT(WHEEL_BITS)
+#define WHEEL_LEVELS	CONFIG_TIMEOUT_QUEUE_WHEEL_LEVELS
+#define WHEEL_SPAN_BITS	(WHEEL_BITS * WHEEL_LEVELS)
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+#define NUM_TIMEOUT_QS	CONFIG_MP_MAX_NUM_CPUS
+#else
+#define NUM_TIMEOUT_QS	1
+#endif
+
+/* A timing wheel.  Level N slot S holds the timeouts whose expiry
+ * shares all bits above bit (N + 1) * WHEEL_BITS with the wheel's
+ * current tick, and whose bits in the level N field equal S.  A slot
+ * list is only valid while its bit is set in occupied[], so the slots
+ * need no initialization.
+ */
+struct timeout_q {
+	struct k_spinlock lock;
+
+	/* Tick up to which the wheel has been advanced.  It never runs
+	 * ahead of curr_tick while sys_clock_announce() is not running,
+	 * but with per-CPU queues it may lag behind it until the wheel
+	 * is serviced or armed again.
+	 */
+	uint64_t now;
+
+	/* Lower bound of the tick at which the wheel needs service,
+	 * UINT64_MAX if none, so that sys_clock_announce() only locks
+	 * the queues with work due.  must be locked (timeout_lock)
+	 */
+	uint64_t next;
+
+	uint64_t occupied[WHEEL_LEVELS];
+	sys_dlist_t slots[WHEEL_LEVELS][WHEEL_SLOTS];
+
+	/* Timeouts beyond the span of the top level, in no particular order */
+	sys_dlist_t overflow;
+};
+
+#define TIMEOUT_Q_INIT(i, _) \
+	{ .next = UINT64_MAX, \
+	  .overflow = SYS_DLIST_STATIC_INIT(&timeout_qs[i].overflow) }
+
+static struct timeout_q timeout_qs[NUM_TIMEOUT_QS] = {
+	LISTIFY(NUM_TIMEOUT_QS, TIMEOUT_Q_INIT, (,))
+};
+
+/* Lets timeouts be armed without taking timeout_lock: odd while
+ * curr_tick and announce_remaining are being updated.
+ */
+static atomic_t tick_seq;
+
+/* must be locked (timeout_lock) */
+static void set_tick(uint64_t tick, int remaining)
+{
+	atomic_inc(&tick_seq);
+	curr_tick = tick;
+	announce_remaining = remaining;
+	atomic_inc(&tick_seq);
+}
+
+/* Returns curr_tick and the ticks elapsed since, as one snapshot */
+static uint64_t tick_snapshot(int32_t *ticks_elapsed)
+{
+	atomic_val_t seq;
+	uint64_t tick;
+
+	do {
+		seq = atomic_get(&tick_seq);
+		tick = curr_tick;
+		*ticks_elapsed = elapsed();
+		barrier_dmem_fence_full();
+	} while (((seq & 1) != 0) || (seq != atomic_get(&tick_seq)));
+
+	return tick;
+}
+
+static struct timeout_q *local_q(void)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* Getting migrated right after reading this only costs
+	 * locality, the queue is locked on its own anyway.
+	 */
+	return &timeout_qs[_current_cpu->id];
+#else
+	return &timeout_qs[0];
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+/* Locks and returns the queue a timeout was last armed on */
+static struct timeout_q *lock_owner_q(const struct _timeout *to,
+				      k_spinlock_key_t *key)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	while (true) {
+		struct timeout_q *q = &timeout_qs[to->cpu];
+
+		*key = k_spin_lock(&q->lock);
+		if (q == &timeout_qs[to->cpu]) {
+			return q;
+		}
+
+		/* Re-armed on another CPU while we were spinning */
+		k_spin_unlock(&q->lock, *key);
+	}
+#else
+	*key = k_spin_lock(&timeout_qs[0].lock);
+
+	return &timeout_qs[0];
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+static void wheel_place(struct timeout_q *q, struct _timeout *t)
+{
+	for (int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		unsigned int shift = (lvl + 1) * WHEEL_BITS;
+
+		if ((t->expiry >> shift) == (q->now >> shift)) {
+			unsigned int idx = (t->expiry >> (lvl * WHEEL_BITS)) &
+					   (WHEEL_SLOTS - 1);
+
+			if ((q->occupied[lvl] & BIT64(idx)) == 0U) {
+				sys_dlist_init(&q->slots[lvl][idx]);
+				q->occupied[lvl] |= BIT64(idx);
+			}
+			sys_dlist_append(&q->slots[lvl][idx], &t->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&q->overflow, &t->node);
+}
+
+static void remove_timeout(struct timeout_q *q, struct _timeout *t)
+{
+	/* Only entry on its list: both links point at the list head,
+	 * which tells us which slot just became empty.
+	 */
+	if (t->node.next == t->node.prev) {
+		uintptr_t head = (uintptr_t)t->node.next;
+		uintptr_t base = (uintptr_t)&q->slots[0][0];
+
+		if ((head >= base) && (head < (base + sizeof(q->slots)))) {
+			size_t idx = (head - base) / sizeof(sys_dlist_t);
+
+			q->occupied[idx / WHEEL_SLOTS] &=
+				~BIT64(idx % WHEEL_SLOTS);
+		}
+	}
+
+	sys_dlist_remove(&t->node);
+}
+
+/* Earliest tick at which the wheel needs service: the expiry of the
+ * first level 0 timeout, or else the start of the first occupied upper
+ * level slot, which then has to be cascaded into the lower levels.
+ * Levels are searched bottom up, as every occupied slot of a level
+ * starts before any occupied slot of the levels above it.
+ */
+static bool wheel_next(struct timeout_q *q, uint64_t *tick)
+{
+	for (int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		unsigned int shift = lvl * WHEEL_BITS;
+		unsigned int cur = (q->now >> shift) & (WHEEL_SLOTS - 1);
+		uint64_t pending = q->occupied[lvl] & ~BIT64_MASK(cur);
+
+		if (pending != 0U) {
+			unsigned int idx = u64_count_trailing_zeros(pending);
+
+			*tick = (q->now & ~BIT64_MASK(shift + WHEEL_BITS)) |
+				((uint64_t)idx << shift);
+			return true;
+		}
+	}
+
+	if (!sys_dlist_is_empty(&q->overflow)) {
+		*tick = (q->now | BIT64_MASK(WHEEL_SPAN_BITS)) + 1U;
+		return true;
+	}
+
+	return false;
+}
+
+/* Rehash the slots starting at the wheel's tick into the levels below */
+static void wheel_cascade(struct timeout_q *q)
+{
+	if ((q->now & BIT64_MASK(WHEEL_SPAN_BITS)) == 0U) {
+		struct _timeout *t, *tmp;
+
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&q->overflow, t, tmp, node) {
+			if ((t->expiry >> WHEEL_SPAN_BITS) ==
+			    (q->now >> WHEEL_SPAN_BITS)) {
+				sys_dlist_remove(&t->node);
+				wheel_place(q, t);
+			}
+		}
+	}
+
+	for (int lvl = WHEEL_LEVELS - 1; lvl > 0; lvl--) {
+		unsigned int shift = lvl * WHEEL_BITS;
+		unsigned int idx = (q->now >> shift) & (WHEEL_SLOTS - 1);
+		sys_dnode_t *node;
+
+		if (((q->now & BIT64_MASK(shift)) != 0U) ||
+		    ((q->occupied[lvl] & BIT64(idx)) == 0U)) {
+			continue;
+		}
+
+		q->occupied[lvl] &= ~BIT64(idx);
+		while ((node = sys_dlist_get(&q->slots[lvl][idx])) != NULL) {
+			wheel_place(q, CONTAINER_OF(node, struct _timeout, node));
+		}
+	}
+}
+
+/* First timeout expiring exactly at the wheel's tick, if any */
+static struct _timeout *wheel_due(struct timeout_q *q)
+{
+	unsigned int idx = q->now & (WHEEL_SLOTS - 1);
+
+	if ((q->occupied[0] & BIT64(idx)) == 0U) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(sys_dlist_peek_head(&q->slots[0][idx]),
+			    struct _timeout, node);
+}
+
+/* Recompute the service hint of a queue.  must be locked (timeout_lock
+ * and the queue's lock)
+ */
+static void wheel_update_next(struct timeout_q *q)
+{
+	uint64_t tick;
+
+	q->next = wheel_next(q, &tick) ? tick : UINT64_MAX;
+}
+
+/* Queue possibly needing service first, if any, going by the hints
+ * only: none of the queues is locked.  must be locked (timeout_lock)
+ */
+static struct timeout_q *next_q(uint64_t *tick)
+{
+	struct timeout_q *next = NULL;
+
+	for (int i = 0; i < NUM_TIMEOUT_QS; i++) {
+		if ((timeout_qs[i].next != UINT64_MAX) &&
+		    ((next == NULL) || (timeout_qs[i].next < *tick))) {
+			next = &timeout_qs[i];
+			*tick = timeout_qs[i].next;
+		}
+	}
+
+	return next;
+}
+
+/* must be locked (timeout_lock) */
+static int32_t next_timeout(void)
+{
+	uint64_t tick;
+	int32_t ticks_elapsed = elapsed();
+	int32_t ret;
+
+	if ((next_q(&tick) == NULL) ||
+	    ((int64_t)(tick - curr_tick - ticks_elapsed) > (int64_t)INT_MAX)) {
+		ret = MAX_WAIT;
+	} else {
+		ret = MAX(0, (int64_t)(tick - curr_tick) - ticks_elapsed);
+	}
+
+	return ret;
+}
+
+void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
+		   k_timeout_t timeout)
+{
+	struct timeout_q *q;
+	k_spinlock_key_t key;
+	uint64_t base, expiry, prev, tick;
+	int32_t ticks_elapsed;
+	bool armed, reprogram;
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return;
+	}
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif /* CONFIG_KERNEL_COHERENCE */
+
+	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	to->fn = fn;
+
+	base = tick_snapshot(&ticks_elapsed);
+	if (Z_TICK_ABS(timeout.ticks) >= 0) {
+		expiry = MAX(base + 1, Z_TICK_ABS(timeout.ticks));
+	} else {
+		expiry = base + MAX(1, timeout.ticks + 1 + ticks_elapsed);
+	}
+
+	q = local_q();
+	key = k_spin_lock(&q->lock);
+
+	/* A wheel never goes back in time.  This only matters when the
+	 * wheel has already been brought up to date by a concurrent
+	 * sys_clock_announce() on another CPU, and merely delays the
+	 * expiry to the end of that announcement.
+	 */
+	to->expiry = MAX(expiry, q->now);
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	to->cpu = ARRAY_INDEX(timeout_qs, q);
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+	armed = wheel_next(q, &prev);
+
+	/* Announcements only advance the wheel of the CPU running them,
+	 * catch up this one while it has nothing due.
+	 */
+	if (!armed || (prev > base)) {
+		q->now = MAX(q->now, base);
+	}
+
+	wheel_place(q, to);
+	reprogram = wheel_next(q, &tick) && (!armed || (tick < prev));
+
+	k_spin_unlock(&q->lock, key);
+
+	/* The hint of the queue only needs to be lowered along with the
+	 * timer: an announcement in progress sees it before it is done.
+	 */
+	if (reprogram) {
+		K_SPINLOCK(&timeout_lock) {
+			q->next = MIN(q->next, tick);
+			if (announce_remaining == 0) {
+				sys_clock_set_timeout(next_timeout(), false);
+			}
+		}
+	}
+}
+
+int z_abort_timeout(struct _timeout *to)
+{
+	int ret = -EINVAL;
+	k_spinlock_key_t key;
+	struct timeout_q *q = lock_owner_q(to, &key);
+
+	if (sys_dnode_is_linked(&to->node)) {
+		remove_timeout(q, to);
+		ret = 0;
+	}
+
+	k_spin_unlock(&q->lock, key);
+
+	return ret;
+}
+
+k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+	k_spinlock_key_t key;
+	struct timeout_q *q = lock_owner_q(timeout, &key);
+
+	if (!z_is_inactive_timeout(timeout)) {
+		int32_t ticks_elapsed;
+		uint64_t base = tick_snapshot(&ticks_elapsed);
+
+		ticks = timeout->expiry - base - ticks_elapsed;
+	}
+
+	k_spin_unlock(&q->lock, key);
+
+	return ticks;
+}
+
+k_ticks_t z_timeout_expires(const struct _timeout *timeout)
+{
+	k_ticks_t ticks;
+	k_spinlock_key_t key;
+	struct timeout_q *q = lock_owner_q(timeout, &key);
+
+	if (!z_is_inactive_timeout(timeout)) {
+		ticks = timeout->expiry;
+	} else {
+		int32_t ticks_elapsed;
+
+		ticks = tick_snapshot(&ticks_elapsed);
+	}
+
+	k_spin_unlock(&q->lock, key);
+
+	return ticks;
+}
+
+/* Bring the local queue up to the given tick, unless it still has
+ * timeouts being armed to expire by then.  The other queues catch up
+ * when serviced or when timeouts are armed on them.
+ */
+static void advance_local_q(uint64_t target)
+{
+	struct timeout_q *q = local_q();
+	uint64_t tick;
+
+	K_SPINLOCK(&q->lock) {
+		if (!wheel_next(q, &tick) || (tick > target)) {
+			q->now = MAX(q->now, target);
+		}
+	}
+}
+
+void sys_clock_announce(int32_t ticks)
+{
+	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+
+	/* We release the lock around the callbacks below, so on SMP
+	 * systems someone might be already running the loop.  Don't
+	 * race (which will cause parallel execution of "sequential"
+	 * timeouts and confuse apps), just increment the tick count
+	 * and return.
+	 */
+	if (IS_ENABLED(CONFIG_SMP) && (announce_remaining != 0)) {
+		set_tick(curr_tick, announce_remaining + ticks);
+		k_spin_unlock(&timeout_lock, key);
+		return;
+	}
+
+	set_tick(curr_tick, ticks);
+
+	/* With per-CPU queues, always service the queue with the
+	 * earliest pending work, so timeouts keep expiring in tick
+	 * order no matter which CPU they were armed on.  Only that
+	 * queue is locked, going by the hints of the others.
+	 */
+	while (true) {
+		struct _timeout *t = NULL;
+		struct timeout_q *q;
+		uint64_t tick;
+		int dt;
+
+		q = next_q(&tick);
+		if ((q == NULL) || (tick > (curr_tick + announce_remaining))) {
+			break;
+		}
+
+		K_SPINLOCK(&q->lock) {
+			/* The hint may be stale, its timeouts aborted */
+			if (wheel_next(q, &tick) &&
+			    (tick <= (curr_tick + announce_remaining))) {
+				q->now = tick;
+				wheel_cascade(q);
+
+				t = wheel_due(q);
+				if (t != NULL) {
+					remove_timeout(q, t);
+				}
+			} else {
+				tick = curr_tick;
+			}
+			wheel_update_next(q);
+		}
+
+		dt = (tick > curr_tick) ? (int)(tick - curr_tick) : 0;
+		set_tick(curr_tick + dt, announce_remaining);
+
+		if (t != NULL) {
+			k_spin_unlock(&timeout_lock, key);
+			t->fn(t);
+			key = k_spin_lock(&timeout_lock);
+		}
+		set_tick(curr_tick, announce_remaining - dt);
+	}
+
+	advance_local_q(curr_tick + announce_remaining);
+	set_tick(curr_tick + announce_remaining, 0);
+
+	sys_clock_set_timeout(next_timeout(), false);
+
+	k_spin_unlock(&timeout_lock, key);
+
+#ifdef CONFIG_TIMESLICING
+	z_time_slice();
+#endif /* CONFIG_TIMESLICING */
+}
+#else
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,27 +569,6 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
-static int32_t elapsed(void)
-{
-	/* While sys_clock_announce() is executing, new relative timeouts will be
-	 * scheduled relatively to the currently firing timeout's original tick
-	 * value (=curr_tick) rather than relative to the current
-	 * sys_clock_elapsed().
-	 *
-	 * This means that timeouts being scheduled from within timeout callbacks
-	 * will be scheduled at well-defined offsets from the currently firing
-	 * timeout.
-	 *
-	 * As a side effect, the same will happen if an ISR with higher priority
-	 * preempts a timeout callback and schedules a timeout.
-	 *
-	 * The distinction is implemented by looking at announce_remaining which
-	 * will be non-zero while sys_clock_announce() is executing and zero
-	 * otherwise.
-	 */
-	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
-}
-
 static int32_t next_timeout(void)
 {
 	struct _timeout *to = first();
@@ -197,16 +686,6 @@ k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 	return ticks;
 }
 
-int32_t z_get_next_timeout_expiry(void)
-{
-	int32_t ret = (int32_t) K_TICKS_FOREVER;
-
-	K_SPINLOCK(&timeout_lock) {
-		ret = next_timeout();
-	}
-	return ret;
-}
-
 void sys_clock_announce(int32_t ticks)
 {
 	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
@@ -257,6 +736,17 @@ void sys_clock_announce(int32_t ticks)
 	z_time_slice();
 #endif /* CONFIG_TIMESLICING */
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+int32_t z_get_next_timeout_expiry(void)
+{
+	int32_t ret = (int32_t) K_TICKS_FOREVER;
+
+	K_SPINLOCK(&timeout_lock) {
+		ret = next_timeout();
+	}
+	return ret;
+}
 
 int64_t sys_clock_tick_get(void)
 {
@@ -328,9 +818,59 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 }
 
 #ifdef CONFIG_ZTEST
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+/* Rehash the timeouts of a queue for a new tick count, keeping their
+ * remaining time.  must be locked
+ */
+static void wheel_rebase(struct timeout_q *q, uint64_t prev, uint64_t tick)
+{
+	sys_dlist_t pending = SYS_DLIST_STATIC_INIT(&pending);
+	sys_dnode_t *node;
+
+	for (int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		for (int idx = 0; idx < WHEEL_SLOTS; idx++) {
+			if ((q->occupied[lvl] & BIT64(idx)) == 0U) {
+				continue;
+			}
+			while ((node = sys_dlist_get(&q->slots[lvl][idx])) != NULL) {
+				sys_dlist_append(&pending, node);
+			}
+		}
+		q->occupied[lvl] = 0U;
+	}
+	while ((node = sys_dlist_get(&q->overflow)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	q->now = tick;
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+		t->expiry = t->expiry - prev + tick;
+		wheel_place(q, t);
+	}
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	K_SPINLOCK(&timeout_lock) {
+		uint64_t prev = curr_tick;
+
+		set_tick(tick, announce_remaining);
+
+		for (int i = 0; i < NUM_TIMEOUT_QS; i++) {
+			k_spinlock_key_t key = k_spin_lock(&timeout_qs[i].lock);
+
+			wheel_rebase(&timeout_qs[i], prev, tick);
+			wheel_update_next(&timeout_qs[i]);
+			k_spin_unlock(&timeout_qs[i].lock, key);
+		}
+	}
+#else
 	curr_tick = tick;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
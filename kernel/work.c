@@ -65,12 +65,18 @@ static struct k_spinlock lock;
 /* Invoked by work thread */
 static void handle_flush(struct k_work *work) { }
 
-static inline void init_flusher(struct z_work_flusher *flusher)
+static inline void init_flusher(struct z_work_flusher *flusher,
+				struct k_work *target)
 {
 	struct k_work *work = &flusher->work;
 	k_sem_init(&flusher->sem, 0, 1);
 	k_work_init(&flusher->work, handle_flush);
 	flag_set(&work->flags, K_WORK_FLUSHING_BIT);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	flusher->target = target;
+#else
+	ARG_UNUSED(target);
+#endif
 }
 
 /* List of pending cancellations. */
@@ -199,7 +205,7 @@ static void queue_flusher_locked(struct k_work_q *queue,
 		}
 	}
 
-	init_flusher(flusher);
+	init_flusher(flusher, work);
 	if (in_list) {
 		sys_slist_insert(&queue->pending, &work->node,
 				 &flusher->work.node);
@@ -245,6 +251,31 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	return rv;
 }
 
+/* Check whether the current thread is one of the queue threads.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue to check.
+ */
+static inline bool queue_thread_is_current(struct k_work_q *queue)
+{
+	if (_current == &queue->thread) {
+		return true;
+	}
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (_current == &worker->thread) {
+			return true;
+		}
+	}
+#endif
+
+	return false;
+}
+
 /* Submit an work item to a queue if queue state allows new work.
  *
  * Submission is rejected if no queue is provided, or if the queue is
@@ -272,7 +303,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = queue_thread_is_current(queue) && !k_is_in_isr();
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -609,6 +640,74 @@ bool k_work_cancel_sync(struct k_work *work,
 	return pending;
 }
 
+/* Get the next work item a queue thread can run.
+ *
+ * Invoked with work lock held.
+ *
+ * With several threads on the queue, work items running on another thread
+ * are skipped so that their handler is not reentered, and so are flushers
+ * of such items so that they don't complete before the item does.
+ *
+ * @param queue the queue from which the work should be taken.
+ *
+ * @return the work item, removed from the pending list, or null if there
+ * is no work item that can run now.
+ */
+static struct k_work *queue_get_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	struct k_work *work;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->pending, work, node) {
+		struct k_work *target = work;
+
+		if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+			target = CONTAINER_OF(work, struct z_work_flusher,
+					      work)->target;
+		}
+
+		if (!flag_test(&target->flags, K_WORK_RUNNING_BIT)) {
+			sys_slist_remove(&queue->pending, prev, &work->node);
+			return work;
+		}
+		prev = &work->node;
+	}
+
+	return NULL;
+#else
+	sys_snode_t *node = sys_slist_get(&queue->pending);
+
+	return (node != NULL) ? CONTAINER_OF(node, struct k_work, node) : NULL;
+#endif
+}
+
+/* Mark a queue as busy with one more work item.
+ *
+ * Invoked with work lock held.
+ */
+static inline void queue_busy_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	queue->busy++;
+#endif
+	flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+}
+
+/* Mark a queue as done with a work item.
+ *
+ * Invoked with work lock held.
+ */
+static inline void queue_done_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	if (--queue->busy != 0U) {
+		return;
+	}
+#endif
+	flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+}
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -621,38 +720,25 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
 
 	while (true) {
-		sys_snode_t *node;
-		struct k_work *work = NULL;
+		struct k_work *work;
 		k_work_handler_t handler = NULL;
 		k_spinlock_key_t key = k_spin_lock(&lock);
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
-		if (node != NULL) {
+		work = queue_get_locked(queue);
+		if (work != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
-			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
-			work = CONTAINER_OF(node, struct k_work, node);
+			queue_busy_locked(queue);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
-
-			/* Static code analysis tool can raise a false-positive violation
-			 * in the line below that 'work' is checked for null after being
-			 * dereferenced.
-			 *
-			 * The work is figured out by CONTAINER_OF, as a container
-			 * of type struct k_work that contains the node.
-			 * The only way for it to be NULL is if node would be a member
-			 * of struct k_work object that has been placed at address NULL,
-			 * which should never happen, even line 'if (work != NULL)'
-			 * ensures that.
-			 * This means that if node is not NULL, then work will not be NULL.
-			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
-					       K_WORK_QUEUE_DRAIN_BIT)) {
+		} else if (!flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT)
+			   && sys_slist_is_empty(&queue->pending)
+			   && flag_test_and_clear(&queue->flags,
+						  K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
 			 * immediate reschedule; released threads get their
@@ -702,7 +788,15 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
-		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		queue_done_locked(queue);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+		/* Items skipped while this one was running may be runnable
+		 * now: let an idle thread have a look.
+		 */
+		if (!sys_slist_is_empty(&queue->pending)) {
+			(void)notify_queue_locked(queue);
+		}
+#endif
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -742,6 +836,10 @@ void k_work_queue_start(struct k_work_q *queue,
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	sys_slist_init(&queue->workers);
+	queue->busy = 0U;
+#endif
 
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
@@ -770,6 +868,62 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+int k_work_queue_worker_add(struct k_work_q *queue,
+			    struct k_work_q_worker *worker,
+			    k_thread_stack_t *stack,
+			    size_t stack_size,
+			    int cpu,
+			    const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(worker);
+	__ASSERT_NO_MSG(stack);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, worker_add, queue, worker);
+
+	int ret = 0;
+
+	if (!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT)) {
+		ret = -ENODEV;
+	} else if ((cpu >= (int)arch_num_cpus())
+		   || ((cpu >= 0) && !IS_ENABLED(CONFIG_SCHED_CPU_MASK))) {
+		ret = -EINVAL;
+	} else {
+		(void)k_thread_create(&worker->thread, stack, stack_size,
+				      work_queue_main, queue, NULL, NULL,
+				      k_thread_priority_get(&queue->thread),
+				      0, K_FOREVER);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if (cpu >= 0) {
+			(void)k_thread_cpu_pin(&worker->thread, cpu);
+		}
+#endif
+
+		if ((cfg != NULL) && (cfg->name != NULL)) {
+			k_thread_name_set(&worker->thread, cfg->name);
+		}
+
+		if ((cfg != NULL) && (cfg->essential)) {
+			worker->thread.base.user_options |= K_ESSENTIAL;
+		}
+
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		sys_slist_append(&queue->workers, &worker->node);
+
+		k_spin_unlock(&lock, key);
+
+		k_thread_start(&worker->thread);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, worker_add, queue, worker, ret);
+
+	return ret;
+}
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -5,6 +5,7 @@
  */
 
 #include <zephyr/sys/crc.h>
+#include "crc_internal.h"
 
 uint16_t crc16(uint16_t poly, uint16_t seed, const uint8_t *src, size_t len)
 {
@@ -49,8 +50,25 @@ uint16_t crc16_reflect(uint16_t poly, uint16_t seed, const uint8_t *src, size_t
 }
 
 
+#ifndef CONFIG_CRC_TABLE_NIBBLE
+/* crc table generated from polynomial 0x8408 (0x1021 reflected) */
+static const uint16_t crc16_ccitt_table[256] =
+	Z_CRC_TABLE(0x1189U, 0x2312U, 0x4624U, 0x8c48U, 0x1081U, 0x2102U, 0x4204U, 0x8408U);
+
+/* crc table generated from polynomial 0x1021 */
+static const uint16_t crc16_itu_t_table[256] =
+	Z_CRC_TABLE(0x1021U, 0x2042U, 0x4084U, 0x8108U, 0x1231U, 0x2462U, 0x48c4U, 0x9188U);
+#endif
+
 uint16_t crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
 {
+#ifndef CONFIG_CRC_TABLE_NIBBLE
+	for (size_t i = 0; i < len; i++) {
+		seed = (seed >> 8) ^ crc16_ccitt_table[(seed ^ src[i]) & 0xff];
+	}
+
+	return seed;
+#else
 	for (; len > 0; len--) {
 		uint8_t e, f;
 
@@ -61,10 +79,18 @@ uint16_t crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
 	}
 
 	return seed;
+#endif
 }
 
 uint16_t crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
 {
+#ifndef CONFIG_CRC_TABLE_NIBBLE
+	for (size_t i = 0; i < len; i++) {
+		seed = (seed << 8) ^ crc16_itu_t_table[(seed >> 8) ^ src[i]];
+	}
+
+	return seed;
+#else
 	for (; len > 0; len--) {
 		seed = (seed >> 8U) | (seed << 8U);
 		seed ^= *src;
@@ -75,4 +101,5 @@ uint16_t crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
 	}
 
 	return seed;
+#endif
 }
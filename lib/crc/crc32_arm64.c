@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/crc.h>
+#include <zephyr/toolchain.h>
+#include "crc_internal.h"
+
+/* The CRC32 instructions, for the bit-reflected polynomials 0xedb88320 (IEEE)
+ * and 0x82f63b78 (Castagnoli).
+ */
+static ALWAYS_INLINE uint32_t crc32_byte(uint32_t crc, uint8_t val, bool castagnoli)
+{
+	if (castagnoli) {
+		__asm__(".arch_extension crc\n\tcrc32cb %w0, %w0, %w1"
+			: "+r"(crc) : "r"((uint32_t)val));
+	} else {
+		__asm__(".arch_extension crc\n\tcrc32b %w0, %w0, %w1"
+			: "+r"(crc) : "r"((uint32_t)val));
+	}
+
+	return crc;
+}
+
+static ALWAYS_INLINE uint32_t crc32_dword(uint32_t crc, uint64_t val, bool castagnoli)
+{
+	if (castagnoli) {
+		__asm__(".arch_extension crc\n\tcrc32cx %w0, %w0, %x1"
+			: "+r"(crc) : "r"(val));
+	} else {
+		__asm__(".arch_extension crc\n\tcrc32x %w0, %w0, %x1"
+			: "+r"(crc) : "r"(val));
+	}
+
+	return crc;
+}
+
+static ALWAYS_INLINE size_t crc32_arm64(uint32_t *crc, const uint8_t *data, size_t len,
+					bool castagnoli)
+{
+	uint32_t c = *crc;
+	size_t i = 0;
+
+	/* Up to an aligned double word */
+	for (; i < len && ((uintptr_t)&data[i] & 7) != 0; i++) {
+		c = crc32_byte(c, data[i], castagnoli);
+	}
+
+	for (; len - i >= 8; i += 8) {
+		c = crc32_dword(c, *(const uint64_t *)&data[i], castagnoli);
+	}
+
+	for (; i < len; i++) {
+		c = crc32_byte(c, data[i], castagnoli);
+	}
+
+	*crc = c;
+
+	return len;
+}
+
+size_t z_crc32_ieee_hw(uint32_t *crc, const uint8_t *data, size_t len)
+{
+	return crc32_arm64(crc, data, len, false);
+}
+
+size_t z_crc32_c_hw(uint32_t *crc, const uint8_t *data, size_t len)
+{
+	return crc32_arm64(crc, data, len, true);
+}
@@ -5,13 +5,10 @@
  */
 
 #include <zephyr/sys/crc.h>
+#include "crc_internal.h"
 
-uint32_t crc32_ieee(const uint8_t *data, size_t len)
-{
-	return crc32_ieee_update(0x0, data, len);
-}
-
-uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
+#ifdef CONFIG_CRC_TABLE_NIBBLE
+static uint32_t crc32_ieee_sw(uint32_t crc, const uint8_t *data, size_t len)
 {
 	/* crc table generated from polynomial 0xedb88320 */
 	static const uint32_t table[16] = {
@@ -21,8 +18,6 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 		0x9b64c2b0U, 0x86d3d2d4U, 0xa00ae278U, 0xbdbdf21cU,
 	};
 
-	crc = ~crc;
-
 	for (size_t i = 0; i < len; i++) {
 		uint8_t byte = data[i];
 
@@ -30,5 +25,52 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 		crc = (crc >> 4) ^ table[(crc ^ ((uint32_t)byte >> 4)) & 0x0f];
 	}
 
-	return (~crc);
+	return crc;
+}
+#else
+/* crc tables generated from polynomial 0xedb88320 */
+static const uint32_t crc32_ieee_table[][256] = {
+	Z_CRC_TABLE(0x77073096U, 0xee0e612cU, 0x076dc419U, 0x0edb8832U,
+		    0x1db71064U, 0x3b6e20c8U, 0x76dc4190U, 0xedb88320U),
+#ifdef CONFIG_CRC_TABLE_SLICE_BY_8
+	Z_CRC_TABLE(0x191b3141U, 0x32366282U, 0x646cc504U, 0xc8d98a08U,
+		    0x4ac21251U, 0x958424a2U, 0xf0794f05U, 0x3b83984bU),
+	Z_CRC_TABLE(0x01c26a37U, 0x0384d46eU, 0x0709a8dcU, 0x0e1351b8U,
+		    0x1c26a370U, 0x384d46e0U, 0x709a8dc0U, 0xe1351b80U),
+	Z_CRC_TABLE(0xb8bc6765U, 0xaa09c88bU, 0x8f629757U, 0xc5b428efU,
+		    0x5019579fU, 0xa032af3eU, 0x9b14583dU, 0xed59b63bU),
+	Z_CRC_TABLE(0x3d6029b0U, 0x7ac05360U, 0xf580a6c0U, 0x30704bc1U,
+		    0x60e09782U, 0xc1c12f04U, 0x58f35849U, 0xb1e6b092U),
+	Z_CRC_TABLE(0xcb5cd3a5U, 0x4dc8a10bU, 0x9b914216U, 0xec53826dU,
+		    0x03d6029bU, 0x07ac0536U, 0x0f580a6cU, 0x1eb014d8U),
+	Z_CRC_TABLE(0xa6770bb4U, 0x979f1129U, 0xf44f2413U, 0x33ef4e67U,
+		    0x67de9cceU, 0xcfbd399cU, 0x440b7579U, 0x8816eaf2U),
+	Z_CRC_TABLE(0xccaa009eU, 0x4225077dU, 0x844a0efaU, 0xd3e51bb5U,
+		    0x7cbb312bU, 0xf9766256U, 0x299dc2edU, 0x533b85daU),
+#endif
+};
+
+static uint32_t crc32_ieee_sw(uint32_t crc, const uint8_t *data, size_t len)
+{
+	return crc32_table_update(crc32_ieee_table, crc, data, len);
+}
+#endif /* CONFIG_CRC_TABLE_NIBBLE */
+
+uint32_t crc32_ieee(const uint8_t *data, size_t len)
+{
+	return crc32_ieee_update(0x0, data, len);
+}
+
+uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	crc = ~crc;
+
+#ifdef CONFIG_CRC_HW
+	size_t done = z_crc32_ieee_hw(&crc, data, len);
+
+	data += done;
+	len -= done;
+#endif
+
+	return ~crc32_ieee_sw(crc, data, len);
 }
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cpuid.h>
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+#include <zephyr/sys/crc.h>
+#include "crc_internal.h"
+
+#define CRC_X86_PCLMUL BIT(0)
+#define CRC_X86_SSE42 BIT(1)
+
+static int crc_x86_features(void)
+{
+	/* Found on first use */
+	static int features = -1;
+
+	if (features < 0) {
+		unsigned int eax, ebx, ecx, edx;
+		int found = 0;
+
+		if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0) {
+			if ((ecx & bit_PCLMUL) != 0 && (ecx & bit_SSE4_1) != 0) {
+				found |= CRC_X86_PCLMUL;
+			}
+			if ((ecx & bit_SSE4_2) != 0) {
+				found |= CRC_X86_SSE42;
+			}
+		}
+
+		features = found;
+	}
+
+	return features;
+}
+
+/*
+ * Folding of 64 bytes at a time with carry-less multiplications, then reduction
+ * to 32 bits, as described in "Fast CRC Computation for Generic Polynomials
+ * Using PCLMULQDQ Instruction" from Intel. The constants are those of the
+ * bit-reflected polynomial 0xedb88320. len is at least 64, and a multiple of 16.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t crc32_ieee_pclmul(uint32_t crc, const uint8_t *data, size_t len)
+{
+	static const uint64_t k1k2[] __aligned(16) = { 0x0154442bd4, 0x01c6e41596 };
+	static const uint64_t k3k4[] __aligned(16) = { 0x01751997d0, 0x00ccaa009e };
+	static const uint64_t k5k0[] __aligned(16) = { 0x0163cd6124, 0x0000000000 };
+	static const uint64_t poly[] __aligned(16) = { 0x01db710641, 0x01f7011641 };
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+	x1 = _mm_loadu_si128((const __m128i *)&data[0x00]);
+	x2 = _mm_loadu_si128((const __m128i *)&data[0x10]);
+	x3 = _mm_loadu_si128((const __m128i *)&data[0x20]);
+	x4 = _mm_loadu_si128((const __m128i *)&data[0x30]);
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+	x0 = _mm_load_si128((const __m128i *)k1k2);
+	data += 64;
+	len -= 64;
+
+	/* Four folds in parallel */
+	for (; len >= 64; data += 64, len -= 64) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5),
+				   _mm_loadu_si128((const __m128i *)&data[0x00]));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6),
+				   _mm_loadu_si128((const __m128i *)&data[0x10]));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7),
+				   _mm_loadu_si128((const __m128i *)&data[0x20]));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8),
+				   _mm_loadu_si128((const __m128i *)&data[0x30]));
+	}
+
+	/* Down to 128 bits */
+	x0 = _mm_load_si128((const __m128i *)k3k4);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	for (; len >= 16; data += 16, len -= 16) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5),
+				   _mm_loadu_si128((const __m128i *)data));
+	}
+
+	/* Down to 64 bits */
+	x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+	x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+	x0 = _mm_loadl_epi64((const __m128i *)k5k0);
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, x3);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	/* Barrett reduction to 32 bits */
+	x0 = _mm_load_si128((const __m128i *)poly);
+	x2 = _mm_and_si128(x1, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+	x2 = _mm_and_si128(x2, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+size_t z_crc32_ieee_hw(uint32_t *crc, const uint8_t *data, size_t len)
+{
+	if (len < 64 || (crc_x86_features() & CRC_X86_PCLMUL) == 0) {
+		return 0;
+	}
+
+	len &= ~(size_t)15;
+	*crc = crc32_ieee_pclmul(*crc, data, len);
+
+	return len;
+}
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32_c_sse42(uint32_t crc, const uint8_t *data, size_t len)
+{
+#ifdef CONFIG_64BIT
+	uint64_t crc64 = crc;
+
+	for (; len >= 8; data += 8, len -= 8) {
+		crc64 = _mm_crc32_u64(crc64, sys_get_le64(data));
+	}
+	crc = (uint32_t)crc64;
+#endif
+
+	for (; len >= 4; data += 4, len -= 4) {
+		crc = _mm_crc32_u32(crc, sys_get_le32(data));
+	}
+
+	for (; len > 0; data++, len--) {
+		crc = _mm_crc32_u8(crc, *data);
+	}
+
+	return crc;
+}
+
+size_t z_crc32_c_hw(uint32_t *crc, const uint8_t *data, size_t len)
+{
+	if ((crc_x86_features() & CRC_X86_SSE42) == 0) {
+		return 0;
+	}
+
+	*crc = crc32_c_sse42(*crc, data, len);
+
+	return len;
+}
@@ -5,7 +5,9 @@
  */
 
 #include <zephyr/sys/crc.h>
+#include "crc_internal.h"
 
+#ifdef CONFIG_CRC_TABLE_NIBBLE
 /* crc table generated from polynomial 0x1EDC6F41UL (Castagnoli) */
 static const uint32_t crc32c_table[16] = {
 	0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL,
@@ -14,6 +16,44 @@ static const uint32_t crc32c_table[16] = {
 	0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL
 };
 
+static uint32_t crc32c_sw(uint32_t crc, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc = crc32c_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+		crc = crc32c_table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+	}
+
+	return crc;
+}
+#else
+/* crc tables generated from polynomial 0x1EDC6F41UL (Castagnoli) */
+static const uint32_t crc32c_table[][256] = {
+	Z_CRC_TABLE(0xf26b8303U, 0xe13b70f7U, 0xc79a971fU, 0x8ad958cfU,
+		    0x105ec76fU, 0x20bd8edeU, 0x417b1dbcU, 0x82f63b78U),
+#ifdef CONFIG_CRC_TABLE_SLICE_BY_8
+	Z_CRC_TABLE(0x13a29877U, 0x274530eeU, 0x4e8a61dcU, 0x9d14c3b8U,
+		    0x3fc5f181U, 0x7f8be302U, 0xff17c604U, 0xfbc3faf9U),
+	Z_CRC_TABLE(0xa541927eU, 0x4f6f520dU, 0x9edea41aU, 0x38513ec5U,
+		    0x70a27d8aU, 0xe144fb14U, 0xc76580d9U, 0x8b277743U),
+	Z_CRC_TABLE(0xdd45aab8U, 0xbf672381U, 0x7b2231f3U, 0xf64463e6U,
+		    0xe964b13dU, 0xd725148bU, 0xaba65fe7U, 0x52a0c93fU),
+	Z_CRC_TABLE(0x38116facU, 0x7022df58U, 0xe045beb0U, 0xc5670b91U,
+		    0x8f2261d3U, 0x1ba8b557U, 0x37516aaeU, 0x6ea2d55cU),
+	Z_CRC_TABLE(0xef306b19U, 0xdb8ca0c3U, 0xb2f53777U, 0x6006181fU,
+		    0xc00c303eU, 0x85f4168dU, 0x0e045bebU, 0x1c08b7d6U),
+	Z_CRC_TABLE(0x68032cc8U, 0xd0065990U, 0xa5e0c5d1U, 0x4e2dfd53U,
+		    0x9c5bfaa6U, 0x3d5b83bdU, 0x7ab7077aU, 0xf56e0ef4U),
+	Z_CRC_TABLE(0x493c7d27U, 0x9278fa4eU, 0x211d826dU, 0x423b04daU,
+		    0x847609b4U, 0x0d006599U, 0x1a00cb32U, 0x34019664U),
+#endif
+};
+
+static uint32_t crc32c_sw(uint32_t crc, const uint8_t *data, size_t len)
+{
+	return crc32_table_update(crc32c_table, crc, data, len);
+}
+#endif /* CONFIG_CRC_TABLE_NIBBLE */
+
 /* This value needs to be XORed with the final crc value once crc for
  * the entire stream is calculated. This is a requirement of crc32c algo.
  */
@@ -31,10 +71,14 @@ uint32_t crc32_c(uint32_t crc, const uint8_t *data,
 		crc = CRC32C_INIT;
 	}
 
-	for (size_t i = 0; i < len; i++) {
-		crc = crc32c_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
-		crc = crc32c_table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0F] ^ (crc >> 4);
-	}
+#ifdef CONFIG_CRC_HW
+	size_t done = z_crc32_c_hw(&crc, data, len);
+
+	data += done;
+	len -= done;
+#endif
+
+	crc = crc32c_sw(crc, data, len);
 
 	return last_pkt ? (crc ^ CRC32C_XOR_OUT) : crc;
 }
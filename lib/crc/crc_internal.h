@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_CRC_CRC_INTERNAL_H_
+#define ZEPHYR_LIB_CRC_CRC_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * A CRC is linear: the entry of a table for a byte is the XOR of the entries
+ * for each of its bits set. Tables of 256 entries are thus built at compile
+ * time from the entries for 0x01, 0x02, ... 0x80.
+ */
+#define Z_CRC_TABLE_ENTRY(i, b0, b1, b2, b3, b4, b5, b6, b7) \
+	((((i) & 0x01) ? (b0) : 0U) ^ (((i) & 0x02) ? (b1) : 0U) ^ \
+	 (((i) & 0x04) ? (b2) : 0U) ^ (((i) & 0x08) ? (b3) : 0U) ^ \
+	 (((i) & 0x10) ? (b4) : 0U) ^ (((i) & 0x20) ? (b5) : 0U) ^ \
+	 (((i) & 0x40) ? (b6) : 0U) ^ (((i) & 0x80) ? (b7) : 0U))
+
+#define Z_CRC_TABLE(...) { LISTIFY(256, Z_CRC_TABLE_ENTRY, (,), __VA_ARGS__) }
+
+/*
+ * Bit-reflected CRC32 with a table per byte of a word: table[k][i] is the CRC of
+ * byte i followed by k zero bytes. With CONFIG_CRC_TABLE_SLICE_BY_8, 8 bytes
+ * are processed at a time.
+ */
+static inline uint32_t crc32_table_update(const uint32_t (*table)[256], uint32_t crc,
+					  const uint8_t *data, size_t len)
+{
+#ifdef CONFIG_CRC_TABLE_SLICE_BY_8
+	for (; len >= 8; len -= 8, data += 8) {
+		uint32_t lo = sys_get_le32(data) ^ crc;
+		uint32_t hi = sys_get_le32(&data[4]);
+
+		crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+		      table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+		      table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^
+		      table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+	}
+#endif
+
+	for (size_t i = 0; i < len; i++) {
+		crc = (crc >> 8) ^ table[0][(crc ^ data[i]) & 0xff];
+	}
+
+	return crc;
+}
+
+/*
+ * CRC instructions, processing the start of the data with the CRC not
+ * inverted. They return the number of bytes processed, the rest being left to
+ * the tables.
+ */
+size_t z_crc32_ieee_hw(uint32_t *crc, const uint8_t *data, size_t len);
+size_t z_crc32_c_hw(uint32_t *crc, const uint8_t *data, size_t len);
+
+#endif /* ZEPHYR_LIB_CRC_CRC_INTERNAL_H_ */
@@ -78,8 +78,10 @@ static int sys_hashmap_cxx_insert(struct sys_hashmap *map, uint64_t key, uint64_
 	}
 
 	auto it = umap->find(key);
-	if (it != umap->end() && old_value != nullptr) {
-		*old_value = it->second;
+	if (it != umap->end()) {
+		if (old_value != nullptr) {
+			*old_value = it->second;
+		}
 		it->second = value;
 		return 0;
 	}
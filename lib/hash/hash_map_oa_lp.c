@@ -34,15 +34,13 @@ BUILD_ASSERT(offsetof(struct sys_hashmap_oa_lp_data, n_buckets) ==
 BUILD_ASSERT(offsetof(struct sys_hashmap_oa_lp_data, size) ==
 	     offsetof(struct sys_hashmap_data, size));
 
-static struct oalp_entry *sys_hashmap_oa_lp_find(const struct sys_hashmap *map, uint64_t key,
-						 bool used_ok, bool unused_ok, bool tombstone_ok)
+static struct oalp_entry *sys_hashmap_oa_lp_find_in(struct oalp_entry *buckets, size_t n_buckets,
+						    size_t start, uint64_t key, bool used_ok,
+						    bool unused_ok, bool tombstone_ok)
 {
 	struct oalp_entry *entry = NULL;
-	const size_t n_buckets = map->data->n_buckets;
-	uint32_t hash = map->hash_func(&key, sizeof(key));
-	struct oalp_entry *const buckets = map->data->buckets;
 
-	for (size_t i = 0, j = hash; i < n_buckets; ++i, ++j) {
+	for (size_t i = 0, j = start; i < n_buckets; ++i, ++j) {
 		j &= (n_buckets - 1);
 		__ASSERT_NO_MSG(j < n_buckets);
 
@@ -73,6 +71,42 @@ static struct oalp_entry *sys_hashmap_oa_lp_find(const struct sys_hashmap *map,
 	return NULL;
 }
 
+static struct oalp_entry *sys_hashmap_oa_lp_find(const struct sys_hashmap *map, uint64_t key,
+						 bool used_ok, bool unused_ok, bool tombstone_ok)
+{
+	uint32_t hash = map->hash_func(&key, sizeof(key));
+
+	return sys_hashmap_oa_lp_find_in(map->data->buckets, map->data->n_buckets, hash, key,
+					 used_ok, unused_ok, tombstone_ok);
+}
+
+/*
+ * Find a key in the old table, if any. The buckets below old_pos were migrated and left as
+ * tombstones, so that the probe sequences of the other entries remain, and the keys probed
+ * from there are found by starting at old_pos.
+ */
+static struct oalp_entry *sys_hashmap_oa_lp_find_old(const struct sys_hashmap *map, uint64_t key)
+{
+	struct oalp_entry *entry;
+	size_t start;
+	struct sys_hashmap_oa_lp_data *data = (struct sys_hashmap_oa_lp_data *)map->data;
+
+	if (data->old_buckets == NULL) {
+		return NULL;
+	}
+
+	start = map->hash_func(&key, sizeof(key)) & (data->old_n_buckets - 1);
+	start = MAX(start, data->old_pos);
+
+	entry = sys_hashmap_oa_lp_find_in(data->old_buckets, data->old_n_buckets, start, key, true,
+					  true, false);
+	if (entry == NULL || entry->state != USED) {
+		return NULL;
+	}
+
+	return entry;
+}
+
 static int sys_hashmap_oa_lp_insert_no_rehash(struct sys_hashmap *map, uint64_t key, uint64_t value,
 					      uint64_t *old_value)
 {
@@ -80,7 +114,11 @@ static int sys_hashmap_oa_lp_insert_no_rehash(struct sys_hashmap *map, uint64_t
 	struct oalp_entry *entry = NULL;
 	struct sys_hashmap_oa_lp_data *data = (struct sys_hashmap_oa_lp_data *)map->data;
 
-	entry = sys_hashmap_oa_lp_find(map, key, true, true, true);
+	/* the key may be after a tombstone, which is only reused for a new key */
+	entry = sys_hashmap_oa_lp_find(map, key, true, true, false);
+	if (entry == NULL || entry->state != USED) {
+		entry = sys_hashmap_oa_lp_find(map, key, false, true, true);
+	}
 	__ASSERT_NO_MSG(entry != NULL);
 
 	switch (entry->state) {
@@ -91,7 +129,7 @@ static int sys_hashmap_oa_lp_insert_no_rehash(struct sys_hashmap *map, uint64_t
 	case TOMBSTONE:
 		--data->n_tombstones;
 		++data->size;
-		ret = 0;
+		ret = 1;
 		break;
 	case USED:
 	default:
@@ -110,6 +148,101 @@ static int sys_hashmap_oa_lp_insert_no_rehash(struct sys_hashmap *map, uint64_t
 	return ret;
 }
 
+static void sys_hashmap_oa_lp_free_old(struct sys_hashmap *map)
+{
+	struct sys_hashmap_oa_lp_data *data = (struct sys_hashmap_oa_lp_data *)map->data;
+
+	if (data->old_buckets != NULL) {
+		map->alloc_func(data->old_buckets, 0);
+	}
+
+	data->old_buckets = NULL;
+	data->old_n_buckets = 0;
+	data->old_pos = 0;
+}
+
+/*
+ * Migrate at most n_steps buckets of the old table, if any. Migrated entries are
+ * left as tombstones in the old table.
+ */
+static void sys_hashmap_oa_lp_migrate(struct sys_hashmap *map, size_t n_steps)
+{
+	struct oalp_entry *entry;
+	struct oalp_entry *new_entry;
+	struct sys_hashmap_oa_lp_data *data = (struct sys_hashmap_oa_lp_data *)map->data;
+	struct oalp_entry *const old_buckets = data->old_buckets;
+
+	if (old_buckets == NULL) {
+		return;
+	}
+
+	for (; n_steps > 0 && data->old_pos < data->old_n_buckets; --n_steps) {
+		entry = &old_buckets[data->old_pos++];
+		if (entry->state != USED) {
+			continue;
+		}
+
+		/* the key is not in the current table, take the first bucket available */
+		new_entry = sys_hashmap_oa_lp_find(map, entry->key, false, true, true);
+		__ASSERT_NO_MSG(new_entry != NULL);
+
+		if (new_entry->state == TOMBSTONE) {
+			--data->n_tombstones;
+		}
+
+		*new_entry = *entry;
+		entry->state = TOMBSTONE;
+	}
+
+	if (data->old_pos == data->old_n_buckets) {
+		sys_hashmap_oa_lp_free_old(map);
+	}
+}
+
+/*
+ * Switch to a new table, the current one being migrated to it by the following
+ * insertions and removals.
+ */
+static int sys_hashmap_oa_lp_resize(struct sys_hashmap *map, bool grow, size_t new_n_buckets)
+{
+	struct oalp_entry *new_buckets;
+	struct sys_hashmap_oa_lp_data *data = (struct sys_hashmap_oa_lp_data *)map->data;
+
+	/* do not shrink back right away, only once half as loaded as when growing */
+	if (!grow && new_n_buckets != 0 &&
+	    data->size * 200 / new_n_buckets > map->config->load_factor) {
+		return 0;
+	}
+
+	new_buckets = (struct oalp_entry *)map->alloc_func(NULL,
+							   new_n_buckets * sizeof(*new_buckets));
+	if (new_buckets == NULL && new_n_buckets != 0) {
+		return -ENOMEM;
+	}
+
+	if (new_buckets != NULL) {
+		/* ensure all buckets are empty / initialized */
+		memset(new_buckets, 0, new_n_buckets * sizeof(*new_buckets));
+	}
+
+	/* a previous migration is rarely still in progress, complete it first */
+	sys_hashmap_oa_lp_migrate(map, SIZE_MAX);
+
+	data->old_buckets = data->buckets;
+	data->old_n_buckets = data->n_buckets;
+	data->old_pos = 0;
+	data->buckets = new_buckets;
+	data->n_buckets = new_n_buckets;
+	data->n_tombstones = 0;
+
+	if (data->size == 0) {
+		/* no entry to migrate */
+		sys_hashmap_oa_lp_free_old(map);
+	}
+
+	return 0;
+}
+
 static int sys_hashmap_oa_lp_rehash(struct sys_hashmap *map, bool grow)
 {
 	size_t old_size;
@@ -128,6 +261,10 @@ static int sys_hashmap_oa_lp_rehash(struct sys_hashmap *map, bool grow)
 		return -ENOSPC;
 	}
 
+	if (IS_ENABLED(CONFIG_SYS_HASH_MAP_INCREMENTAL_REHASH)) {
+		return sys_hashmap_oa_lp_resize(map, grow, new_n_buckets);
+	}
+
 	/* extract all entries from the hashmap */
 	old_size = data->size;
 	old_n_buckets = data->n_buckets;
@@ -168,22 +305,25 @@ static void sys_hashmap_oa_lp_iter_next(struct sys_hashmap_iterator *it)
 	size_t i;
 	struct oalp_entry *entry;
 	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
-	struct oalp_entry *buckets = map->data->buckets;
+	struct sys_hashmap_oa_lp_data *data = (struct sys_hashmap_oa_lp_data *)map->data;
+	const size_t n_buckets = data->n_buckets + data->old_n_buckets;
 
 	__ASSERT(it->size == map->data->size, "Concurrent modification!");
 	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
 
-	if (it->pos == 0) {
-		it->state = buckets;
-	}
+	i = (uintptr_t)it->state;
+	__ASSERT(i < n_buckets, "Invalid iterator state %p", it->state);
 
-	i = (struct oalp_entry *)it->state - buckets;
-	__ASSERT(i < map->data->n_buckets, "Invalid iterator state %p", it->state);
+	/* the buckets of the table, then those of the old one if it is being migrated */
+	for (; i < n_buckets; ++i) {
+		if (i < data->n_buckets) {
+			entry = &((struct oalp_entry *)data->buckets)[i];
+		} else {
+			entry = &((struct oalp_entry *)data->old_buckets)[i - data->n_buckets];
+		}
 
-	for (; i < map->data->n_buckets; ++i) {
-		entry = &buckets[i];
 		if (entry->state == USED) {
-			it->state = &buckets[i + 1];
+			it->state = (void *)(uintptr_t)(i + 1);
 			it->key = entry->key;
 			it->value = entry->value;
 			++it->pos;
@@ -202,6 +342,7 @@ static void sys_hashmap_oa_lp_iter(const struct sys_hashmap *map, struct sys_has
 {
 	it->map = map;
 	it->next = sys_hashmap_oa_lp_iter_next;
+	it->state = (void *)(uintptr_t)0;
 	it->pos = 0;
 	*((size_t *)&it->size) = map->data->size;
 }
@@ -210,8 +351,12 @@ static void sys_hashmap_oa_lp_clear(struct sys_hashmap *map, sys_hashmap_callbac
 				    void *cookie)
 {
 	struct oalp_entry *entry;
+	struct oalp_entry *buckets;
 	struct sys_hashmap_oa_lp_data *data = (struct sys_hashmap_oa_lp_data *)map->data;
-	struct oalp_entry *buckets = data->buckets;
+
+	/* gather the entries of both tables */
+	sys_hashmap_oa_lp_migrate(map, SIZE_MAX);
+	buckets = data->buckets;
 
 	for (size_t i = 0, j = 0; cb != NULL && i < data->n_buckets && j < data->size; ++i) {
 		entry = &buckets[i];
@@ -235,12 +380,26 @@ static inline int sys_hashmap_oa_lp_insert(struct sys_hashmap *map, uint64_t key
 					   uint64_t *old_value)
 {
 	int ret;
+	struct oalp_entry *entry;
+
+	sys_hashmap_oa_lp_migrate(map, CONFIG_SYS_HASH_MAP_REHASH_BUCKETS);
 
 	ret = sys_hashmap_oa_lp_rehash(map, true);
 	if (ret < 0) {
 		return ret;
 	}
 
+	/* the key may not have been migrated yet */
+	entry = sys_hashmap_oa_lp_find_old(map, key);
+	if (entry != NULL) {
+		if (old_value != NULL) {
+			*old_value = entry->value;
+		}
+
+		entry->value = value;
+		return 0;
+	}
+
 	return sys_hashmap_oa_lp_insert_no_rehash(map, key, value, old_value);
 }
 
@@ -249,9 +408,17 @@ static bool sys_hashmap_oa_lp_remove(struct sys_hashmap *map, uint64_t key, uint
 	struct oalp_entry *entry;
 	struct sys_hashmap_oa_lp_data *data = (struct sys_hashmap_oa_lp_data *)map->data;
 
-	entry = sys_hashmap_oa_lp_find(map, key, true, true, false);
-	if (entry == NULL || entry->state == UNUSED) {
-		return false;
+	sys_hashmap_oa_lp_migrate(map, CONFIG_SYS_HASH_MAP_REHASH_BUCKETS);
+
+	entry = sys_hashmap_oa_lp_find_old(map, key);
+	if (entry == NULL) {
+		entry = sys_hashmap_oa_lp_find(map, key, true, true, false);
+		if (entry == NULL || entry->state == UNUSED) {
+			return false;
+		}
+
+		/* only the tombstones of the current table count towards its load */
+		++data->n_tombstones;
 	}
 
 	if (value != NULL) {
@@ -260,7 +427,6 @@ static bool sys_hashmap_oa_lp_remove(struct sys_hashmap *map, uint64_t key, uint
 
 	entry->state = TOMBSTONE;
 	--data->size;
-	++data->n_tombstones;
 
 	/* ignore a possible -ENOMEM since the table will remain intact */
 	(void)sys_hashmap_oa_lp_rehash(map, false);
@@ -272,7 +438,11 @@ static bool sys_hashmap_oa_lp_get(const struct sys_hashmap *map, uint64_t key, u
 {
 	struct oalp_entry *entry;
 
-	entry = sys_hashmap_oa_lp_find(map, key, true, true, false);
+	entry = sys_hashmap_oa_lp_find_old(map, key);
+	if (entry == NULL) {
+		entry = sys_hashmap_oa_lp_find(map, key, true, true, false);
+	}
+
 	if (entry == NULL || entry->state == UNUSED) {
 		return false;
 	}
@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_oa_rh.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Robin Hood hashing: an entry is placed before any entry further from its
+ * own bucket, which keeps probe sequences short and lets a lookup stop as soon
+ * as it passes the distance of the entry at hand. Entries are removed by
+ * shifting the following ones back, so that there are no tombstones.
+ *
+ * When the table is resized, the entries are not all moved at once. The old
+ * table is kept and a few of its buckets are migrated to the new one with each
+ * insertion or removal. Lookups check both tables meanwhile.
+ */
+
+struct oarh_entry {
+	uint64_t key;
+	uint64_t value;
+	/* kept for migrating the entry, it fits in the padding anyway */
+	uint32_t hash;
+	/* distance from the bucket of the key plus one, zero if unused */
+	uint32_t dist;
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_oa_rh_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
+static struct oarh_entry *sys_hashmap_oa_rh_find(struct oarh_entry *buckets, size_t n_buckets,
+						 uint32_t hash, uint64_t key)
+{
+	struct oarh_entry *entry;
+
+	for (size_t i = 0, j = hash; i < n_buckets; ++i, ++j) {
+		j &= (n_buckets - 1);
+		entry = &buckets[j];
+
+		/* the key would have been placed before this entry */
+		if (entry->dist <= i) {
+			break;
+		}
+
+		if (entry->key == key) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void sys_hashmap_oa_rh_place(struct oarh_entry *buckets, size_t n_buckets, uint32_t hash,
+				    uint64_t key, uint64_t value)
+{
+	struct oarh_entry tmp;
+	struct oarh_entry cur = {
+		.key = key,
+		.value = value,
+		.hash = hash,
+		.dist = 1,
+	};
+
+	for (size_t i = 0, j = hash; i < n_buckets; ++i, ++j, ++cur.dist) {
+		j &= (n_buckets - 1);
+
+		if (buckets[j].dist == 0) {
+			buckets[j] = cur;
+			return;
+		}
+
+		/* take the bucket of an entry closer to its own */
+		if (buckets[j].dist < cur.dist) {
+			tmp = buckets[j];
+			buckets[j] = cur;
+			cur = tmp;
+		}
+	}
+
+	__ASSERT(false, "No unused bucket. Memory has been corrupted");
+}
+
+static void sys_hashmap_oa_rh_erase(struct oarh_entry *buckets, size_t n_buckets,
+				    struct oarh_entry *entry)
+{
+	size_t j = entry - buckets;
+	struct oarh_entry *next;
+
+	/* shift back the following entries which are not in their own bucket */
+	for (size_t i = 0; i < n_buckets; ++i) {
+		next = &buckets[(j + 1) & (n_buckets - 1)];
+		if (next->dist <= 1) {
+			break;
+		}
+
+		buckets[j] = *next;
+		--buckets[j].dist;
+		j = next - buckets;
+	}
+
+	buckets[j].dist = 0;
+}
+
+static void sys_hashmap_oa_rh_free_old(struct sys_hashmap *map)
+{
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	if (data->old_buckets != NULL) {
+		map->alloc_func(data->old_buckets, 0);
+	}
+
+	data->old_buckets = NULL;
+	data->old_n_buckets = 0;
+	data->old_pos = 0;
+}
+
+/*
+ * Migrate at most n_steps buckets of the old table. A bucket is only passed
+ * once it is unused, i.e. once the entries shifted back into it have also been
+ * migrated, so that all the entries left have their own bucket after it.
+ */
+static void sys_hashmap_oa_rh_migrate(struct sys_hashmap *map, size_t n_steps)
+{
+	struct oarh_entry *entry;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	struct oarh_entry *const old_buckets = data->old_buckets;
+
+	if (old_buckets == NULL) {
+		return;
+	}
+
+	for (; n_steps > 0 && data->old_pos < data->old_n_buckets; --n_steps) {
+		entry = &old_buckets[data->old_pos];
+		if (entry->dist == 0) {
+			++data->old_pos;
+			continue;
+		}
+
+		sys_hashmap_oa_rh_place(data->buckets, data->n_buckets, entry->hash, entry->key,
+					entry->value);
+		sys_hashmap_oa_rh_erase(old_buckets, data->old_n_buckets, entry);
+	}
+
+	if (data->old_pos == data->old_n_buckets) {
+		sys_hashmap_oa_rh_free_old(map);
+	}
+}
+
+static struct oarh_entry *sys_hashmap_oa_rh_lookup(const struct sys_hashmap *map, uint64_t key,
+						   struct oarh_entry **buckets, size_t *n_buckets)
+{
+	struct oarh_entry *entry;
+	uint32_t hash = map->hash_func(&key, sizeof(key));
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	/* entries of the old table are still there if their bucket was not migrated yet */
+	if (data->old_buckets != NULL && (hash & (data->old_n_buckets - 1)) >= data->old_pos) {
+		*buckets = data->old_buckets;
+		*n_buckets = data->old_n_buckets;
+		entry = sys_hashmap_oa_rh_find(*buckets, *n_buckets, hash, key);
+		if (entry != NULL) {
+			return entry;
+		}
+	}
+
+	*buckets = data->buckets;
+	*n_buckets = data->n_buckets;
+
+	return sys_hashmap_oa_rh_find(*buckets, *n_buckets, hash, key);
+}
+
+static int sys_hashmap_oa_rh_resize(struct sys_hashmap *map, bool grow)
+{
+	size_t new_n_buckets = 0;
+	struct oarh_entry *new_buckets;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	if (!sys_hashmap_should_rehash(map, grow, 0, &new_n_buckets)) {
+		return 0;
+	}
+
+	/* do not shrink back right after growing, only once half as loaded */
+	if (!grow && new_n_buckets != 0 &&
+	    data->size * 200 / new_n_buckets > map->config->load_factor) {
+		return 0;
+	}
+
+	if (new_n_buckets == 0) {
+		/* empty, so both tables are unused */
+		sys_hashmap_oa_rh_free_old(map);
+		map->alloc_func(data->buckets, 0);
+		data->buckets = NULL;
+		data->n_buckets = 0;
+		return 0;
+	}
+
+	new_buckets = (struct oarh_entry *)map->alloc_func(NULL,
+							   new_n_buckets * sizeof(*new_buckets));
+	if (new_buckets == NULL) {
+		return -ENOMEM;
+	}
+
+	/* ensure all buckets are unused */
+	memset(new_buckets, 0, new_n_buckets * sizeof(*new_buckets));
+
+	/* only the last table is migrated incrementally, which is rarely still the case */
+	sys_hashmap_oa_rh_migrate(map, SIZE_MAX);
+
+	data->old_buckets = data->buckets;
+	data->old_n_buckets = data->n_buckets;
+	data->old_pos = 0;
+	data->buckets = new_buckets;
+	data->n_buckets = new_n_buckets;
+
+	if (data->old_buckets == NULL) {
+		data->old_n_buckets = 0;
+	}
+
+	return 0;
+}
+
+static void sys_hashmap_oa_rh_iter_next(struct sys_hashmap_iterator *it)
+{
+	struct oarh_entry *entry;
+	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+	size_t i = (uintptr_t)it->state;
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	/* the buckets of the new table, then those of the old one */
+	for (; i < data->n_buckets + data->old_n_buckets; ++i) {
+		if (i < data->n_buckets) {
+			entry = &((struct oarh_entry *)data->buckets)[i];
+		} else {
+			entry = &((struct oarh_entry *)data->old_buckets)[i - data->n_buckets];
+		}
+
+		if (entry->dist != 0) {
+			it->state = (void *)(uintptr_t)(i + 1);
+			it->key = entry->key;
+			it->value = entry->value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Open Addressing / Robin Hood Hashmap API
+ */
+
+static void sys_hashmap_oa_rh_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_oa_rh_iter_next;
+	it->state = NULL;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_oa_rh_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+				    void *cookie)
+{
+	struct sys_hashmap_iterator it = {0};
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	for (sys_hashmap_oa_rh_iter(map, &it); cb != NULL && sys_hashmap_iterator_has_next(&it);) {
+		it.next(&it);
+		cb(it.key, it.value, cookie);
+	}
+
+	sys_hashmap_oa_rh_free_old(map);
+
+	if (data->buckets != NULL) {
+		map->alloc_func(data->buckets, 0);
+		data->buckets = NULL;
+	}
+
+	data->n_buckets = 0;
+	data->size = 0;
+}
+
+static int sys_hashmap_oa_rh_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint64_t *old_value)
+{
+	int ret;
+	size_t n_buckets;
+	struct oarh_entry *entry;
+	struct oarh_entry *buckets;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	sys_hashmap_oa_rh_migrate(map, CONFIG_SYS_HASH_MAP_REHASH_BUCKETS);
+
+	entry = sys_hashmap_oa_rh_lookup(map, key, &buckets, &n_buckets);
+	if (entry != NULL) {
+		if (old_value != NULL) {
+			*old_value = entry->value;
+		}
+
+		entry->value = value;
+		return 0;
+	}
+
+	if (data->size == map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	ret = sys_hashmap_oa_rh_resize(map, true);
+	if (ret < 0) {
+		return ret;
+	}
+
+	sys_hashmap_oa_rh_place(data->buckets, data->n_buckets,
+				map->hash_func(&key, sizeof(key)), key, value);
+	++data->size;
+
+	return 1;
+}
+
+static bool sys_hashmap_oa_rh_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	size_t n_buckets;
+	struct oarh_entry *entry;
+	struct oarh_entry *buckets;
+	struct sys_hashmap_oa_rh_data *data = (struct sys_hashmap_oa_rh_data *)map->data;
+
+	sys_hashmap_oa_rh_migrate(map, CONFIG_SYS_HASH_MAP_REHASH_BUCKETS);
+
+	entry = sys_hashmap_oa_rh_lookup(map, key, &buckets, &n_buckets);
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	sys_hashmap_oa_rh_erase(buckets, n_buckets, entry);
+	--data->size;
+
+	/* ignore a possible -ENOMEM since the table will remain intact */
+	(void)sys_hashmap_oa_rh_resize(map, false);
+
+	return true;
+}
+
+static bool sys_hashmap_oa_rh_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	size_t n_buckets;
+	struct oarh_entry *entry;
+	struct oarh_entry *buckets;
+
+	entry = sys_hashmap_oa_rh_lookup(map, key, &buckets, &n_buckets);
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	return true;
+}
+
+const struct sys_hashmap_api sys_hashmap_oa_rh_api = {
+	.iter = sys_hashmap_oa_rh_iter,
+	.clear = sys_hashmap_oa_rh_clear,
+	.insert = sys_hashmap_oa_rh_insert,
+	.remove = sys_hashmap_oa_rh_remove,
+	.get = sys_hashmap_oa_rh_get,
+};
@@ -22,6 +22,13 @@ struct sys_hashmap_sc_entry {
 	sys_dnode_t node;
 };
 
+BUILD_ASSERT(offsetof(struct sys_hashmap_sc_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_sc_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_sc_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
 static void sys_hashmap_sc_entry_init(struct sys_hashmap_sc_entry *entry, uint64_t key,
 				      uint64_t value)
 {
@@ -36,7 +43,6 @@ static void sys_hashmap_sc_insert_entry(struct sys_hashmap *map, struct sys_hash
 	uint32_t hash = map->hash_func(&entry->key, sizeof(entry->key));
 
 	sys_dlist_append(&buckets[hash % map->data->n_buckets], &entry->node);
-	++map->data->size;
 }
 
 static void sys_hashmap_sc_insert_all(struct sys_hashmap *map, sys_dlist_t *list)
@@ -68,6 +74,82 @@ static void sys_hashmap_sc_to_list(struct sys_hashmap *map, sys_dlist_t *list)
 	}
 }
 
+static void sys_hashmap_sc_free_old(struct sys_hashmap *map)
+{
+	struct sys_hashmap_sc_data *data = (struct sys_hashmap_sc_data *)map->data;
+
+	if (data->old_buckets != NULL) {
+		map->alloc_func(data->old_buckets, 0);
+	}
+
+	data->old_buckets = NULL;
+	data->old_n_buckets = 0;
+	data->old_pos = 0;
+}
+
+/*
+ * Move the entries of at most n_steps buckets of the old table, if any, to the
+ * current one.
+ */
+static void sys_hashmap_sc_migrate(struct sys_hashmap *map, size_t n_steps)
+{
+	struct sys_hashmap_sc_data *data = (struct sys_hashmap_sc_data *)map->data;
+	sys_dlist_t *const old_buckets = data->old_buckets;
+
+	if (old_buckets == NULL) {
+		return;
+	}
+
+	for (; n_steps > 0 && data->old_pos < data->old_n_buckets; --n_steps) {
+		sys_hashmap_sc_insert_all(map, &old_buckets[data->old_pos++]);
+	}
+
+	if (data->old_pos == data->old_n_buckets) {
+		sys_hashmap_sc_free_old(map);
+	}
+}
+
+/*
+ * Allocate the new table and keep the current one, whose entries are then
+ * migrated with the following insertions and removals.
+ */
+static int sys_hashmap_sc_resize(struct sys_hashmap *map, bool grow, size_t new_n_buckets)
+{
+	sys_dlist_t *new_buckets;
+	struct sys_hashmap_sc_data *data = (struct sys_hashmap_sc_data *)map->data;
+
+	/* keep a table grown for an insertion until half of its entries are removed */
+	if (!grow && new_n_buckets != 0 &&
+	    data->size * 200 / new_n_buckets > map->config->load_factor) {
+		return 0;
+	}
+
+	new_buckets = (sys_dlist_t *)map->alloc_func(NULL, new_n_buckets * sizeof(*new_buckets));
+	if (new_buckets == NULL && new_n_buckets != 0) {
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i < new_n_buckets; ++i) {
+		sys_dlist_init(&new_buckets[i]);
+	}
+
+	/* a previous migration is rarely still in progress, complete it first */
+	sys_hashmap_sc_migrate(map, SIZE_MAX);
+
+	data->old_buckets = data->buckets;
+	data->old_n_buckets = data->n_buckets;
+	data->old_pos = 0;
+	data->buckets = new_buckets;
+	data->n_buckets = new_n_buckets;
+
+	if (data->size == 0) {
+		/* no entry to migrate */
+		sys_hashmap_sc_free_old(map);
+	}
+
+	return 0;
+}
+
 static int sys_hashmap_sc_rehash(struct sys_hashmap *map, bool grow)
 {
 	sys_dlist_t list;
@@ -79,6 +161,10 @@ static int sys_hashmap_sc_rehash(struct sys_hashmap *map, bool grow)
 		return 0;
 	}
 
+	if (IS_ENABLED(CONFIG_SYS_HASH_MAP_INCREMENTAL_REHASH)) {
+		return sys_hashmap_sc_resize(map, grow, new_n_buckets);
+	}
+
 	/* extract all entries from the hashmap */
 	sys_hashmap_sc_to_list(map, &list);
 
@@ -92,7 +178,6 @@ static int sys_hashmap_sc_rehash(struct sys_hashmap *map, bool grow)
 	}
 
 	/* ensure all buckets are empty / initialized */
-	map->data->size = 0;
 	map->data->buckets = new_buckets;
 	map->data->n_buckets = new_n_buckets;
 	for (size_t i = 0; i < new_n_buckets; ++i) {
@@ -106,50 +191,78 @@ static int sys_hashmap_sc_rehash(struct sys_hashmap *map, bool grow)
 	return 0;
 }
 
+static struct sys_hashmap_sc_entry *sys_hashmap_sc_find_in(sys_dlist_t *bucket, uint64_t key)
+{
+	struct sys_hashmap_sc_entry *entry;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(bucket, entry, node) {
+		if (entry->key == key) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
 static struct sys_hashmap_sc_entry *sys_hashmap_sc_find(const struct sys_hashmap *map, uint64_t key)
 {
 	uint32_t hash;
-	sys_dlist_t *bucket;
-	sys_dlist_t *buckets;
 	struct sys_hashmap_sc_entry *entry;
+	struct sys_hashmap_sc_data *data = (struct sys_hashmap_sc_data *)map->data;
 
-	if (map->data->n_buckets == 0) {
+	if (data->n_buckets == 0) {
 		return NULL;
 	}
 
-	__ASSERT_NO_MSG(map->data->size > 0);
+	__ASSERT_NO_MSG(data->size > 0);
 
 	hash = map->hash_func(&key, sizeof(key));
-	buckets = (sys_dlist_t *)map->data->buckets;
-	bucket = &buckets[hash % map->data->n_buckets];
 
-	SYS_DLIST_FOR_EACH_CONTAINER(bucket, entry, node) {
-		if (entry->key == key) {
+	/* the entry is still in the old table if its bucket was not migrated yet */
+	if (data->old_buckets != NULL && hash % data->old_n_buckets >= data->old_pos) {
+		entry = sys_hashmap_sc_find_in(
+			&((sys_dlist_t *)data->old_buckets)[hash % data->old_n_buckets], key);
+		if (entry != NULL) {
 			return entry;
 		}
 	}
 
-	return NULL;
+	return sys_hashmap_sc_find_in(&((sys_dlist_t *)data->buckets)[hash % data->n_buckets],
+				      key);
+}
+
+/* The buckets of the table, then those of the old one if it is being migrated */
+static sys_dlist_t *sys_hashmap_sc_bucket(const struct sys_hashmap *map, size_t i)
+{
+	struct sys_hashmap_sc_data *data = (struct sys_hashmap_sc_data *)map->data;
+
+	if (i < data->n_buckets) {
+		return &((sys_dlist_t *)data->buckets)[i];
+	}
+
+	return &((sys_dlist_t *)data->old_buckets)[i - data->n_buckets];
 }
 
 static void sys_hashmap_sc_iter_next(struct sys_hashmap_iterator *it)
 {
+	size_t i;
 	sys_dlist_t *bucket;
 	bool found_previous_key = false;
 	struct sys_hashmap_sc_entry *entry;
 	const struct sys_hashmap *map = it->map;
-	sys_dlist_t *buckets = map->data->buckets;
+	struct sys_hashmap_sc_data *data = (struct sys_hashmap_sc_data *)map->data;
 
 	__ASSERT(it->size == map->data->size, "Concurrent modification!");
 	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
 
 	if (it->pos == 0) {
-		/* at position 0, state equals the beginning of the bucket array */
-		it->state = buckets;
+		/* at position 0, state equals the first bucket */
+		it->state = (void *)(uintptr_t)0;
 		found_previous_key = true;
 	}
 
-	for (bucket = it->state; bucket < &buckets[map->data->n_buckets]; ++bucket) {
+	for (i = (uintptr_t)it->state; i < data->n_buckets + data->old_n_buckets; ++i) {
+		bucket = sys_hashmap_sc_bucket(map, i);
 		SYS_DLIST_FOR_EACH_CONTAINER(bucket, entry, node) {
 			if (!found_previous_key) {
 				if (entry->key == it->key) {
@@ -161,7 +274,7 @@ static void sys_hashmap_sc_iter_next(struct sys_hashmap_iterator *it)
 
 			/* save the bucket to state so we can restart scanning from a saved position
 			 */
-			it->state = bucket;
+			it->state = (void *)(uintptr_t)i;
 			it->key = entry->key;
 			it->value = entry->value;
 			++it->pos;
@@ -181,7 +294,7 @@ static void sys_hashmap_sc_iter(const struct sys_hashmap *map, struct sys_hashma
 {
 	it->map = map;
 	it->next = sys_hashmap_sc_iter_next;
-	it->state = map->data->buckets;
+	it->state = (void *)(uintptr_t)0;
 	it->key = 0;
 	it->value = 0;
 	it->pos = 0;
@@ -193,6 +306,8 @@ static void sys_hashmap_sc_clear(struct sys_hashmap *map, sys_hashmap_callback_t
 	sys_dlist_t list;
 	struct sys_hashmap_sc_entry *entry;
 
+	/* gather the entries of both tables */
+	sys_hashmap_sc_migrate(map, SIZE_MAX);
 	sys_hashmap_sc_to_list(map, &list);
 
 	/* free the buckets */
@@ -223,6 +338,8 @@ static int sys_hashmap_sc_insert(struct sys_hashmap *map, uint64_t key, uint64_t
 	int ret;
 	struct sys_hashmap_sc_entry *entry;
 
+	sys_hashmap_sc_migrate(map, CONFIG_SYS_HASH_MAP_REHASH_BUCKETS);
+
 	entry = sys_hashmap_sc_find(map, key);
 	if (entry != NULL) {
 		if (old_value != NULL) {
@@ -246,6 +363,7 @@ static int sys_hashmap_sc_insert(struct sys_hashmap *map, uint64_t key, uint64_t
 
 	sys_hashmap_sc_entry_init(entry, key, value);
 	sys_hashmap_sc_insert_entry(map, entry);
+	++map->data->size;
 
 	return 1;
 }
@@ -255,6 +373,8 @@ static bool sys_hashmap_sc_remove(struct sys_hashmap *map, uint64_t key, uint64_
 	__unused int ret;
 	struct sys_hashmap_sc_entry *entry;
 
+	sys_hashmap_sc_migrate(map, CONFIG_SYS_HASH_MAP_REHASH_BUCKETS);
+
 	entry = sys_hashmap_sc_find(map, key);
 	if (entry == NULL) {
 		return false;
@@ -268,8 +388,11 @@ static bool sys_hashmap_sc_remove(struct sys_hashmap *map, uint64_t key, uint64_
 	--map->data->size;
 
 	ret = sys_hashmap_sc_rehash(map, false);
-	/* Realloc to a smaller size of memory should *always* work */
-	__ASSERT_NO_MSG(ret >= 0);
+	/*
+	 * Realloc to a smaller size of memory should *always* work, allocating a new table may
+	 * not, in which case the current one remains
+	 */
+	__ASSERT_NO_MSG(ret >= 0 || IS_ENABLED(CONFIG_SYS_HASH_MAP_INCREMENTAL_REHASH));
 
 	/* free the entry */
 	map->alloc_func(entry, 0);
@@ -37,11 +37,11 @@ static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 
 	CHECK(!chunk_used(h, c));
 	CHECK(b->next != 0);
-	CHECK(h->avail_buckets & BIT(bidx));
+	CHECK(bucket_avail(h, bidx));
 
 	if (next_free_chunk(h, c) == c) {
 		/* this is the last chunk */
-		h->avail_buckets &= ~BIT(bidx);
+		clear_bucket_avail(h, bidx);
 		b->next = 0;
 	} else {
 		chunkid_t first = prev_free_chunk(h, c),
@@ -70,15 +70,15 @@ static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
 	if (b->next == 0U) {
-		CHECK((h->avail_buckets & BIT(bidx)) == 0);
+		CHECK(!bucket_avail(h, bidx));
 
 		/* Empty list, first item */
-		h->avail_buckets |= BIT(bidx);
+		set_bucket_avail(h, bidx);
 		b->next = c;
 		set_prev_free_chunk(h, c, c);
 		set_next_free_chunk(h, c, c);
 	} else {
-		CHECK(h->avail_buckets & BIT(bidx));
+		CHECK(bucket_avail(h, bidx));
 
 		/* Insert before (!) the "next" pointer */
 		chunkid_t second = b->next;
@@ -208,6 +208,59 @@ size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 	return chunk_sz - (addr - chunk_base);
 }
 
+#ifdef CONFIG_SYS_HEAP_ALLOC_TLSF
+static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+{
+	int bi = bucket_idx(h, sz);
+
+	CHECK(bi <= bucket_idx(h, h->end_chunk));
+
+	/* Start the search at the first bucket whose chunks are all
+	 * guaranteed to fit: the request's own bucket only if sz is
+	 * its lower bound, otherwise the next one up.  Then pick the
+	 * first non-empty bucket from there, first among the remaining
+	 * sublists of that size category and then in the smallest
+	 * larger category.  That's two find-first-set operations no
+	 * matter how fragmented the heap is.
+	 */
+	int gi = (bucket_min_size(h, bi) == sz) ? bi : bi + 1;
+	int fl = gi >> FREE_LIST_SL_BITS;
+	uint32_t slmask = h->avail_sublists[fl] &
+			  ~BIT_MASK(gi & (FREE_LIST_SL_COUNT - 1U));
+
+	if (slmask == 0U) {
+		uint32_t flmask = h->avail_buckets & ~BIT_MASK(fl + 1);
+
+		if (flmask != 0U) {
+			fl = __builtin_ctz(flmask);
+			slmask = h->avail_sublists[fl];
+		}
+	}
+
+	if (slmask != 0U) {
+		int minbucket = (fl << FREE_LIST_SL_BITS) | __builtin_ctz(slmask);
+		chunkid_t c = h->buckets[minbucket].next;
+
+		free_list_remove_bidx(h, c, minbucket);
+		CHECK(chunk_size(h, c) >= sz);
+		return c;
+	}
+
+	/* Nothing bigger: the head of the request's own bucket is the
+	 * last chunk that may still fit.
+	 */
+	if (gi != bi && bucket_avail(h, bi)) {
+		chunkid_t c = h->buckets[bi].next;
+
+		if (chunk_size(h, c) >= sz) {
+			free_list_remove_bidx(h, c, bi);
+			return c;
+		}
+	}
+
+	return 0;
+}
+#else
 static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 {
 	int bi = bucket_idx(h, sz);
@@ -259,6 +312,7 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 
 	return 0;
 }
+#endif /* CONFIG_SYS_HEAP_ALLOC_TLSF */
 
 void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 {
@@ -510,6 +564,9 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	heap->heap = h;
 	h->end_chunk = heap_sz;
 	h->avail_buckets = 0;
+#ifdef CONFIG_SYS_HEAP_ALLOC_TLSF
+	memset(h->avail_sublists, 0, sizeof(h->avail_sublists));
+#endif
 
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->free_bytes = 0;
@@ -41,9 +41,10 @@
  *   FREE_NEXT: Chunk ID of the next node in a free list.
  *
  * The free lists are circular lists, one for each power-of-two size
- * category.  The free list pointers exist only for free chunks,
- * obviously.  This memory is part of the user's buffer when
- * allocated.
+ * category (or, with CONFIG_SYS_HEAP_ALLOC_TLSF, one for each of the
+ * FREE_LIST_SL_COUNT equal subdivisions of such a category).  The
+ * free list pointers exist only for free chunks, obviously.  This
+ * memory is part of the user's buffer when allocated.
  *
  * The field order is so that allocated buffers are immediately bounded
  * by SIZE_AND_USED of the current chunk at the bottom, and LEFT_SIZE of
@@ -61,14 +62,33 @@ typedef struct { char bytes[CHUNK_UNIT]; } chunk_unit_t;
 typedef uint32_t chunkid_t;
 typedef uint32_t chunksz_t;
 
+/* Number of second-level free lists per power-of-two size category,
+ * as a power of two.  A single list per category gives the plain
+ * bounded first-fit allocator.
+ */
+#ifdef CONFIG_SYS_HEAP_ALLOC_TLSF
+#define FREE_LIST_SL_BITS 3
+#else
+#define FREE_LIST_SL_BITS 0
+#endif
+#define FREE_LIST_SL_COUNT (1U << FREE_LIST_SL_BITS)
+
 struct z_heap_bucket {
 	chunkid_t next;
 };
 
+/* With CONFIG_SYS_HEAP_ALLOC_TLSF the avail_buckets bitmask has one
+ * bit per power-of-two size category that has at least one non-empty
+ * bucket, and avail_sublists[] has one bit per bucket within each of
+ * those.  Otherwise avail_buckets has one bit per bucket.
+ */
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
 	uint32_t avail_buckets;
+#ifdef CONFIG_SYS_HEAP_ALLOC_TLSF
+	uint8_t avail_sublists[32];
+#endif
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	size_t free_bytes;
 	size_t allocated_bytes;
@@ -250,7 +270,71 @@ static inline size_t chunksz_to_bytes(struct z_heap *h, chunksz_t chunksz_in)
 static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 {
 	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
-	return 31 - __builtin_clz(usable_sz);
+	int fl = 31 - __builtin_clz(usable_sz);
+	unsigned int sl;
+
+	/* Second level: the FREE_LIST_SL_BITS bits following the top
+	 * one.  Categories smaller than FREE_LIST_SL_COUNT units get
+	 * one (sparse) bucket per exact size.
+	 */
+	if (fl >= FREE_LIST_SL_BITS) {
+		sl = usable_sz >> (fl - FREE_LIST_SL_BITS);
+	} else {
+		sl = usable_sz << (FREE_LIST_SL_BITS - fl);
+	}
+
+	return (fl << FREE_LIST_SL_BITS) | (sl & (FREE_LIST_SL_COUNT - 1U));
+}
+
+/* Smallest chunk size that may be found in the given bucket */
+static inline chunksz_t bucket_min_size(struct z_heap *h, int bidx)
+{
+	int fl = bidx >> FREE_LIST_SL_BITS;
+	unsigned int sl = FREE_LIST_SL_COUNT | (bidx & (FREE_LIST_SL_COUNT - 1U));
+	unsigned int usable_sz;
+
+	if (fl >= FREE_LIST_SL_BITS) {
+		usable_sz = sl << (fl - FREE_LIST_SL_BITS);
+	} else {
+		usable_sz = sl >> (FREE_LIST_SL_BITS - fl);
+	}
+
+	return usable_sz - 1U + min_chunk_size(h);
+}
+
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+#ifdef CONFIG_SYS_HEAP_ALLOC_TLSF
+	return (h->avail_sublists[bidx >> FREE_LIST_SL_BITS] &
+		BIT(bidx & (FREE_LIST_SL_COUNT - 1U))) != 0U;
+#else
+	return (h->avail_buckets & BIT(bidx)) != 0U;
+#endif
+}
+
+static inline void set_bucket_avail(struct z_heap *h, int bidx)
+{
+#ifdef CONFIG_SYS_HEAP_ALLOC_TLSF
+	h->avail_sublists[bidx >> FREE_LIST_SL_BITS] |=
+		BIT(bidx & (FREE_LIST_SL_COUNT - 1U));
+	h->avail_buckets |= BIT(bidx >> FREE_LIST_SL_BITS);
+#else
+	h->avail_buckets |= BIT(bidx);
+#endif
+}
+
+static inline void clear_bucket_avail(struct z_heap *h, int bidx)
+{
+#ifdef CONFIG_SYS_HEAP_ALLOC_TLSF
+	int fl = bidx >> FREE_LIST_SL_BITS;
+
+	h->avail_sublists[fl] &= ~BIT(bidx & (FREE_LIST_SL_COUNT - 1U));
+	if (h->avail_sublists[fl] == 0U) {
+		h->avail_buckets &= ~BIT(fl);
+	}
+#else
+	h->avail_buckets &= ~BIT(bidx);
+#endif
 }
 
 static inline bool size_too_big(struct z_heap *h, size_t bytes)
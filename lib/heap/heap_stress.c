@@ -6,6 +6,7 @@
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/kernel.h>
+#include <string.h>
 #include "heap.h"
 
 struct z_heap_stress_rec {
@@ -25,6 +26,56 @@ struct z_heap_stress_block {
 	size_t sz;
 };
 
+/* Log-linear histogram of operation cycle counts: four bins per
+ * power of two, exact below 8 cycles.
+ */
+#define CYCLE_HIST_SUB_BITS 2
+#define CYCLE_HIST_BINS ((32 - CYCLE_HIST_SUB_BITS + 1) << CYCLE_HIST_SUB_BITS)
+
+static uint32_t alloc_hist[CYCLE_HIST_BINS];
+static uint32_t free_hist[CYCLE_HIST_BINS];
+
+static int cycle_bin(uint32_t cycles)
+{
+	if (cycles < BIT(CYCLE_HIST_SUB_BITS + 1)) {
+		return cycles;
+	}
+
+	int top = 31 - __builtin_clz(cycles);
+	int sub = (cycles >> (top - CYCLE_HIST_SUB_BITS)) &
+		  BIT_MASK(CYCLE_HIST_SUB_BITS);
+
+	return ((top - CYCLE_HIST_SUB_BITS + 1) << CYCLE_HIST_SUB_BITS) | sub;
+}
+
+/* Largest cycle count falling in a bin */
+static uint32_t cycle_bin_max(int bin)
+{
+	if (bin < BIT(CYCLE_HIST_SUB_BITS + 1)) {
+		return bin;
+	}
+
+	int shift = (bin >> CYCLE_HIST_SUB_BITS) - 1;
+	uint64_t base = BIT(CYCLE_HIST_SUB_BITS) | (bin & BIT_MASK(CYCLE_HIST_SUB_BITS));
+
+	return (uint32_t)(((base + 1) << shift) - 1);
+}
+
+static uint32_t cycle_p99(uint32_t *hist, uint32_t count, uint32_t max)
+{
+	uint32_t rank = count - count / 100;
+	uint32_t n = 0;
+
+	for (int bin = 0; bin < CYCLE_HIST_BINS; bin++) {
+		n += hist[bin];
+		if (n >= rank && n != 0) {
+			return MIN(cycle_bin_max(bin), max);
+		}
+	}
+
+	return max;
+}
+
 /* Very simple LCRNG (from https://nuclear.llnl.gov/CNP/rng/rngman/node4.html)
  *
  * Here to guarantee cross-platform test repeatability.
@@ -123,12 +174,21 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 	};
 
 	*result = (struct z_heap_stress_result) {0};
+	memset(alloc_hist, 0, sizeof(alloc_hist));
+	memset(free_hist, 0, sizeof(free_hist));
 
 	for (uint32_t i = 0; i < op_count; i++) {
+		uint32_t t0, dt;
+
 		if (rand_alloc_choice(&sr)) {
 			size_t sz = rand_alloc_size(&sr);
+
+			t0 = k_cycle_get_32();
 			void *p = sr.alloc_fn(sr.arg, sz);
+			dt = k_cycle_get_32() - t0;
 
+			alloc_hist[cycle_bin(dt)]++;
+			result->alloc_cycles_max = MAX(result->alloc_cycles_max, dt);
 			result->total_allocs++;
 			if (p != NULL) {
 				result->successful_allocs++;
@@ -146,8 +206,19 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 			sr.blocks[b] = sr.blocks[sr.blocks_alloced - 1];
 			sr.blocks_alloced--;
 			sr.bytes_alloced -= sz;
+
+			t0 = k_cycle_get_32();
 			sr.free_fn(sr.arg, p);
+			dt = k_cycle_get_32() - t0;
+
+			free_hist[cycle_bin(dt)]++;
+			result->free_cycles_max = MAX(result->free_cycles_max, dt);
 		}
 		result->accumulated_in_use_bytes += sr.bytes_alloced;
 	}
+
+	result->alloc_cycles_p99 = cycle_p99(alloc_hist, result->total_allocs,
+					     result->alloc_cycles_max);
+	result->free_cycles_p99 = cycle_p99(free_hist, result->total_frees,
+					    result->free_cycles_max);
 }
@@ -56,7 +56,7 @@ static inline void check_nexts(struct z_heap *h, int bidx)
 {
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
-	bool emptybit = (h->avail_buckets & BIT(bidx)) == 0;
+	bool emptybit = !bucket_avail(h, bidx);
 	bool emptylist = b->next == 0;
 	bool empties_match = emptybit == emptylist;
 
@@ -118,10 +118,13 @@ bool sys_heap_validate(struct sys_heap *heap)
 			if (!valid_chunk(h, c)) {
 				return false;
 			}
+			if (bucket_idx(h, chunk_size(h, c)) != b) {
+				return false;
+			}
 			set_chunk_used(h, c, true);
 		}
 
-		bool empty = (h->avail_buckets & BIT(b)) == 0;
+		bool empty = !bucket_avail(h, b);
 		bool zero = n == 0;
 
 		if (empty != zero) {
@@ -133,6 +136,17 @@ bool sys_heap_validate(struct sys_heap *heap)
 		}
 	}
 
+#ifdef CONFIG_SYS_HEAP_ALLOC_TLSF
+	/* The first level bitmask summarizes the second level ones */
+	for (int fl = 0; fl < ARRAY_SIZE(h->avail_sublists); fl++) {
+		bool empty = (h->avail_buckets & BIT(fl)) == 0;
+
+		if (empty != (h->avail_sublists[fl] == 0)) {
+			return false;
+		}
+	}
+#endif
+
 	/*
 	 * Walk through the chunks linearly again, verifying that all chunks
 	 * but solo headers are now USED (i.e. all free blocks were found
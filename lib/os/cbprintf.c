@@ -23,6 +23,8 @@ int cbprintf(cbprintf_cb out, void *ctx, const char *format, ...)
 #if defined(CONFIG_CBPRINTF_LIBC_SUBSTS)
 
 #include <stdio.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
 
 /* Context for sn* variants is the next space in the buffer, and the buffer
  * end.
@@ -32,20 +34,23 @@ struct str_ctx {
 	char *const dpe;
 };
 
-static int str_out(int c,
+static int str_out(const char *buf,
+		   size_t len,
 		   void *ctx)
 {
 	struct str_ctx *scp = ctx;
+	size_t n = MIN(len, (size_t)(scp->dpe - scp->dp));
 
 	/* s*printf must return the number of characters that would be
 	 * output, even if they don't all fit, so conditionally store
 	 * and unconditionally succeed.
 	 */
-	if (scp->dp < scp->dpe) {
-		*(scp->dp++) = c;
+	if (n != 0) {
+		memcpy(scp->dp, buf, n);
+		scp->dp += n;
 	}
 
-	return c;
+	return (int)len;
 }
 
 int fprintfcb(FILE *stream, const char *format, ...)
@@ -100,7 +105,7 @@ int vsnprintfcb(char *str, size_t size, const char *format, va_list ap)
 		.dp = str,
 		.dpe = str + size,
 	};
-	int rv = cbvprintf(str_out, &ctx, format, ap);
+	int rv = cbvprintf_bulk(str_out, &ctx, format, ap);
 
 	if (ctx.dp < ctx.dpe) {
 		ctx.dp[0] = 0;
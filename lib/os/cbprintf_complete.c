@@ -792,18 +792,43 @@ static char *encode_uint(uint_value_type value,
 			 char *bps,
 			 const char *bpe)
 {
+	/* Decimal digits are converted two at a time. */
+	static const char digit_pairs[] =
+		"00010203040506070809101112131415161718192021222324"
+		"25262728293031323334353637383940414243444546474849"
+		"50515253545556575859606162636465666768697071727374"
+		"75767778798081828384858687888990919293949596979899";
 	bool upcase = isupper((int)conv->specifier) != 0;
 	const unsigned int radix = conversion_radix(conv->specifier);
+	const char *digits = upcase ? "0123456789ABCDEF" : "0123456789abcdef";
 	char *bp = bps + (bpe - bps);
 
-	do {
-		unsigned int lsv = (unsigned int)(value % radix);
+	if (radix == 10) {
+		/* Leave room for the last digit. */
+		while ((value >= 100U) && ((bp - bps) > 2)) {
+			unsigned int idx = 2U * (unsigned int)(value % 100U);
 
-		--bp;
-		*bp = (lsv <= 9) ? ('0' + lsv)
-			: upcase ? ('A' + lsv - 10) : ('a' + lsv - 10);
-		value /= radix;
-	} while ((value != 0) && (bps < bp));
+			bp -= 2;
+			bp[0] = digit_pairs[idx];
+			bp[1] = digit_pairs[idx + 1U];
+			value /= 100U;
+		}
+
+		do {
+			--bp;
+			*bp = (char)('0' + (unsigned int)(value % 10U));
+			value /= 10U;
+		} while ((value != 0) && (bps < bp));
+	} else {
+		/* Power of two radix, no division. */
+		const unsigned int shift = (radix == 16U) ? 4U : 3U;
+
+		do {
+			--bp;
+			*bp = digits[(unsigned int)value & (radix - 1U)];
+			value >>= shift;
+		} while ((value != 0) && (bps < bp));
+	}
 
 	/* Record required alternate forms.  This can be determined
 	 * from the radix without re-checking specifier.
@@ -1366,27 +1391,96 @@ static int outs(cbprintf_cb __out,
 	return (int)count;
 }
 
-int z_cbvprintf_impl(cbprintf_cb __out, void *ctx, const char *fp,
-		     va_list ap, uint32_t flags)
+/* Characters emitted one at a time for a bulk output callback, passed on
+ * when full or before a sequence is emitted. It is never left full, so
+ * that a character can always be stored.
+ */
+struct bulk_buf {
+	size_t len;
+	char data[32];
+};
+
+static int bulk_flush(cbprintf_bulk_cb out,
+		      void *ctx,
+		      struct bulk_buf *bbuf)
+{
+	int rc = 0;
+
+	if (bbuf->len != 0) {
+		rc = out(bbuf->data, bbuf->len, ctx);
+		bbuf->len = 0;
+	}
+
+	return rc;
+}
+
+/* Outline function to emit all characters in [sp, ep) with a bulk output
+ * callback. Short sequences are gathered in the buffer.
+ */
+static int outs_bulk(cbprintf_bulk_cb out,
+		     void *ctx,
+		     struct bulk_buf *bbuf,
+		     const char *sp,
+		     const char *ep)
+{
+	size_t len = (ep != NULL) ? (size_t)(ep - sp) : strlen(sp);
+	int rc;
+
+	if ((bbuf->len + len) < sizeof(bbuf->data)) {
+		memcpy(&bbuf->data[bbuf->len], sp, len);
+		bbuf->len += len;
+
+		return (int)len;
+	}
+
+	rc = bulk_flush(out, ctx, bbuf);
+	if ((rc >= 0) && (len != 0)) {
+		rc = out(sp, len, ctx);
+	}
+
+	return (rc < 0) ? rc : (int)len;
+}
+
+/* Formatter behind z_cbvprintf_impl() and z_cbvprintf_bulk_impl(), with
+ * either @p __out or @p bulk set.
+ */
+static int cbvprintf_common(cbprintf_cb __out, cbprintf_bulk_cb bulk,
+			    void *ctx, const char *fp, va_list ap,
+			    uint32_t flags)
 {
 	char buf[CONVERTED_BUFLEN];
 	size_t count = 0;
 	sint_value_type sint;
 	cbprintf_cb_local out = __out;
+	struct bulk_buf bbuf;
 
 	const bool tagged_ap = (flags & Z_CBVPRINTF_PROCESS_FLAG_TAGGED_ARGS)
 			       == Z_CBVPRINTF_PROCESS_FLAG_TAGGED_ARGS;
 
+	bbuf.len = 0;
+
 /* Output character, returning EOF if output failed, otherwise
  * updating count.
  *
  * NB: c is evaluated exactly once: side-effects are OK
  */
 #define OUTC(c) do { \
-	int rc = (*out)((int)(c), ctx); \
-	\
-	if (rc < 0) { \
-		return rc; \
+	if (bulk != NULL) { \
+		bbuf.data[bbuf.len] = (char)(c); \
+		++bbuf.len; \
+		if (bbuf.len == sizeof(bbuf.data)) { \
+			int rc = bulk_flush(bulk, ctx, &bbuf); \
+			\
+			if (rc < 0) { \
+				return rc; \
+			} \
+		} \
+	} else { \
+		int rc = (*out)((int)(c), ctx); \
+		\
+		if (rc < 0) { \
+			return rc; \
+		} \
 	} \
 	++count; \
 } while (false)
@@ -1396,7 +1490,8 @@ int z_cbvprintf_impl(cbprintf_cb __out, void *ctx, const char *fp,
  */
 
 #define OUTS(_sp, _ep) do { \
-	int rc = outs(out, ctx, (_sp), (_ep)); \
+	int rc = (bulk != NULL) ? outs_bulk(bulk, ctx, &bbuf, (_sp), (_ep)) \
+				: outs(out, ctx, (_sp), (_ep)); \
 	\
 	if (rc < 0) {	    \
 		return rc; \
@@ -1406,8 +1501,14 @@ int z_cbvprintf_impl(cbprintf_cb __out, void *ctx, const char *fp,
 
 	while (*fp != 0) {
 		if (*fp != '%') {
-			OUTC(*fp);
-			++fp;
+			/* Literal text up to the next conversion */
+			const char *ep = fp + 1;
+
+			while ((*ep != 0) && (*ep != '%')) {
+				++ep;
+			}
+			OUTS(fp, ep);
+			fp = ep;
 			continue;
 		}
 
@@ -1877,7 +1978,27 @@ int z_cbvprintf_impl(cbprintf_cb __out, void *ctx, const char *fp,
 		}
 	}
 
+	if (bulk != NULL) {
+		int rc = bulk_flush(bulk, ctx, &bbuf);
+
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
 	return count;
 #undef OUTS
 #undef OUTC
 }
+
+int z_cbvprintf_impl(cbprintf_cb __out, void *ctx, const char *fp,
+		     va_list ap, uint32_t flags)
+{
+	return cbvprintf_common(__out, NULL, ctx, fp, ap, flags);
+}
+
+int z_cbvprintf_bulk_impl(cbprintf_bulk_cb out, void *ctx, const char *fp,
+			  va_list ap, uint32_t flags)
+{
+	return cbvprintf_common(NULL, out, ctx, fp, ap, flags);
+}
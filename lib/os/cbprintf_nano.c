@@ -354,3 +354,58 @@ start:
 		goto start;
 	}
 }
+
+/* Characters are gathered for the bulk output callback, as this
+ * implementation only emits one character at a time.
+ */
+struct bulk_ctx {
+	cbprintf_bulk_cb out;
+	void *ctx;
+	size_t len;
+	char data[16];
+};
+
+static int bulk_flush(struct bulk_ctx *bctx)
+{
+	int rc = 0;
+
+	if (bctx->len != 0) {
+		rc = bctx->out(bctx->data, bctx->len, bctx->ctx);
+		bctx->len = 0;
+	}
+
+	return rc;
+}
+
+static int bulk_char_out(int c, void *ctx)
+{
+	struct bulk_ctx *bctx = ctx;
+
+	bctx->data[bctx->len++] = (char)c;
+	if (bctx->len == sizeof(bctx->data)) {
+		int rc = bulk_flush(bctx);
+
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return c;
+}
+
+int z_cbvprintf_bulk_impl(cbprintf_bulk_cb out, void *ctx, const char *fmt,
+			  va_list ap, uint32_t flags)
+{
+	struct bulk_ctx bctx = {
+		.out = out,
+		.ctx = ctx,
+	};
+	int rc = z_cbvprintf_impl(bulk_char_out, &bctx, fmt, ap, flags);
+	int frc = bulk_flush(&bctx);
+
+	if (rc < 0) {
+		return rc;
+	}
+
+	return (frc < 0) ? frc : rc;
+}
@@ -14,27 +14,35 @@
  */
 
 #include <errno.h>
+#include <stdio.h>
 #include <string.h>
 
 #include <zephyr/posix/fcntl.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/speculation.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/zvfs/epoll.h>
 
 struct stat;
 
 struct fd_entry {
 	void *obj;
 	const struct fd_op_vtable *vtable;
+	/* FD_ENTRY_OPEN while the descriptor is open, plus the operations in flight */
 	atomic_t refcount;
 	struct k_mutex lock;
 	struct k_condvar cond;
 	size_t offset;
 	uint32_t mode;
+	/* lock and cond are initialized once, as they may still be in use after a close */
+	bool initialized;
 };
 
+#define FD_ENTRY_OPEN BIT(30)
+
 #if defined(CONFIG_POSIX_DEVICE_IO)
 static const struct fd_op_vtable stdinout_fd_op_vtable;
 
@@ -49,69 +57,152 @@ static struct fd_entry fdtable[CONFIG_ZVFS_OPEN_MAX] = {
 	{
 		/* STDIN */
 		.vtable = &stdinout_fd_op_vtable,
-		.refcount = ATOMIC_INIT(1),
+		.refcount = ATOMIC_INIT(FD_ENTRY_OPEN),
 		.lock = Z_MUTEX_INITIALIZER(fdtable[0].lock),
 		.cond = Z_CONDVAR_INITIALIZER(fdtable[0].cond),
+		.initialized = true,
 	},
 	{
 		/* STDOUT */
 		.vtable = &stdinout_fd_op_vtable,
-		.refcount = ATOMIC_INIT(1),
+		.refcount = ATOMIC_INIT(FD_ENTRY_OPEN),
 		.lock = Z_MUTEX_INITIALIZER(fdtable[1].lock),
 		.cond = Z_CONDVAR_INITIALIZER(fdtable[1].cond),
+		.initialized = true,
 	},
 	{
 		/* STDERR */
 		.vtable = &stdinout_fd_op_vtable,
-		.refcount = ATOMIC_INIT(1),
+		.refcount = ATOMIC_INIT(FD_ENTRY_OPEN),
 		.lock = Z_MUTEX_INITIALIZER(fdtable[2].lock),
 		.cond = Z_CONDVAR_INITIALIZER(fdtable[2].cond),
+		.initialized = true,
 	},
 #else
 	{0},
 #endif
 };
 
-static K_MUTEX_DEFINE(fdtable_lock);
+#ifdef CONFIG_ZVFS_OPEN_DYNAMIC
+#define ZVFS_FD_MAX CONFIG_ZVFS_OPEN_DYNAMIC_MAX
+#else
+#define ZVFS_FD_MAX CONFIG_ZVFS_OPEN_MAX
+#endif
+
+/*
+ * Descriptors in use, so that the lowest free one is found without scanning
+ * the entries and claimed without a lock. A bit is set before its entry is
+ * reserved and only cleared once the entry has been released.
+ */
+static atomic_t fdtable_used[ATOMIC_BITMAP_SIZE(ZVFS_FD_MAX)] = {
+#if defined(CONFIG_POSIX_DEVICE_IO)
+	ATOMIC_INIT(BIT_MASK(3)),
+#else
+	ATOMIC_INIT(0),
+#endif
+};
+
+#ifdef CONFIG_ZVFS_OPEN_DYNAMIC
+/*
+ * The table is made of chunks of CONFIG_ZVFS_OPEN_MAX entries, the first one
+ * being static. The others are allocated when a descriptor in them is first
+ * reserved and are never freed, so that entries can be looked up without a
+ * lock.
+ */
+static atomic_ptr_t fdtable_chunks[DIV_ROUND_UP(ZVFS_FD_MAX, CONFIG_ZVFS_OPEN_MAX)] = {
+	ATOMIC_PTR_INIT(fdtable),
+};
 
-static int z_fd_ref(int fd)
+static struct fd_entry *z_fd_entry(int fd)
 {
-	return atomic_inc(&fdtable[fd].refcount) + 1;
+	struct fd_entry *chunk = atomic_ptr_get(&fdtable_chunks[fd / CONFIG_ZVFS_OPEN_MAX]);
+
+	return (chunk == NULL) ? NULL : &chunk[fd % CONFIG_ZVFS_OPEN_MAX];
 }
 
-static int z_fd_unref(int fd)
+static struct fd_entry *z_fd_grow(int fd)
 {
-	atomic_val_t old_rc;
+	atomic_ptr_t *slot = &fdtable_chunks[fd / CONFIG_ZVFS_OPEN_MAX];
+	struct fd_entry *chunk;
 
-	/* Reference counter must be checked to avoid decrement refcount below
-	 * zero causing file descriptor leak. Loop statement below executes
-	 * atomic decrement if refcount value is grater than zero. Otherwise,
-	 * refcount is not going to be written.
-	 */
-	do {
-		old_rc = atomic_get(&fdtable[fd].refcount);
-		if (!old_rc) {
-			return 0;
-		}
-	} while (!atomic_cas(&fdtable[fd].refcount, old_rc, old_rc - 1));
+	chunk = k_calloc(CONFIG_ZVFS_OPEN_MAX, sizeof(*chunk));
+	if (chunk == NULL) {
+		return NULL;
+	}
 
-	if (old_rc != 1) {
-		return old_rc - 1;
+	/* Another thread may have added the chunk in the meantime */
+	if (!atomic_ptr_cas(slot, NULL, chunk)) {
+		k_free(chunk);
+		chunk = atomic_ptr_get(slot);
 	}
 
-	fdtable[fd].obj = NULL;
-	fdtable[fd].vtable = NULL;
+	return &chunk[fd % CONFIG_ZVFS_OPEN_MAX];
+}
+#else
+static inline struct fd_entry *z_fd_entry(int fd)
+{
+	return &fdtable[fd];
+}
+#endif /* CONFIG_ZVFS_OPEN_DYNAMIC */
+
+static void z_fd_recycle(int fd, struct fd_entry *entry)
+{
+	entry->obj = NULL;
+	entry->vtable = NULL;
 
-	return 0;
+	/* The descriptor may be reserved again from here */
+	atomic_clear_bit(fdtable_used, fd);
+}
+
+/* Release a reference taken by z_fd_get() */
+static void z_fd_put(int fd)
+{
+	struct fd_entry *entry = z_fd_entry(fd);
+
+	if (atomic_dec(&entry->refcount) == 1) {
+		z_fd_recycle(fd, entry);
+	}
+}
+
+/*
+ * Close the descriptor, its entry being recycled once the operations in
+ * flight are done. Returns false if it was not open.
+ */
+static bool z_fd_release(int fd)
+{
+	struct fd_entry *entry = z_fd_entry(fd);
+	atomic_val_t old_rc;
+
+	old_rc = atomic_and(&entry->refcount, ~FD_ENTRY_OPEN);
+	if ((old_rc & FD_ENTRY_OPEN) == 0) {
+		return false;
+	}
+
+	if (old_rc == FD_ENTRY_OPEN) {
+		z_fd_recycle(fd, entry);
+	}
+
+	return true;
 }
 
 static int _find_fd_entry(void)
 {
-	int fd;
+	for (size_t i = 0; i < ARRAY_SIZE(fdtable_used); i++) {
+		unsigned long avail = ~(unsigned long)atomic_get(&fdtable_used[i]);
+
+		while (avail != 0) {
+			int fd = i * ATOMIC_BITS + u64_count_trailing_zeros(avail);
+
+			if (fd >= ZVFS_FD_MAX) {
+				break;
+			}
+
+			if (!atomic_test_and_set_bit(fdtable_used, fd)) {
+				return fd;
+			}
 
-	for (fd = 0; fd < ARRAY_SIZE(fdtable); fd++) {
-		if (!atomic_get(&fdtable[fd].refcount)) {
-			return fd;
+			/* Claimed by another thread, look for the next one */
+			avail = ~(unsigned long)atomic_get(&fdtable_used[i]);
 		}
 	}
 
@@ -119,21 +210,48 @@ static int _find_fd_entry(void)
 	return -1;
 }
 
-static int _check_fd(int fd)
+static struct fd_entry *_get_fd_entry(int fd)
 {
-	if ((fd < 0) || (fd >= ARRAY_SIZE(fdtable))) {
+	struct fd_entry *entry;
+
+	if ((fd < 0) || (fd >= ZVFS_FD_MAX)) {
 		errno = EBADF;
-		return -1;
+		return NULL;
 	}
 
-	fd = k_array_index_sanitize(fd, ARRAY_SIZE(fdtable));
+	fd = k_array_index_sanitize(fd, ZVFS_FD_MAX);
+	entry = z_fd_entry(fd);
 
-	if (!atomic_get(&fdtable[fd].refcount)) {
+	if ((entry == NULL) || ((atomic_get(&entry->refcount) & FD_ENTRY_OPEN) == 0)) {
 		errno = EBADF;
-		return -1;
+		return NULL;
 	}
 
-	return 0;
+	return entry;
+}
+
+/*
+ * Take a reference for an operation on an open descriptor, so that its entry
+ * is not recycled until the operation is done, even if closed meanwhile.
+ */
+static struct fd_entry *z_fd_get(int fd)
+{
+	struct fd_entry *entry = _get_fd_entry(fd);
+	atomic_val_t old_rc;
+
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	do {
+		old_rc = atomic_get(&entry->refcount);
+		if ((old_rc & FD_ENTRY_OPEN) == 0) {
+			errno = EBADF;
+			return NULL;
+		}
+	} while (!atomic_cas(&entry->refcount, old_rc, old_rc + 1));
+
+	return entry;
 }
 
 #ifdef CONFIG_ZTEST
@@ -141,18 +259,24 @@ bool fdtable_fd_is_initialized(int fd)
 {
 	struct k_mutex ref_lock;
 	struct k_condvar ref_cond;
+	struct fd_entry *entry;
 
-	if (fd < 0 || fd >= ARRAY_SIZE(fdtable)) {
+	if (fd < 0 || fd >= ZVFS_FD_MAX) {
 		return false;
 	}
 
-	ref_lock = (struct k_mutex)Z_MUTEX_INITIALIZER(fdtable[fd].lock);
-	if (memcmp(&ref_lock, &fdtable[fd].lock, sizeof(ref_lock)) != 0) {
+	entry = z_fd_entry(fd);
+	if (entry == NULL) {
 		return false;
 	}
 
-	ref_cond = (struct k_condvar)Z_CONDVAR_INITIALIZER(fdtable[fd].cond);
-	if (memcmp(&ref_cond, &fdtable[fd].cond, sizeof(ref_cond)) != 0) {
+	ref_lock = (struct k_mutex)Z_MUTEX_INITIALIZER(entry->lock);
+	if (memcmp(&ref_lock, &entry->lock, sizeof(ref_lock)) != 0) {
+		return false;
+	}
+
+	ref_cond = (struct k_condvar)Z_CONDVAR_INITIALIZER(entry->cond);
+	if (memcmp(&ref_cond, &entry->cond, sizeof(ref_cond)) != 0) {
 		return false;
 	}
 
@@ -162,14 +286,12 @@ bool fdtable_fd_is_initialized(int fd)
 
 void *zvfs_get_fd_obj(int fd, const struct fd_op_vtable *vtable, int err)
 {
-	struct fd_entry *entry;
+	struct fd_entry *entry = _get_fd_entry(fd);
 
-	if (_check_fd(fd) < 0) {
+	if (entry == NULL) {
 		return NULL;
 	}
 
-	entry = &fdtable[fd];
-
 	if ((vtable != NULL) && (entry->vtable != vtable)) {
 		errno = err;
 		return NULL;
@@ -178,33 +300,39 @@ void *zvfs_get_fd_obj(int fd, const struct fd_op_vtable *vtable, int err)
 	return entry->obj;
 }
 
-static int z_get_fd_by_obj_and_vtable(void *obj, const struct fd_op_vtable *vtable)
+static struct fd_entry *z_get_fd_by_obj_and_vtable(void *obj, const struct fd_op_vtable *vtable)
 {
-	int fd;
+	/* Only the descriptors in use are looked at */
+	for (size_t i = 0; i < ARRAY_SIZE(fdtable_used); i++) {
+		unsigned long used = (unsigned long)atomic_get(&fdtable_used[i]);
+
+		while (used != 0) {
+			int fd = i * ATOMIC_BITS + u64_count_trailing_zeros(used);
+			struct fd_entry *entry = z_fd_entry(fd);
+
+			if ((entry != NULL) && (entry->obj == obj) && (entry->vtable == vtable) &&
+			    ((atomic_get(&entry->refcount) & FD_ENTRY_OPEN) != 0)) {
+				return entry;
+			}
 
-	for (fd = 0; fd < ARRAY_SIZE(fdtable); fd++) {
-		if (fdtable[fd].obj == obj && fdtable[fd].vtable == vtable) {
-			return fd;
+			used &= used - 1;
 		}
 	}
 
-	errno = ENFILE;
-	return -1;
+	errno = EBADF;
+	return NULL;
 }
 
 bool zvfs_get_obj_lock_and_cond(void *obj, const struct fd_op_vtable *vtable, struct k_mutex **lock,
 			     struct k_condvar **cond)
 {
-	int fd;
 	struct fd_entry *entry;
 
-	fd = z_get_fd_by_obj_and_vtable(obj, vtable);
-	if (_check_fd(fd) < 0) {
+	entry = z_get_fd_by_obj_and_vtable(obj, vtable);
+	if (entry == NULL) {
 		return false;
 	}
 
-	entry = &fdtable[fd];
-
 	if (lock) {
 		*lock = &entry->lock;
 	}
@@ -219,13 +347,12 @@ bool zvfs_get_obj_lock_and_cond(void *obj, const struct fd_op_vtable *vtable, st
 void *zvfs_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable,
 			      struct k_mutex **lock)
 {
-	struct fd_entry *entry;
+	struct fd_entry *entry = _get_fd_entry(fd);
 
-	if (_check_fd(fd) < 0) {
+	if (entry == NULL) {
 		return NULL;
 	}
 
-	entry = &fdtable[fd];
 	*vtable = entry->vtable;
 
 	if (lock != NULL) {
@@ -237,21 +364,40 @@ void *zvfs_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable,
 
 int zvfs_reserve_fd(void)
 {
+	struct fd_entry *entry;
 	int fd;
 
-	(void)k_mutex_lock(&fdtable_lock, K_FOREVER);
-
 	fd = _find_fd_entry();
-	if (fd >= 0) {
-		/* Mark entry as used, zvfs_finalize_fd() will fill it in. */
-		(void)z_fd_ref(fd);
-		fdtable[fd].obj = NULL;
-		fdtable[fd].vtable = NULL;
-		k_mutex_init(&fdtable[fd].lock);
-		k_condvar_init(&fdtable[fd].cond);
+	if (fd < 0) {
+		return -1;
+	}
+
+	entry = z_fd_entry(fd);
+#ifdef CONFIG_ZVFS_OPEN_DYNAMIC
+	if (entry == NULL) {
+		entry = z_fd_grow(fd);
+		if (entry == NULL) {
+			atomic_clear_bit(fdtable_used, fd);
+			errno = ENOMEM;
+			return -1;
+		}
 	}
+#endif
 
-	k_mutex_unlock(&fdtable_lock);
+	/* The descriptor is ours and the operations on its previous use are
+	 * done, as it is only released then. Objects may still wait on the
+	 * lock and condition variable they were given, which are never
+	 * initialized again. Mark the entry as open once it is ready,
+	 * zvfs_finalize_fd() will fill it in.
+	 */
+	entry->obj = NULL;
+	entry->vtable = NULL;
+	if (!entry->initialized) {
+		k_mutex_init(&entry->lock);
+		k_condvar_init(&entry->cond);
+		entry->initialized = true;
+	}
+	atomic_set(&entry->refcount, FD_ENTRY_OPEN);
 
 	return fd;
 }
@@ -259,6 +405,8 @@ int zvfs_reserve_fd(void)
 void zvfs_finalize_typed_fd(int fd, void *obj, const struct fd_op_vtable *vtable, uint32_t mode)
 {
 	/* Assumes fd was already bounds-checked. */
+	struct fd_entry *entry = z_fd_entry(fd);
+
 #ifdef CONFIG_USERSPACE
 	/* descriptor context objects are inserted into the table when they
 	 * are ready for use. Mark the object as initialized and grant the
@@ -269,9 +417,9 @@ void zvfs_finalize_typed_fd(int fd, void *obj, const struct fd_op_vtable *vtable
 	 */
 	k_object_recycle(obj);
 #endif
-	fdtable[fd].obj = obj;
-	fdtable[fd].vtable = vtable;
-	fdtable[fd].mode = mode;
+	entry->obj = obj;
+	entry->vtable = vtable;
+	entry->mode = mode;
 
 	/* Let the object know about the lock just in case it needs it
 	 * for something. For BSD sockets, the lock is used with condition
@@ -279,14 +427,14 @@ void zvfs_finalize_typed_fd(int fd, void *obj, const struct fd_op_vtable *vtable
 	 */
 	if (vtable && vtable->ioctl) {
 		(void)zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_SET_LOCK,
-					   &fdtable[fd].lock);
+					   &entry->lock);
 	}
 }
 
 void zvfs_free_fd(int fd)
 {
 	/* Assumes fd was already bounds-checked. */
-	(void)z_fd_unref(fd);
+	(void)z_fd_release(fd);
 }
 
 int zvfs_alloc_fd(void *obj, const struct fd_op_vtable *vtable)
@@ -303,178 +451,302 @@ int zvfs_alloc_fd(void *obj, const struct fd_op_vtable *vtable)
 
 ssize_t zvfs_read(int fd, void *buf, size_t sz)
 {
+	struct fd_entry *entry = z_fd_get(fd);
 	ssize_t res;
 
-	if (_check_fd(fd) < 0) {
+	if (entry == NULL) {
 		return -1;
 	}
 
-	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
-	res = fdtable[fd].vtable->read_offs(fdtable[fd].obj, buf, sz, fdtable[fd].offset);
+	(void)k_mutex_lock(&entry->lock, K_FOREVER);
+	res = entry->vtable->read_offs(entry->obj, buf, sz, entry->offset);
 	if (res > 0) {
-		switch (fdtable[fd].mode & ZVFS_MODE_IFMT) {
+		switch (entry->mode & ZVFS_MODE_IFMT) {
 		case ZVFS_MODE_IFDIR:
 		case ZVFS_MODE_IFBLK:
 		case ZVFS_MODE_IFSHM:
 		case ZVFS_MODE_IFREG:
-			fdtable[fd].offset += res;
+			entry->offset += res;
 			break;
 		default:
 			break;
 		}
 	}
-	k_mutex_unlock(&fdtable[fd].lock);
+	k_mutex_unlock(&entry->lock);
+	z_fd_put(fd);
 
 	return res;
 }
 
 ssize_t zvfs_write(int fd, const void *buf, size_t sz)
 {
+	struct fd_entry *entry = z_fd_get(fd);
 	ssize_t res;
 
-	if (_check_fd(fd) < 0) {
+	if (entry == NULL) {
 		return -1;
 	}
 
-	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
-	res = fdtable[fd].vtable->write_offs(fdtable[fd].obj, buf, sz, fdtable[fd].offset);
+	(void)k_mutex_lock(&entry->lock, K_FOREVER);
+	res = entry->vtable->write_offs(entry->obj, buf, sz, entry->offset);
 	if (res > 0) {
-		switch (fdtable[fd].mode & ZVFS_MODE_IFMT) {
+		switch (entry->mode & ZVFS_MODE_IFMT) {
 		case ZVFS_MODE_IFDIR:
 		case ZVFS_MODE_IFBLK:
 		case ZVFS_MODE_IFSHM:
 		case ZVFS_MODE_IFREG:
-			fdtable[fd].offset += res;
+			entry->offset += res;
 			break;
 		default:
 			break;
 		}
 	}
-	k_mutex_unlock(&fdtable[fd].lock);
+	k_mutex_unlock(&entry->lock);
+	z_fd_put(fd);
+
+	return res;
+}
+
+/*
+ * Reads or writes at the given offset, leaving the offset of the file
+ * descriptor unchanged. Objects which do not get the offset from the fd table
+ * are seeked to it and back, or just read or written when they cannot seek.
+ */
+static ssize_t zvfs_rw_offs(struct fd_entry *entry, void *buf, size_t sz, size_t offset,
+			    bool is_write)
+{
+	const struct fd_op_vtable *vtable = entry->vtable;
+	void *obj = entry->obj;
+	off_t pos;
+	ssize_t res;
+
+	switch (entry->mode & ZVFS_MODE_IFMT) {
+	case ZVFS_MODE_IFDIR:
+	case ZVFS_MODE_IFBLK:
+	case ZVFS_MODE_IFSHM:
+	case ZVFS_MODE_IFREG:
+		return is_write ? vtable->write_offs(obj, buf, sz, offset)
+				: vtable->read_offs(obj, buf, sz, offset);
+	default:
+		break;
+	}
+
+	pos = zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_LSEEK, (off_t)0, SEEK_CUR,
+				      entry->offset);
+	if (pos >= 0 && zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_LSEEK, (off_t)offset,
+						SEEK_SET, entry->offset) < 0) {
+		return -1;
+	}
+
+	res = is_write ? vtable->write(obj, buf, sz) : vtable->read(obj, buf, sz);
+
+	if (pos >= 0) {
+		(void)zvfs_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_LSEEK, pos, SEEK_SET,
+					      entry->offset);
+	}
+
+	return res;
+}
+
+ssize_t zvfs_pread(int fd, void *buf, size_t sz, size_t offset)
+{
+	struct fd_entry *entry = z_fd_get(fd);
+	ssize_t res;
+
+	if (entry == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(&entry->lock, K_FOREVER);
+	res = zvfs_rw_offs(entry, buf, sz, offset, false);
+	k_mutex_unlock(&entry->lock);
+	z_fd_put(fd);
+
+	return res;
+}
+
+ssize_t zvfs_pwrite(int fd, const void *buf, size_t sz, size_t offset)
+{
+	struct fd_entry *entry = z_fd_get(fd);
+	ssize_t res;
+
+	if (entry == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(&entry->lock, K_FOREVER);
+	res = zvfs_rw_offs(entry, (void *)buf, sz, offset, true);
+	k_mutex_unlock(&entry->lock);
+	z_fd_put(fd);
 
 	return res;
 }
 
 int zvfs_close(int fd)
 {
+	struct fd_entry *entry = z_fd_get(fd);
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (entry == NULL) {
+		return -1;
+	}
+
+	/* Only one of concurrent closes goes on, the others fail as after it */
+	if (!z_fd_release(fd)) {
+		z_fd_put(fd);
+		errno = EBADF;
 		return -1;
 	}
 
-	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
+#ifdef CONFIG_ZVFS_EPOLL
+	zvfs_epoll_fd_close(fd);
+#endif
 
-	res = fdtable[fd].vtable->close(fdtable[fd].obj);
+	(void)k_mutex_lock(&entry->lock, K_FOREVER);
 
-	k_mutex_unlock(&fdtable[fd].lock);
+	res = entry->vtable->close(entry->obj);
 
-	zvfs_free_fd(fd);
+	k_mutex_unlock(&entry->lock);
+
+	/* The entry is recycled once the operations in flight are done */
+	z_fd_put(fd);
 
 	return res;
 }
 
 int zvfs_fstat(int fd, struct stat *buf)
 {
-	if (_check_fd(fd) < 0) {
+	struct fd_entry *entry = z_fd_get(fd);
+	int res;
+
+	if (entry == NULL) {
 		return -1;
 	}
 
-	return zvfs_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_STAT, buf);
+	res = zvfs_fdtable_call_ioctl(entry->vtable, entry->obj, ZFD_IOCTL_STAT, buf);
+	z_fd_put(fd);
+
+	return res;
 }
 
 int zvfs_fsync(int fd)
 {
-	if (_check_fd(fd) < 0) {
+	struct fd_entry *entry = z_fd_get(fd);
+	int res;
+
+	if (entry == NULL) {
 		return -1;
 	}
 
-	return zvfs_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_FSYNC);
+	res = zvfs_fdtable_call_ioctl(entry->vtable, entry->obj, ZFD_IOCTL_FSYNC);
+	z_fd_put(fd);
+
+	return res;
 }
 
-static inline off_t zvfs_lseek_wrap(int fd, int cmd, ...)
+static inline off_t zvfs_lseek_wrap(struct fd_entry *entry, int cmd, ...)
 {
 	off_t res;
 	va_list args;
 
-	__ASSERT_NO_MSG(fd < ARRAY_SIZE(fdtable));
+	__ASSERT_NO_MSG(entry != NULL);
 
-	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
+	(void)k_mutex_lock(&entry->lock, K_FOREVER);
 	va_start(args, cmd);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, cmd, args);
+	res = entry->vtable->ioctl(entry->obj, cmd, args);
 	va_end(args);
 	if (res >= 0) {
-		switch (fdtable[fd].mode & ZVFS_MODE_IFMT) {
+		switch (entry->mode & ZVFS_MODE_IFMT) {
 		case ZVFS_MODE_IFDIR:
 		case ZVFS_MODE_IFBLK:
 		case ZVFS_MODE_IFSHM:
 		case ZVFS_MODE_IFREG:
-			fdtable[fd].offset = res;
+			entry->offset = res;
 			break;
 		default:
 			break;
 		}
 	}
-	k_mutex_unlock(&fdtable[fd].lock);
+	k_mutex_unlock(&entry->lock);
 
 	return res;
 }
 
 off_t zvfs_lseek(int fd, off_t offset, int whence)
 {
-	if (_check_fd(fd) < 0) {
+	struct fd_entry *entry = z_fd_get(fd);
+	off_t res;
+
+	if (entry == NULL) {
 		return -1;
 	}
 
-	return zvfs_lseek_wrap(fd, ZFD_IOCTL_LSEEK, offset, whence, fdtable[fd].offset);
+	res = zvfs_lseek_wrap(entry, ZFD_IOCTL_LSEEK, offset, whence, entry->offset);
+	z_fd_put(fd);
+
+	return res;
 }
 
 int zvfs_fcntl(int fd, int cmd, va_list args)
 {
+	struct fd_entry *entry = z_fd_get(fd);
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (entry == NULL) {
 		return -1;
 	}
 
 	/* The rest of commands are per-fd, handled by ioctl vmethod. */
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, cmd, args);
+	res = entry->vtable->ioctl(entry->obj, cmd, args);
+	z_fd_put(fd);
 
 	return res;
 }
 
-static inline int zvfs_ftruncate_wrap(int fd, int cmd, ...)
+static inline int zvfs_ftruncate_wrap(struct fd_entry *entry, int cmd, ...)
 {
 	int res;
 	va_list args;
 
-	__ASSERT_NO_MSG(fd < ARRAY_SIZE(fdtable));
+	__ASSERT_NO_MSG(entry != NULL);
 
-	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
+	(void)k_mutex_lock(&entry->lock, K_FOREVER);
 	va_start(args, cmd);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, cmd, args);
+	res = entry->vtable->ioctl(entry->obj, cmd, args);
 	va_end(args);
-	k_mutex_unlock(&fdtable[fd].lock);
+	k_mutex_unlock(&entry->lock);
 
 	return res;
 }
 
 int zvfs_ftruncate(int fd, off_t length)
 {
-	if (_check_fd(fd) < 0) {
+	struct fd_entry *entry = z_fd_get(fd);
+	int res;
+
+	if (entry == NULL) {
 		return -1;
 	}
 
-	return zvfs_ftruncate_wrap(fd, ZFD_IOCTL_TRUNCATE, length);
+	res = zvfs_ftruncate_wrap(entry, ZFD_IOCTL_TRUNCATE, length);
+	z_fd_put(fd);
+
+	return res;
 }
 
 int zvfs_ioctl(int fd, unsigned long request, va_list args)
 {
-	if (_check_fd(fd) < 0) {
+	struct fd_entry *entry = z_fd_get(fd);
+	int res;
+
+	if (entry == NULL) {
 		return -1;
 	}
 
-	return fdtable[fd].vtable->ioctl(fdtable[fd].obj, request, args);
+	res = entry->vtable->ioctl(entry->obj, request, args);
+	z_fd_put(fd);
+
+	return res;
 }
 
 
@@ -40,6 +40,14 @@ void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer,
 
 	if (is_power_of_two(buffer->size)) {
 		buffer->flags |= MPSC_PBUF_SIZE_POW2;
+	} else {
+		buffer->flags &= ~MPSC_PBUF_MODE_LOCKFREE;
+	}
+
+	if (!IS_ENABLED(CONFIG_MPSC_PBUF_LOCKFREE)) {
+		buffer->flags &= ~MPSC_PBUF_MODE_LOCKFREE;
+	} else if (buffer->flags & MPSC_PBUF_MODE_LOCKFREE) {
+		memset(buffer->buf, 0, buffer->size * sizeof(uint32_t));
 	}
 
 	err = k_sem_init(&buffer->sem, 0, 1);
@@ -285,6 +293,417 @@ static void post_drop_action(struct mpsc_pbuf_buffer *buffer,
 	/* full flag? */
 }
 
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+/* Lock-free mode.
+ *
+ * Indexes are free running, and only wrapped to access the buffer, so that
+ * a full buffer is told apart from an empty one and a stale index is never
+ * taken for a current one. tmp_wr_idx is the write index, moved by the
+ * producers with a compare and swap. tmp_rd_idx is the claim index and
+ * rd_idx the index of the oldest packet not freed, both moved with the lock
+ * held. wr_idx is not used.
+ *
+ * Space between the write index and the read index is kept zeroed, so that
+ * space just reserved reads as a packet not committed yet: the consumer, or
+ * the producer dropping a packet, clears the packet before moving rd_idx.
+ *
+ * In overwrite mode, claimed packets are not dropped: the write index is
+ * moved past them instead, leaving them in place in the next lap, where they
+ * are passed over by the consumer until freed, as in locked mode.
+ */
+
+#define LF_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define LF_STORE(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+
+static inline bool is_lockfree(const struct mpsc_pbuf_buffer *buffer)
+{
+	return (buffer->flags & MPSC_PBUF_MODE_LOCKFREE) != 0;
+}
+
+static inline union mpsc_pbuf_generic *lf_item(struct mpsc_pbuf_buffer *buffer,
+					       uint32_t idx)
+{
+	return (union mpsc_pbuf_generic *)&buffer->buf[idx & (buffer->size - 1)];
+}
+
+static inline bool is_skip(union mpsc_pbuf_generic item)
+{
+	return item.hdr.busy && !item.hdr.valid;
+}
+
+static void lf_max_utilization_update(struct mpsc_pbuf_buffer *buffer,
+				      uint32_t usage)
+{
+	uint32_t max = __atomic_load_n(&buffer->max_usage, __ATOMIC_RELAXED);
+
+	while ((usage > max) &&
+	       !__atomic_compare_exchange_n(&buffer->max_usage, &max, usage, true,
+					    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+	}
+}
+
+/* Reserve space for a packet, after a skip packet up to the end of the
+ * buffer if the packet does not fit before.
+ *
+ * @retval true with the index of the packet in @p idx.
+ * @retval false if there is not enough space.
+ */
+static bool lf_reserve(struct mpsc_pbuf_buffer *buffer, uint32_t wlen,
+		       uint32_t *idx)
+{
+	uint32_t rd, wr, len, offset;
+
+	for (;;) {
+		/* Read index first, as it cannot pass the write index */
+		rd = LF_LOAD(&buffer->rd_idx);
+		wr = LF_LOAD(&buffer->tmp_wr_idx);
+		if (wr - rd > buffer->size) {
+			/* Both moved in between. */
+			continue;
+		}
+
+		offset = wr & (buffer->size - 1);
+		len = (offset + wlen > buffer->size) ? buffer->size - offset : wlen;
+
+		if (buffer->size - (wr - rd) < len) {
+			return false;
+		}
+
+		if (!__atomic_compare_exchange_n(&buffer->tmp_wr_idx, &wr, wr + len,
+						 false, __ATOMIC_RELAXED,
+						 __ATOMIC_RELAXED)) {
+			continue;
+		}
+
+		if (len == wlen) {
+			break;
+		}
+
+		union mpsc_pbuf_generic skip = {
+			.skip = { .valid = 0, .busy = 1, .len = len }
+		};
+
+		LF_STORE(&lf_item(buffer, wr)->raw, skip.raw);
+	}
+
+	if (buffer->flags & MPSC_PBUF_MAX_UTILIZATION) {
+		lf_max_utilization_update(buffer, wr + wlen - rd);
+	}
+
+	*idx = wr;
+
+	return true;
+}
+
+/* Clear the oldest packet, and move the read index past it. */
+static void lf_release_locked(struct mpsc_pbuf_buffer *buffer, uint32_t idx,
+			      uint32_t wlen)
+{
+	memset(lf_item(buffer, idx), 0, wlen * sizeof(uint32_t));
+
+	if (buffer->tmp_rd_idx == idx) {
+		buffer->tmp_rd_idx = idx + wlen;
+	}
+
+	LF_STORE(&buffer->rd_idx, idx + wlen);
+}
+
+/* Drop the oldest packet not claimed, the oldest one being claimed. The
+ * claimed packets stay where they are, the write index moving past them to
+ * the next lap, after the space left before them is filled with skip packets.
+ *
+ * @retval true if space may have been freed.
+ * @retval false if no packet can be dropped.
+ */
+static bool lf_drop_claimed_locked(struct mpsc_pbuf_buffer *buffer)
+{
+	uint32_t end = buffer->rd_idx + buffer->size;
+	uint32_t idx = buffer->tmp_rd_idx;
+	union mpsc_pbuf_generic *item;
+	union mpsc_pbuf_generic hdr;
+	uint32_t wr, wlen;
+
+	/* Claimed in a previous lap as well */
+	for (;;) {
+		if (idx == LF_LOAD(&buffer->tmp_wr_idx)) {
+			/* All claimed. */
+			return false;
+		}
+
+		item = lf_item(buffer, idx);
+		hdr.raw = LF_LOAD(&item->raw);
+		if (!hdr.hdr.valid || !hdr.hdr.busy) {
+			break;
+		}
+		idx += buffer->get_wlen(item);
+	}
+
+	if (is_skip(hdr)) {
+		wlen = hdr.skip.len;
+	} else if (!hdr.hdr.valid) {
+		/* Not committed yet. */
+		return false;
+	} else {
+		wlen = buffer->get_wlen(item);
+		MPSC_PBUF_DBG(buffer, "no space: dropping packet %p after claimed ones (len: %d)",
+			      item, wlen);
+		item->hdr.valid = 0;
+		if (buffer->notify_drop) {
+			buffer->notify_drop(buffer, item);
+		}
+	}
+
+	/* Producers only move the write index up to the read index, one lap
+	 * ahead. They retry while it is ahead of that, until rd_idx is moved.
+	 */
+	wr = LF_LOAD(&buffer->tmp_wr_idx);
+	while (!__atomic_compare_exchange_n(&buffer->tmp_wr_idx, &wr, idx + buffer->size,
+					    false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+	}
+
+	/* Skip packets do not wrap around the end of the buffer */
+	while (wr != end) {
+		uint32_t offset = wr & (buffer->size - 1);
+		uint32_t len = MIN(end - wr, buffer->size - offset);
+		union mpsc_pbuf_generic skip = {
+			.skip = { .valid = 0, .busy = 1, .len = len }
+		};
+
+		LF_STORE(&lf_item(buffer, wr)->raw, skip.raw);
+		wr += len;
+	}
+
+	buffer->tmp_rd_idx = idx;
+	lf_release_locked(buffer, idx, wlen);
+
+	return true;
+}
+
+/* Drop the oldest packet to make space.
+ *
+ * @param start Read index when the allocation started.
+ *
+ * @retval true if space may have been freed.
+ * @retval false if the oldest packet cannot be dropped.
+ */
+static bool lf_drop_locked(struct mpsc_pbuf_buffer *buffer, uint32_t start)
+{
+	uint32_t rd = buffer->rd_idx;
+	union mpsc_pbuf_generic *item;
+	union mpsc_pbuf_generic hdr;
+	uint32_t wlen;
+
+	if (rd == LF_LOAD(&buffer->tmp_wr_idx)) {
+		/* Emptied meanwhile. */
+		return true;
+	}
+
+	if (rd - start >= 2 * buffer->size) {
+		/* Dropping for two laps already: the space left between
+		 * claimed packets is too fragmented for the packet.
+		 */
+		return false;
+	}
+
+	item = lf_item(buffer, rd);
+	hdr.raw = LF_LOAD(&item->raw);
+
+	if (is_skip(hdr)) {
+		wlen = hdr.skip.len;
+		MPSC_PBUF_DBG(buffer, "no space: Found skip packet %d len", wlen);
+	} else if (!hdr.hdr.valid || !(buffer->flags & MPSC_PBUF_MODE_OVERWRITE)) {
+		/* Not committed yet, or not to be overwritten. */
+		return false;
+	} else if (hdr.hdr.busy) {
+		MPSC_PBUF_DBG(buffer, "no space: Found busy packet %p", item);
+		return lf_drop_claimed_locked(buffer);
+	} else {
+		wlen = buffer->get_wlen(item);
+		MPSC_PBUF_DBG(buffer, "no space: dropping packet %p (len: %d)",
+			      item, wlen);
+		item->hdr.valid = 0;
+		if (buffer->notify_drop) {
+			buffer->notify_drop(buffer, item);
+		}
+	}
+
+	lf_release_locked(buffer, rd, wlen);
+
+	return true;
+}
+
+static bool lf_reserve_or_drop(struct mpsc_pbuf_buffer *buffer, uint32_t wlen,
+			       uint32_t *idx)
+{
+	uint32_t start = LF_LOAD(&buffer->rd_idx);
+
+	while (!lf_reserve(buffer, wlen, idx)) {
+		k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+		bool dropped = lf_drop_locked(buffer, start);
+
+		k_spin_unlock(&buffer->lock, key);
+
+		if (!dropped) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Put a packet, the header written last. */
+static void lf_put(struct mpsc_pbuf_buffer *buffer, uint32_t hdr,
+		   const void *data, size_t wlen)
+{
+	uint32_t idx;
+
+	if (!lf_reserve_or_drop(buffer, wlen, &idx)) {
+		return;
+	}
+
+	if (wlen > 1) {
+		memcpy(&lf_item(buffer, idx)[1], data, (wlen - 1) * sizeof(uint32_t));
+	}
+	LF_STORE(&lf_item(buffer, idx)->raw, hdr);
+}
+
+static union mpsc_pbuf_generic *lf_alloc(struct mpsc_pbuf_buffer *buffer,
+					 size_t wlen, k_timeout_t timeout)
+{
+	uint32_t start = LF_LOAD(&buffer->rd_idx);
+	uint32_t idx;
+
+	while (!lf_reserve(buffer, wlen, &idx)) {
+		k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+		bool dropped;
+
+		/* Only pend if interrupts were not locked by the caller */
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) && !k_is_in_isr() &&
+		    arch_irq_unlocked(key.key)) {
+			k_spin_unlock(&buffer->lock, key);
+			if (k_sem_take(&buffer->sem, timeout) != 0) {
+				return NULL;
+			}
+			continue;
+		}
+
+		dropped = lf_drop_locked(buffer, start);
+		k_spin_unlock(&buffer->lock, key);
+
+		if (!dropped) {
+			return NULL;
+		}
+	}
+
+	return lf_item(buffer, idx);
+}
+
+static void lf_commit(union mpsc_pbuf_generic *item)
+{
+	union mpsc_pbuf_generic valid = { .hdr = { .valid = 1 } };
+
+	__atomic_fetch_or(&item->raw, valid.raw, __ATOMIC_RELEASE);
+}
+
+static const union mpsc_pbuf_generic *lf_claim(struct mpsc_pbuf_buffer *buffer)
+{
+	union mpsc_pbuf_generic *item = NULL;
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+
+	while (buffer->tmp_rd_idx != LF_LOAD(&buffer->tmp_wr_idx)) {
+		uint32_t idx = buffer->tmp_rd_idx;
+		union mpsc_pbuf_generic hdr;
+
+		item = lf_item(buffer, idx);
+		hdr.raw = LF_LOAD(&item->raw);
+
+		if (hdr.hdr.valid) {
+			buffer->tmp_rd_idx = idx + buffer->get_wlen(item);
+			if (!hdr.hdr.busy) {
+				item->hdr.busy = 1;
+				break;
+			}
+
+			/* Still claimed, from the previous lap. */
+			item = NULL;
+			continue;
+		}
+
+		item = NULL;
+		if (!hdr.hdr.busy) {
+			/* Not committed yet. */
+			break;
+		}
+
+		/* Skip packet, released unless packets before are claimed. */
+		if (buffer->rd_idx == idx) {
+			lf_release_locked(buffer, idx, hdr.skip.len);
+		} else {
+			buffer->tmp_rd_idx = idx + hdr.skip.len;
+		}
+	}
+
+	MPSC_PBUF_DBG(buffer, ">>claimed %p", item);
+	k_spin_unlock(&buffer->lock, key);
+
+	return item;
+}
+
+static void lf_free(struct mpsc_pbuf_buffer *buffer,
+		    const union mpsc_pbuf_generic *item)
+{
+	uint32_t wlen = buffer->get_wlen(item);
+	union mpsc_pbuf_generic *witem = (union mpsc_pbuf_generic *)item;
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+	uint32_t idx = buffer->rd_idx;
+
+	if (witem != lf_item(buffer, idx)) {
+		/* Freed before a packet claimed earlier: released with it. */
+		union mpsc_pbuf_generic skip = {
+			.skip = { .valid = 0, .busy = 1, .len = wlen }
+		};
+
+		witem->raw = skip.raw;
+	} else {
+		lf_release_locked(buffer, idx, wlen);
+		idx += wlen;
+
+		/* Release the packets freed out of order and skip packets
+		 * which follow.
+		 */
+		while (idx != buffer->tmp_rd_idx) {
+			union mpsc_pbuf_generic *next = lf_item(buffer, idx);
+
+			if (!is_skip(*next)) {
+				break;
+			}
+
+			wlen = next->skip.len;
+			lf_release_locked(buffer, idx, wlen);
+			idx += wlen;
+		}
+	}
+
+	MPSC_PBUF_DBG(buffer, "<<freed: %p", item);
+	k_spin_unlock(&buffer->lock, key);
+	k_sem_give(&buffer->sem);
+}
+
+static bool lf_is_pending(struct mpsc_pbuf_buffer *buffer)
+{
+	uint32_t idx = __atomic_load_n(&buffer->tmp_rd_idx, __ATOMIC_RELAXED);
+	union mpsc_pbuf_generic hdr;
+
+	if (idx == LF_LOAD(&buffer->tmp_wr_idx)) {
+		return false;
+	}
+
+	hdr.raw = LF_LOAD(&lf_item(buffer, idx)->raw);
+
+	return hdr.hdr.valid || hdr.hdr.busy;
+}
+#endif /* CONFIG_MPSC_PBUF_LOCKFREE */
+
 void mpsc_pbuf_put_word(struct mpsc_pbuf_buffer *buffer,
 			const union mpsc_pbuf_generic item)
 {
@@ -295,6 +714,13 @@ void mpsc_pbuf_put_word(struct mpsc_pbuf_buffer *buffer,
 	uint32_t tmp_wr_idx_shift = 0;
 	uint32_t tmp_wr_idx_val = 0;
 
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	if (is_lockfree(buffer)) {
+		lf_put(buffer, item.raw, NULL, 1);
+		return;
+	}
+#endif
+
 	do {
 		key = k_spin_lock(&buffer->lock);
 
@@ -348,7 +774,14 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 		return NULL;
 	}
 
-	do {
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	if (is_lockfree(buffer)) {
+		item = lf_alloc(buffer, wlen, timeout);
+		cont = false;
+	}
+#endif
+
+	while (cont) {
 		k_spinlock_key_t key;
 		bool wrap;
 
@@ -370,7 +803,8 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 		} else if (wrap) {
 			add_skip_item(buffer, free_wlen);
 			cont = true;
-		} else if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) && !k_is_in_isr()) {
+		} else if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) && !k_is_in_isr() &&
+			   arch_irq_unlocked(key.key)) {
 			int err;
 
 			k_spin_unlock(&buffer->lock, key);
@@ -391,7 +825,7 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 			}
 			dropped_item = NULL;
 		}
-	} while (cont);
+	}
 
 
 	MPSC_PBUF_DBG(buffer, "allocated %p", item);
@@ -409,6 +843,14 @@ void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer,
 {
 	uint32_t wlen = buffer->get_wlen(item);
 
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	if (is_lockfree(buffer)) {
+		lf_commit(item);
+		MPSC_PBUF_DBG(buffer, "committed %p", item);
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
 
 	item->hdr.valid = 1;
@@ -429,6 +871,13 @@ void mpsc_pbuf_put_word_ext(struct mpsc_pbuf_buffer *buffer,
 	uint32_t tmp_wr_idx_shift = 0;
 	uint32_t tmp_wr_idx_val = 0;
 
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	if (is_lockfree(buffer)) {
+		lf_put(buffer, item.raw, &data, l);
+		return;
+	}
+#endif
+
 	do {
 		k_spinlock_key_t key;
 		uint32_t free_wlen;
@@ -482,6 +931,13 @@ void mpsc_pbuf_put_data(struct mpsc_pbuf_buffer *buffer, const uint32_t *data,
 	uint32_t tmp_wr_idx_shift = 0;
 	uint32_t tmp_wr_idx_val = 0;
 
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	if (is_lockfree(buffer)) {
+		lf_put(buffer, data[0], &data[1], wlen);
+		return;
+	}
+#endif
+
 	do {
 		uint32_t free_wlen;
 		k_spinlock_key_t key;
@@ -530,6 +986,12 @@ const union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer)
 	union mpsc_pbuf_generic *item;
 	bool cont;
 
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	if (is_lockfree(buffer)) {
+		return lf_claim(buffer);
+	}
+#endif
+
 	do {
 		uint32_t a;
 		k_spinlock_key_t key;
@@ -574,6 +1036,13 @@ const union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer)
 void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer,
 		     const union mpsc_pbuf_generic *item)
 {
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	if (is_lockfree(buffer)) {
+		lf_free(buffer, item);
+		return;
+	}
+#endif
+
 	uint32_t wlen = buffer->get_wlen(item);
 	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
 	union mpsc_pbuf_generic *witem = (union mpsc_pbuf_generic *)item;
@@ -607,6 +1076,12 @@ bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer)
 {
 	uint32_t a;
 
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	if (is_lockfree(buffer)) {
+		return lf_is_pending(buffer);
+	}
+#endif
+
 	(void)available(buffer, &a);
 
 	return a ? true : false;
@@ -615,6 +1090,15 @@ bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer)
 void mpsc_pbuf_get_utilization(struct mpsc_pbuf_buffer *buffer,
 			       uint32_t *size, uint32_t *now)
 {
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	if (is_lockfree(buffer)) {
+		*size = buffer->size * sizeof(int);
+		*now = (LF_LOAD(&buffer->tmp_wr_idx) - LF_LOAD(&buffer->rd_idx)) *
+		       sizeof(int);
+		return;
+	}
+#endif
+
 	/* One byte is left for full/empty distinction. */
 	*size = (buffer->size - 1) * sizeof(int);
 	*now = get_usage(buffer) * sizeof(int);
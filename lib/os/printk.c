@@ -93,6 +93,7 @@ static void buf_flush(struct buf_out_context *ctx)
 	ctx->buf_count = 0U;
 }
 
+#ifdef CONFIG_PICOLIBC
 static int buf_char_out(int c, void *ctx_p)
 {
 	struct buf_out_context *ctx = ctx_p;
@@ -105,6 +106,26 @@ static int buf_char_out(int c, void *ctx_p)
 
 	return c;
 }
+#else
+static int buf_bulk_out(const char *buf, size_t len, void *ctx_p)
+{
+	struct buf_out_context *ctx = ctx_p;
+
+	while (len != 0) {
+		size_t n = MIN(len, CONFIG_PRINTK_BUFFER_SIZE - ctx->buf_count);
+
+		memcpy(&ctx->buf[ctx->buf_count], buf, n);
+		ctx->buf_count += n;
+		buf += n;
+		len -= n;
+		if (ctx->buf_count == CONFIG_PRINTK_BUFFER_SIZE) {
+			buf_flush(ctx);
+		}
+	}
+
+	return 0;
+}
+#endif
 
 static int char_out(int c, void *ctx_p)
 {
@@ -132,7 +153,7 @@ void vprintk(const char *fmt, va_list ap)
 #ifdef CONFIG_PICOLIBC
 		(void) vfprintf(&ctx.file, fmt, ap);
 #else
-		cbvprintf(buf_char_out, &ctx, fmt, ap);
+		cbvprintf_bulk(buf_bulk_out, &ctx, fmt, ap);
 #endif
 		if (ctx.buf_count) {
 			buf_flush(&ctx);
@@ -224,21 +245,18 @@ struct str_context {
 	int count;
 };
 
-static int str_out(int c, struct str_context *ctx)
+static int str_out(const char *buf, size_t len, void *ctx_p)
 {
-	if ((ctx->str == NULL) || (ctx->count >= ctx->max)) {
-		++ctx->count;
-		return c;
-	}
+	struct str_context *ctx = ctx_p;
 
-	if (ctx->count == (ctx->max - 1)) {
-		ctx->str[ctx->count] = '\0';
-	} else {
-		ctx->str[ctx->count] = c;
+	/* The last byte is kept for the terminating null character */
+	if ((ctx->str != NULL) && (ctx->count < (ctx->max - 1))) {
+		memcpy(&ctx->str[ctx->count], buf,
+		       MIN(len, (size_t)(ctx->max - 1 - ctx->count)));
 	}
-	++ctx->count;
+	ctx->count += len;
 
-	return c;
+	return 0;
 }
 
 int snprintk(char *str, size_t size, const char *fmt, ...)
@@ -257,10 +275,12 @@ int vsnprintk(char *str, size_t size, const char *fmt, va_list ap)
 {
 	struct str_context ctx = { str, size, 0 };
 
-	cbvprintf(str_out, &ctx, fmt, ap);
+	cbvprintf_bulk(str_out, &ctx, fmt, ap);
 
 	if (ctx.count < ctx.max) {
 		str[ctx.count] = '\0';
+	} else if ((str != NULL) && (ctx.max > 0)) {
+		str[ctx.max - 1] = '\0';
 	}
 
 	return ctx.count;
@@ -0,0 +1,493 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/zvfs/epoll.h>
+#include <zephyr/sys/fdtable.h>
+
+#define ZVFS_EPOLL_EVENTS \
+	(ZVFS_EPOLLIN | ZVFS_EPOLLOUT | ZVFS_EPOLLERR | ZVFS_EPOLLHUP)
+
+/* Events taken at once from the poll set of an instance */
+#define ZVFS_EPOLL_BATCH 8
+
+BUILD_ASSERT(ZVFS_EPOLLIN == ZSOCK_POLLIN && ZVFS_EPOLLOUT == ZSOCK_POLLOUT &&
+	     ZVFS_EPOLLERR == ZSOCK_POLLERR && ZVFS_EPOLLHUP == ZSOCK_POLLHUP);
+
+struct zvfs_epoll_entry {
+	/* in zvfs_epoll::entries */
+	sys_dnode_t node;
+	/* in zvfs_epoll::always, when linked */
+	sys_dnode_t always_node;
+	struct zsock_pollfd pfd;
+	void *obj;
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	union zvfs_epoll_data data;
+	/* last zvfs_epoll::round the entry was checked in */
+	uint32_t round;
+	uint8_t num_events;
+	/* set up by ZFD_IOCTL_POLL_PREPARE, tagged with their index */
+	struct k_poll_event pev[2];
+};
+
+struct zvfs_epoll {
+	struct k_poll_set set;
+	sys_dlist_t entries;
+	/* entries reported without waiting for their events */
+	sys_dlist_t always;
+	struct k_mutex lock;
+	uint32_t round;
+	int num_events;
+	bool in_use;
+};
+
+static struct zvfs_epoll epolls[CONFIG_ZVFS_EPOLL_MAX];
+/* Protects zvfs_epoll::in_use, taken before the lock of an instance */
+static K_MUTEX_DEFINE(epolls_lock);
+K_MEM_SLAB_DEFINE_STATIC(epoll_entries_slab, sizeof(struct zvfs_epoll_entry),
+			 CONFIG_ZVFS_EPOLL_ENTRIES_MAX, sizeof(void *));
+static const struct fd_op_vtable zvfs_epoll_fd_vtable;
+
+static struct zvfs_epoll_entry *zvfs_epoll_find(struct zvfs_epoll *ep, int fd)
+{
+	struct zvfs_epoll_entry *entry;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&ep->entries, entry, node) {
+		if (entry->pfd.fd == fd) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static int zvfs_epoll_entry_arm(struct zvfs_epoll *ep,
+				struct zvfs_epoll_entry *entry)
+{
+	struct k_poll_event *pev = entry->pev;
+	int ret;
+
+	if (entry->vtable->ioctl == NULL) {
+		return -EPERM;
+	}
+
+	(void)k_mutex_lock(entry->lock, K_FOREVER);
+	ret = zvfs_fdtable_call_ioctl(entry->vtable, entry->obj,
+				      ZFD_IOCTL_POLL_PREPARE, &entry->pfd, &pev,
+				      entry->pev + ARRAY_SIZE(entry->pev));
+	k_mutex_unlock(entry->lock);
+
+	if (ret == -EALREADY) {
+		/* Ready already, or ready for good such as a socket at EOF:
+		 * check it on each wait, along with its events if any.
+		 */
+		sys_dlist_append(&ep->always, &entry->always_node);
+	} else if (ret < 0) {
+		/* Neither pollable, nor an offloaded socket (-EXDEV), which
+		 * can only be polled by its offload poll as a whole.
+		 */
+		return -EPERM;
+	}
+
+	entry->num_events = pev - entry->pev;
+	for (int i = 0; i < entry->num_events; i++) {
+		entry->pev[i].tag = i;
+		ret = k_poll_set_add(&ep->set, &entry->pev[i]);
+		__ASSERT(ret == 0, "k_poll_set_add() failed: %d", ret);
+	}
+	ep->num_events += entry->num_events;
+
+	return 0;
+}
+
+static void zvfs_epoll_entry_disarm(struct zvfs_epoll *ep,
+				    struct zvfs_epoll_entry *entry)
+{
+	for (int i = 0; i < entry->num_events; i++) {
+		(void)k_poll_set_remove(&ep->set, &entry->pev[i]);
+	}
+	ep->num_events -= entry->num_events;
+	entry->num_events = 0;
+
+	if (sys_dnode_is_linked(&entry->always_node)) {
+		sys_dlist_remove(&entry->always_node);
+	}
+}
+
+static void zvfs_epoll_entry_set(struct zvfs_epoll_entry *entry,
+				 const struct zvfs_epoll_event *event)
+{
+	entry->pfd.events = event->events & (ZSOCK_POLLIN | ZSOCK_POLLOUT);
+	entry->data = event->data;
+}
+
+static int zvfs_epoll_entry_add(struct zvfs_epoll *ep, int fd,
+				const struct zvfs_epoll_event *event)
+{
+	struct zvfs_epoll_entry *entry;
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	obj = zvfs_get_fd_obj_and_vtable(fd, &vtable, &lock);
+	if (obj == NULL) {
+		return -EBADF;
+	}
+
+	if (vtable == &zvfs_epoll_fd_vtable) {
+		/* Nested instances are not supported */
+		return -EINVAL;
+	}
+
+	if (k_mem_slab_alloc(&epoll_entries_slab, (void **)&entry,
+			     K_NO_WAIT) != 0) {
+		return -ENOSPC;
+	}
+
+	memset(entry, 0, sizeof(*entry));
+	entry->pfd.fd = fd;
+	entry->obj = obj;
+	entry->vtable = vtable;
+	entry->lock = lock;
+	zvfs_epoll_entry_set(entry, event);
+
+	ret = zvfs_epoll_entry_arm(ep, entry);
+	if (ret < 0) {
+		k_mem_slab_free(&epoll_entries_slab, entry);
+		return ret;
+	}
+
+	sys_dlist_append(&ep->entries, &entry->node);
+
+	return 0;
+}
+
+static void zvfs_epoll_entry_free(struct zvfs_epoll *ep,
+				  struct zvfs_epoll_entry *entry)
+{
+	zvfs_epoll_entry_disarm(ep, entry);
+	sys_dlist_remove(&entry->node);
+	k_mem_slab_free(&epoll_entries_slab, entry);
+}
+
+/* Returns 1 and fills @a event if the entry is ready, 0 otherwise */
+static int zvfs_epoll_entry_report(struct zvfs_epoll *ep,
+				   struct zvfs_epoll_entry *entry,
+				   struct zvfs_epoll_event *event)
+{
+	struct k_poll_event cur[ARRAY_SIZE(entry->pev)];
+	struct k_poll_event *pev = cur;
+	int ret;
+
+	entry->round = ep->round;
+	entry->pfd.revents = 0;
+
+	/* The states of the events in the poll set are those of the last time
+	 * they were taken from it, which is never for an entry reported
+	 * without waiting: check the objects anew. A cancellation is only
+	 * known from the poll set.
+	 */
+	for (int i = 0; i < entry->num_events; i++) {
+		k_poll_event_init(&cur[i], entry->pev[i].type,
+				  K_POLL_MODE_NOTIFY_ONLY, entry->pev[i].obj);
+	}
+	if (entry->num_events > 0) {
+		(void)k_poll(cur, entry->num_events, K_NO_WAIT);
+	}
+	for (int i = 0; i < entry->num_events; i++) {
+		cur[i].state |= entry->pev[i].state & K_POLL_STATE_CANCELLED;
+	}
+
+	(void)k_mutex_lock(entry->lock, K_FOREVER);
+	ret = zvfs_fdtable_call_ioctl(entry->vtable, entry->obj,
+				      ZFD_IOCTL_POLL_UPDATE, &entry->pfd, &pev);
+	k_mutex_unlock(entry->lock);
+
+	/* -EAGAIN: not ready after all */
+	if ((ret != 0) || (entry->pfd.revents == 0)) {
+		return 0;
+	}
+
+	/* An error or a hang-up is reported until the file descriptor is
+	 * closed, while its events may have been signaled only once.
+	 */
+	if (((entry->pfd.revents & (ZSOCK_POLLERR | ZSOCK_POLLHUP)) != 0) &&
+	    !sys_dnode_is_linked(&entry->always_node)) {
+		sys_dlist_append(&ep->always, &entry->always_node);
+	}
+
+	event->events = entry->pfd.revents;
+	event->data = entry->data;
+
+	return 1;
+}
+
+static int zvfs_epoll_collect(struct zvfs_epoll *ep,
+			      struct zvfs_epoll_event *events, int maxevents)
+{
+	struct k_poll_event *ready[ZVFS_EPOLL_BATCH];
+	struct zvfs_epoll_entry *entry;
+	/* The events ready are put back in the poll set: take each once */
+	int budget = ep->num_events;
+	int n = 0;
+
+	ep->round++;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&ep->always, entry, always_node) {
+		if (n == maxevents) {
+			return n;
+		}
+
+		n += zvfs_epoll_entry_report(ep, entry, &events[n]);
+	}
+
+	while ((n < maxevents) && (budget > 0)) {
+		int ret;
+
+		ret = k_poll_set_wait(&ep->set, ready,
+				      MIN(MIN(budget, maxevents - n),
+					  ARRAY_SIZE(ready)),
+				      K_NO_WAIT);
+		if (ret <= 0) {
+			break;
+		}
+
+		budget -= ret;
+
+		for (int i = 0; (i < ret) && (n < maxevents); i++) {
+			entry = CONTAINER_OF(ready[i] - ready[i]->tag,
+					     struct zvfs_epoll_entry, pev[0]);
+
+			/* Both events of the entry may be ready */
+			if (entry->round != ep->round) {
+				n += zvfs_epoll_entry_report(ep, entry,
+							     &events[n]);
+			}
+		}
+	}
+
+	return n;
+}
+
+static int zvfs_epoll_close_op(void *obj)
+{
+	struct zvfs_epoll *ep = obj;
+	struct zvfs_epoll_entry *entry;
+	struct zvfs_epoll_entry *next;
+
+	(void)k_mutex_lock(&epolls_lock, K_FOREVER);
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->entries, entry, next, node) {
+		zvfs_epoll_entry_free(ep, entry);
+	}
+	ep->in_use = false;
+
+	k_mutex_unlock(&ep->lock);
+	k_mutex_unlock(&epolls_lock);
+
+	return 0;
+}
+
+static int zvfs_epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable = {
+	.close = zvfs_epoll_close_op,
+	.ioctl = zvfs_epoll_ioctl_op,
+};
+
+/*
+ * Public-facing API
+ */
+
+int zvfs_epoll_create1(int flags)
+{
+	struct zvfs_epoll *ep = NULL;
+	int fd;
+
+	if ((flags & ~ZVFS_EPOLL_CLOEXEC) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&epolls_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (!epolls[i].in_use) {
+			ep = &epolls[i];
+			break;
+		}
+	}
+
+	if (ep == NULL) {
+		k_mutex_unlock(&epolls_lock);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		k_mutex_unlock(&epolls_lock);
+		return -1;
+	}
+
+	k_poll_set_init(&ep->set);
+	sys_dlist_init(&ep->entries);
+	sys_dlist_init(&ep->always);
+	k_mutex_init(&ep->lock);
+	ep->num_events = 0;
+	ep->in_use = true;
+
+	k_mutex_unlock(&epolls_lock);
+
+	zvfs_finalize_fd(fd, ep, &zvfs_epoll_fd_vtable);
+
+	return fd;
+}
+
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event)
+{
+	struct zvfs_epoll_entry *entry;
+	struct zvfs_epoll *ep;
+	int ret;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if ((op != ZVFS_EPOLL_CTL_DEL) &&
+	    ((event == NULL) || ((event->events & ~ZVFS_EPOLL_EVENTS) != 0))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	entry = zvfs_epoll_find(ep, fd);
+
+	switch (op) {
+	case ZVFS_EPOLL_CTL_ADD:
+		if (entry != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		ret = zvfs_epoll_entry_add(ep, fd, event);
+		break;
+
+	case ZVFS_EPOLL_CTL_MOD:
+		if (entry == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_entry_disarm(ep, entry);
+		zvfs_epoll_entry_set(entry, event);
+		ret = zvfs_epoll_entry_arm(ep, entry);
+		if (ret < 0) {
+			zvfs_epoll_entry_free(ep, entry);
+		}
+		break;
+
+	case ZVFS_EPOLL_CTL_DEL:
+		if (entry == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_entry_free(ep, entry);
+		ret = 0;
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents,
+		    int timeout)
+{
+	struct zvfs_epoll *ep;
+	k_timepoint_t end;
+	int ret;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if ((events == NULL) || (maxevents <= 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc((timeout < 0) ? K_FOREVER : K_MSEC(timeout));
+
+	while (true) {
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+		ret = zvfs_epoll_collect(ep, events, maxevents);
+		k_mutex_unlock(&ep->lock);
+
+		if (ret > 0) {
+			return ret;
+		}
+
+		/* Wait for an event without taking it, nor holding the lock
+		 * of the instance, then check the file descriptors again.
+		 */
+		ret = k_poll_set_wait(&ep->set, NULL, 0,
+				      sys_timepoint_timeout(end));
+		if (ret == -EAGAIN) {
+			return 0;
+		}
+	}
+}
+
+void zvfs_epoll_fd_close(int fd)
+{
+	struct zvfs_epoll_entry *entry;
+
+	(void)k_mutex_lock(&epolls_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(epolls); i++) {
+		struct zvfs_epoll *ep = &epolls[i];
+
+		if (!ep->in_use) {
+			continue;
+		}
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+		entry = zvfs_epoll_find(ep, fd);
+		if (entry != NULL) {
+			zvfs_epoll_entry_free(ep, entry);
+		}
+		k_mutex_unlock(&ep->lock);
+	}
+
+	k_mutex_unlock(&epolls_lock);
+}
@@ -7,76 +7,601 @@
 #include <errno.h>
 #include <signal.h>
 
+#include <zephyr/kernel.h>
 #include <zephyr/posix/aio.h>
+#include <zephyr/posix/fcntl.h>
+#include <zephyr/sys/dlist.h>
+
+ssize_t zvfs_pread(int fd, void *buf, size_t sz, size_t offset);
+ssize_t zvfs_pwrite(int fd, const void *buf, size_t sz, size_t offset);
+int zvfs_fsync(int fd);
+
+/* Operation of aio_fsync(), besides the LIO_* ones */
+#define AIO_OP_FSYNC -1
+
+enum aio_state {
+	AIO_STATE_FREE,
+	AIO_STATE_QUEUED,
+	AIO_STATE_RUNNING,
+	AIO_STATE_DONE,
+};
+
+/* Completion of the operations of a lio_listio() call */
+struct aio_lio {
+	struct sigevent sig;
+	int pending;
+	bool used;
+};
+
+struct aio_req {
+	sys_dnode_t node;
+	struct aiocb *aiocbp;
+	struct aio_lio *lio;
+	enum aio_state state;
+	int op;
+	int prio;
+	int err;
+	ssize_t ret;
+};
+
+static struct aio_req aio_reqs[CONFIG_POSIX_AIO_MAX];
+static struct aio_lio aio_lios[CONFIG_POSIX_AIO_MAX];
+static sys_dlist_t aio_queue = SYS_DLIST_STATIC_INIT(&aio_queue);
+static K_MUTEX_DEFINE(aio_lock);
+/* Signaled when operations are queued */
+static K_CONDVAR_DEFINE(aio_queued);
+/* Signaled when operations complete */
+static K_CONDVAR_DEFINE(aio_done);
+
+static K_THREAD_STACK_ARRAY_DEFINE(aio_stacks, CONFIG_POSIX_AIO_WORKERS,
+				   CONFIG_POSIX_AIO_WORKER_STACK_SIZE);
+static struct k_thread aio_threads[CONFIG_POSIX_AIO_WORKERS];
+static bool aio_started;
+
+static struct aio_req *aio_find(const struct aiocb *aiocbp)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(aio_reqs); i++) {
+		if (aio_reqs[i].state != AIO_STATE_FREE && aio_reqs[i].aiocbp == aiocbp) {
+			return &aio_reqs[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Signals are not generated, only SIGEV_NONE and SIGEV_THREAD notifications are supported */
+static bool aio_sigevent_valid(const struct sigevent *sig)
+{
+	switch (sig->sigev_notify) {
+	case SIGEV_NONE:
+		return true;
+	case SIGEV_THREAD:
+		return sig->sigev_notify_function != NULL;
+	default:
+		return false;
+	}
+}
+
+static void aio_notify(const struct sigevent *sig)
+{
+	if (sig->sigev_notify == SIGEV_THREAD) {
+		sig->sigev_notify_function(sig->sigev_value);
+	}
+}
+
+/*
+ * Called with aio_lock held, returns the lio_listio() completion to notify if
+ * this was the last operation of its list.
+ */
+static struct aio_lio *aio_complete(struct aio_req *req, ssize_t ret, int err)
+{
+	struct aio_lio *lio = req->lio;
+
+	req->state = AIO_STATE_DONE;
+	req->ret = ret;
+	req->err = err;
+	req->lio = NULL;
+
+	k_condvar_broadcast(&aio_done);
+
+	if ((lio == NULL) || (--lio->pending > 0)) {
+		return NULL;
+	}
+
+	return lio;
+}
+
+static void aio_notify_lio(struct aio_lio *lio)
+{
+	if (lio == NULL) {
+		return;
+	}
+
+	aio_notify(&lio->sig);
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	lio->used = false;
+	k_mutex_unlock(&aio_lock);
+}
+
+static ssize_t aio_perform(const struct aiocb *aiocbp, int op)
+{
+	/* The buffer is not accessed by anything else while the operation is in progress */
+	void *buf = (void *)aiocbp->aio_buf;
+
+	switch (op) {
+	case LIO_READ:
+		return zvfs_pread(aiocbp->aio_fildes, buf, aiocbp->aio_nbytes, aiocbp->aio_offset);
+	case LIO_WRITE:
+		return zvfs_pwrite(aiocbp->aio_fildes, buf, aiocbp->aio_nbytes,
+				   aiocbp->aio_offset);
+	default:
+		return zvfs_fsync(aiocbp->aio_fildes);
+	}
+}
+
+static void aio_worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		struct aio_req *req;
+		struct aio_lio *lio;
+		struct sigevent sig;
+		ssize_t ret;
+		int err;
+
+		/* Idle workers preempt the submitters, to start the operations at once */
+		k_thread_priority_set(k_current_get(), K_HIGHEST_APPLICATION_THREAD_PRIO);
+
+		(void)k_mutex_lock(&aio_lock, K_FOREVER);
+		while (sys_dlist_is_empty(&aio_queue)) {
+			(void)k_condvar_wait(&aio_queued, &aio_lock, K_FOREVER);
+		}
+
+		req = CONTAINER_OF(sys_dlist_get(&aio_queue), struct aio_req, node);
+		req->state = AIO_STATE_RUNNING;
+		k_thread_priority_set(k_current_get(), req->prio);
+		k_mutex_unlock(&aio_lock);
+
+		ret = aio_perform(req->aiocbp, req->op);
+		err = (ret < 0) ? errno : 0;
+
+		/* The control block may be reused as soon as the operation is done */
+		sig = req->aiocbp->aio_sigevent;
+
+		(void)k_mutex_lock(&aio_lock, K_FOREVER);
+		lio = aio_complete(req, ret, err);
+		k_mutex_unlock(&aio_lock);
+
+		aio_notify(&sig);
+		aio_notify_lio(lio);
+	}
+}
+
+/* Called with aio_lock held */
+static void aio_start_workers(void)
+{
+	if (aio_started) {
+		return;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(aio_threads); i++) {
+		k_thread_create(&aio_threads[i], aio_stacks[i],
+				K_THREAD_STACK_SIZEOF(aio_stacks[i]), aio_worker, NULL, NULL, NULL,
+				K_HIGHEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+		k_thread_name_set(&aio_threads[i], "aio");
+	}
+
+	aio_started = true;
+}
+
+/*
+ * Lets the workers start the operations just queued when the submitting thread
+ * is cooperative, so that they are overlapped with what follows while they
+ * wait for the device. Preemptible threads are preempted by the workers.
+ */
+static void aio_yield(void)
+{
+	if (!k_is_in_isr() && !k_is_preempt_thread()) {
+		k_yield();
+	}
+}
+
+static int aio_check(const struct aiocb *aiocbp, int op)
+{
+	if ((aiocbp == NULL) || (aiocbp->aio_reqprio < 0) ||
+	    (aiocbp->aio_reqprio > AIO_PRIO_DELTA_MAX) ||
+	    ((op != AIO_OP_FSYNC) && (aiocbp->aio_offset < 0)) ||
+	    !aio_sigevent_valid(&aiocbp->aio_sigevent)) {
+		return EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * Called with aio_lock held. Returns a free request, or the one of a control
+ * block submitted again after it completed.
+ */
+static struct aio_req *aio_alloc(struct aiocb *aiocbp)
+{
+	struct aio_req *req = aio_find(aiocbp);
+
+	if (req != NULL) {
+		return (req->state == AIO_STATE_DONE) ? req : NULL;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(aio_reqs); i++) {
+		if (aio_reqs[i].state == AIO_STATE_FREE) {
+			return &aio_reqs[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Called with aio_lock held, queues by priority then in order of submission */
+static void aio_queue_req(struct aio_req *req, struct aiocb *aiocbp, int op,
+			  struct aio_lio *lio)
+{
+	struct aio_req *next;
+	/* Just above the submitting thread, so that the operation starts before it goes on */
+	int prio = k_thread_priority_get(k_current_get()) - 1 + aiocbp->aio_reqprio;
+
+	*req = (struct aio_req){
+		.aiocbp = aiocbp,
+		.lio = lio,
+		.state = AIO_STATE_QUEUED,
+		.op = op,
+		.prio = CLAMP(prio, K_HIGHEST_APPLICATION_THREAD_PRIO,
+			      K_LOWEST_APPLICATION_THREAD_PRIO),
+		.err = EINPROGRESS,
+		.ret = -1,
+	};
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&aio_queue, next, node) {
+		if (next->prio > req->prio) {
+			sys_dlist_insert(&next->node, &req->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&aio_queue, &req->node);
+}
+
+static int aio_submit(struct aiocb *aiocbp, int op)
+{
+	struct aio_req *req;
+	int err;
+
+	err = aio_check(aiocbp, op);
+	if (err != 0) {
+		errno = err;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	req = aio_alloc(aiocbp);
+	if (req == NULL) {
+		k_mutex_unlock(&aio_lock);
+		errno = EAGAIN;
+		return -1;
+	}
+
+	aio_start_workers();
+	aio_queue_req(req, aiocbp, op, NULL);
+	k_condvar_signal(&aio_queued);
+	k_mutex_unlock(&aio_lock);
+
+	aio_yield();
+
+	return 0;
+}
 
 int aio_cancel(int fildes, struct aiocb *aiocbp)
 {
-	ARG_UNUSED(fildes);
-	ARG_UNUSED(aiocbp);
+	bool canceled = false;
+	bool not_canceled = false;
+	size_t i = 0;
 
-	errno = ENOSYS;
-	return -1;
+	if ((aiocbp != NULL) && (aiocbp->aio_fildes != fildes)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	while (i < ARRAY_SIZE(aio_reqs)) {
+		struct aio_req *req = &aio_reqs[i++];
+		struct aio_lio *lio;
+		struct sigevent sig;
+
+		if ((req->state == AIO_STATE_FREE) || (req->aiocbp->aio_fildes != fildes) ||
+		    ((aiocbp != NULL) && (req->aiocbp != aiocbp))) {
+			continue;
+		}
+
+		if (req->state == AIO_STATE_RUNNING) {
+			not_canceled = true;
+		} else if (req->state == AIO_STATE_QUEUED) {
+			sys_dlist_remove(&req->node);
+			sig = req->aiocbp->aio_sigevent;
+			lio = aio_complete(req, -1, ECANCELED);
+			canceled = true;
+
+			/*
+			 * Notified without the lock, as from the workers. The requests
+			 * already looked at may have changed meanwhile, they are not
+			 * looked at again.
+			 */
+			k_mutex_unlock(&aio_lock);
+			aio_notify(&sig);
+			aio_notify_lio(lio);
+			(void)k_mutex_lock(&aio_lock, K_FOREVER);
+		}
+	}
+	k_mutex_unlock(&aio_lock);
+
+	if (not_canceled) {
+		return AIO_NOTCANCELED;
+	}
+
+	return canceled ? AIO_CANCELED : AIO_ALLDONE;
 }
 
 int aio_error(const struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
+	struct aio_req *req;
+	int err;
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	req = aio_find(aiocbp);
+	err = (req != NULL) ? req->err : EINVAL;
+	k_mutex_unlock(&aio_lock);
+
+	if (req == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
 
-	errno = ENOSYS;
-	return -1;
+	return err;
 }
 
-int aio_fsync(int fildes, struct aiocb *aiocbp)
+int aio_fsync(int op, struct aiocb *aiocbp)
 {
-	ARG_UNUSED(fildes);
-	ARG_UNUSED(aiocbp);
+	if ((op != O_SYNC) && (op != O_DSYNC)) {
+		errno = EINVAL;
+		return -1;
+	}
 
-	errno = ENOSYS;
-	return -1;
+	return aio_submit(aiocbp, AIO_OP_FSYNC);
 }
 
 int aio_read(struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
-
-	errno = ENOSYS;
-	return -1;
+	return aio_submit(aiocbp, LIO_READ);
 }
 
 ssize_t aio_return(struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
+	struct aio_req *req;
+	ssize_t ret = -1;
+	int err = EINVAL;
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	req = aio_find(aiocbp);
+	if ((req != NULL) && (req->state == AIO_STATE_DONE)) {
+		ret = req->ret;
+		err = req->err;
+		req->state = AIO_STATE_FREE;
+	}
+	k_mutex_unlock(&aio_lock);
 
-	errno = ENOSYS;
-	return -1;
+	if (ret < 0) {
+		errno = err;
+	}
+
+	return ret;
+}
+
+/* Called with aio_lock held */
+static bool aio_any_done(const struct aiocb *const list[], int nent)
+{
+	for (int i = 0; i < nent; i++) {
+		struct aio_req *req;
+
+		if (list[i] == NULL) {
+			continue;
+		}
+
+		req = aio_find(list[i]);
+		if ((req == NULL) || (req->state == AIO_STATE_DONE)) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 int aio_suspend(const struct aiocb *const list[], int nent, const struct timespec *timeout)
 {
-	ARG_UNUSED(list);
-	ARG_UNUSED(nent);
-	ARG_UNUSED(timeout);
+	k_timepoint_t end;
+	int ret = 0;
+
+	if ((list == NULL) || (nent <= 0) || (nent > AIO_LISTIO_MAX)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (timeout == NULL) {
+		end = sys_timepoint_calc(K_FOREVER);
+	} else {
+		end = sys_timepoint_calc(K_NSEC((int64_t)timeout->tv_sec * NSEC_PER_SEC +
+						timeout->tv_nsec));
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	while (!aio_any_done(list, nent)) {
+		if (k_condvar_wait(&aio_done, &aio_lock, sys_timepoint_timeout(end)) != 0) {
+			errno = EAGAIN;
+			ret = -1;
+			break;
+		}
+	}
+	k_mutex_unlock(&aio_lock);
 
-	errno = ENOSYS;
-	return -1;
+	return ret;
 }
 
 int aio_write(struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
+	return aio_submit(aiocbp, LIO_WRITE);
+}
+
+/* Called with aio_lock held */
+static bool aio_all_done(struct aiocb *const ZRESTRICT list[], int nent)
+{
+	for (int i = 0; i < nent; i++) {
+		struct aio_req *req;
+
+		if ((list[i] == NULL) || (list[i]->aio_lio_opcode == LIO_NOP)) {
+			continue;
+		}
+
+		req = aio_find(list[i]);
+		if ((req != NULL) && (req->state != AIO_STATE_DONE)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static struct aio_lio *aio_lio_alloc(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(aio_lios); i++) {
+		if (!aio_lios[i].used) {
+			return &aio_lios[i];
+		}
+	}
 
-	errno = ENOSYS;
-	return -1;
+	return NULL;
 }
 
+/*
+ * The operations of the list are queued at once, waking up as many workers as
+ * needed.
+ */
 int lio_listio(int mode, struct aiocb *const ZRESTRICT list[], int nent,
 	       struct sigevent *ZRESTRICT sig)
 {
-	ARG_UNUSED(mode);
-	ARG_UNUSED(list);
-	ARG_UNUSED(nent);
-	ARG_UNUSED(sig);
+	struct aio_req *reqs[CONFIG_POSIX_AIO_LISTIO_MAX];
+	struct aio_lio *lio = NULL;
+	int num = 0;
+	int err = 0;
+
+	if (((mode != LIO_WAIT) && (mode != LIO_NOWAIT)) || (list == NULL) || (nent <= 0) ||
+	    (nent > AIO_LISTIO_MAX) ||
+	    ((mode == LIO_NOWAIT) && (sig != NULL) && !aio_sigevent_valid(sig))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	for (int i = 0; i < nent; i++) {
+		if ((list[i] == NULL) || (list[i]->aio_lio_opcode == LIO_NOP)) {
+			continue;
+		}
+
+		if (((list[i]->aio_lio_opcode != LIO_READ) &&
+		     (list[i]->aio_lio_opcode != LIO_WRITE)) ||
+		    (aio_check(list[i], list[i]->aio_lio_opcode) != 0)) {
+			errno = EINVAL;
+			return -1;
+		}
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	for (int i = 0; i < nent; i++) {
+		if ((list[i] == NULL) || (list[i]->aio_lio_opcode == LIO_NOP)) {
+			continue;
+		}
+
+		reqs[num] = aio_alloc(list[i]);
+		if (reqs[num] == NULL) {
+			err = EAGAIN;
+			break;
+		}
+
+		/* Reserved until queued */
+		reqs[num]->state = AIO_STATE_QUEUED;
+		reqs[num]->aiocbp = list[i];
+		num++;
+	}
+
+	if ((err == 0) && (mode == LIO_NOWAIT) && (sig != NULL) &&
+	    (sig->sigev_notify == SIGEV_THREAD) && (num > 0)) {
+		lio = aio_lio_alloc();
+		if (lio == NULL) {
+			err = EAGAIN;
+		} else {
+			lio->sig = *sig;
+			lio->pending = num;
+			lio->used = true;
+		}
+	}
+
+	if (err != 0) {
+		/* None of the operations is queued */
+		for (int i = 0; i < num; i++) {
+			reqs[i]->state = AIO_STATE_FREE;
+		}
+		k_mutex_unlock(&aio_lock);
+		errno = err;
+		return -1;
+	}
+
+	if (num > 0) {
+		aio_start_workers();
+	}
+
+	for (int i = 0; i < num; i++) {
+		aio_queue_req(reqs[i], reqs[i]->aiocbp, reqs[i]->aiocbp->aio_lio_opcode, lio);
+	}
+
+	for (int i = 0; i < MIN(num, CONFIG_POSIX_AIO_WORKERS); i++) {
+		k_condvar_signal(&aio_queued);
+	}
+
+	if (mode == LIO_NOWAIT) {
+		k_mutex_unlock(&aio_lock);
+		aio_yield();
+		return 0;
+	}
+
+	while (!aio_all_done(list, nent)) {
+		(void)k_condvar_wait(&aio_done, &aio_lock, K_FOREVER);
+	}
+
+	for (int i = 0; i < nent; i++) {
+		struct aio_req *req;
+
+		if ((list[i] == NULL) || (list[i]->aio_lio_opcode == LIO_NOP)) {
+			continue;
+		}
+
+		req = aio_find(list[i]);
+		if ((req != NULL) && (req->err != 0)) {
+			err = EIO;
+		}
+	}
+	k_mutex_unlock(&aio_lock);
+
+	if (err != 0) {
+		errno = err;
+		return -1;
+	}
 
-	errno = ENOSYS;
-	return -1;
+	return 0;
 }
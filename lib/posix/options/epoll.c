@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/posix/sys/epoll.h>
+#include <zephyr/zvfs/epoll.h>
+
+int epoll_create(int size)
+{
+	if (size <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return zvfs_epoll_create1(0);
+}
+
+int epoll_create1(int flags)
+{
+	return zvfs_epoll_create1(flags);
+}
+
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+	return zvfs_epoll_ctl(epfd, op, fd, event);
+}
+
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
+{
+	return zvfs_epoll_wait(epfd, events, maxevents, timeout);
+}
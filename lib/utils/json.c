@@ -1175,3 +1175,567 @@ ssize_t json_calc_encoded_arr_len(const struct json_obj_descr *descr,
 
 	return total;
 }
+
+enum json_stream_expect {
+	STREAM_VALUE,
+	STREAM_VALUE_OR_END,
+	STREAM_KEY,
+	STREAM_KEY_OR_END,
+	STREAM_COLON,
+	STREAM_COMMA_OR_END,
+	STREAM_DONE,
+	STREAM_ERROR,
+};
+
+/* State of an escape sequence, after the backslash. 1 to 4 are the number of
+ * hexadecimal digits left in \u sequences.
+ */
+#define STREAM_ESC_START 5
+
+void json_stream_parser_init(struct json_stream_parser *parser, char *buf,
+			     size_t buf_size)
+{
+	*parser = (struct json_stream_parser) {
+		.buf = buf,
+		.buf_size = buf_size,
+		.expect = STREAM_VALUE,
+		.lex = JSON_TOK_NONE,
+	};
+}
+
+void json_stream_parser_feed(struct json_stream_parser *parser,
+			     const char *data, size_t len)
+{
+	parser->pos = data;
+	parser->end = data + len;
+	parser->last = (len == 0);
+}
+
+static int stream_error(struct json_stream_parser *parser, int err)
+{
+	parser->expect = STREAM_ERROR;
+
+	return err;
+}
+
+static bool stream_in_obj(struct json_stream_parser *parser)
+{
+	return (parser->nesting & BIT(parser->depth - 1)) != 0;
+}
+
+static enum json_stream_expect stream_after_value(struct json_stream_parser *parser)
+{
+	return (parser->depth == 0) ? STREAM_DONE : STREAM_COMMA_OR_END;
+}
+
+/* Keeps the start of a token, up to the end of the chunk, for the next one */
+static int stream_save(struct json_stream_parser *parser, const char *start)
+{
+	size_t len = parser->end - start;
+
+	if (parser->last) {
+		return stream_error(parser, -EINVAL);
+	}
+
+	if (len > parser->buf_size - parser->buf_len) {
+		return stream_error(parser, -ENOMEM);
+	}
+
+	memcpy(&parser->buf[parser->buf_len], start, len);
+	parser->buf_len += len;
+
+	return -EAGAIN;
+}
+
+static int stream_emit(struct json_stream_parser *parser,
+		       struct json_stream_token *tok,
+		       const char *start, const char *end)
+{
+	size_t len = end - start;
+
+	tok->type = (enum json_tokens)parser->lex;
+	tok->key = (parser->expect == STREAM_COLON);
+
+	if (parser->buf_len == 0) {
+		tok->start = start;
+		tok->length = len;
+	} else {
+		if (len > parser->buf_size - parser->buf_len) {
+			return stream_error(parser, -ENOMEM);
+		}
+
+		memcpy(&parser->buf[parser->buf_len], start, len);
+		tok->start = parser->buf;
+		tok->length = parser->buf_len + len;
+		parser->buf_len = 0;
+	}
+
+	parser->lex = JSON_TOK_NONE;
+
+	return 0;
+}
+
+static int stream_string(struct json_stream_parser *parser,
+			 struct json_stream_token *tok)
+{
+	const char *start = parser->pos;
+
+	for (; parser->pos < parser->end; parser->pos++) {
+		char chr = *parser->pos;
+
+		if (parser->lex_pos == 0) {
+			if (chr == '"') {
+				return stream_emit(parser, tok, start, parser->pos++);
+			}
+
+			if (chr == '\\') {
+				parser->lex_pos = STREAM_ESC_START;
+			}
+
+			continue;
+		}
+
+		if (parser->lex_pos == STREAM_ESC_START) {
+			switch (chr) {
+			case '"':
+			case '\\':
+			case '/':
+			case 'b':
+			case 'f':
+			case 'n':
+			case 'r':
+			case 't':
+				parser->lex_pos = 0;
+				break;
+			case 'u':
+				parser->lex_pos = 4;
+				break;
+			default:
+				return stream_error(parser, -EINVAL);
+			}
+
+			continue;
+		}
+
+		if (isxdigit((unsigned char)chr) == 0) {
+			return stream_error(parser, -EINVAL);
+		}
+
+		parser->lex_pos--;
+	}
+
+	return stream_save(parser, start);
+}
+
+static bool stream_number_char(char chr)
+{
+	return (isdigit((unsigned char)chr) != 0) || chr == '.' || chr == '-' ||
+	       chr == '+' || chr == 'e' || chr == 'E';
+}
+
+static int stream_number(struct json_stream_parser *parser,
+			 struct json_stream_token *tok)
+{
+	const char *start = parser->pos;
+
+	while (parser->pos < parser->end && stream_number_char(*parser->pos)) {
+		parser->pos++;
+	}
+
+	/* A number only ends with the character after it */
+	if (parser->pos == parser->end && !parser->last) {
+		return stream_save(parser, start);
+	}
+
+	return stream_emit(parser, tok, start, parser->pos);
+}
+
+static int stream_literal(struct json_stream_parser *parser,
+			  struct json_stream_token *tok)
+{
+	const char *lit;
+
+	switch (parser->lex) {
+	case JSON_TOK_TRUE:
+		lit = "true";
+		break;
+	case JSON_TOK_FALSE:
+		lit = "false";
+		break;
+	default:
+		lit = "null";
+		break;
+	}
+
+	while (lit[parser->lex_pos] != '\0') {
+		if (parser->pos == parser->end) {
+			return parser->last ? stream_error(parser, -EINVAL) : -EAGAIN;
+		}
+
+		if (*parser->pos++ != lit[parser->lex_pos++]) {
+			return stream_error(parser, -EINVAL);
+		}
+	}
+
+	return stream_emit(parser, tok, lit, lit + parser->lex_pos);
+}
+
+static int stream_lex(struct json_stream_parser *parser,
+		      struct json_stream_token *tok)
+{
+	switch (parser->lex) {
+	case JSON_TOK_STRING:
+		return stream_string(parser, tok);
+	case JSON_TOK_NUMBER:
+		return stream_number(parser, tok);
+	default:
+		return stream_literal(parser, tok);
+	}
+}
+
+/* Starts a string, a number or a literal */
+static int stream_start(struct json_stream_parser *parser,
+			struct json_stream_token *tok, enum json_tokens type)
+{
+	if (type == JSON_TOK_STRING && (parser->expect == STREAM_KEY ||
+					parser->expect == STREAM_KEY_OR_END)) {
+		parser->expect = STREAM_COLON;
+	} else if (parser->expect == STREAM_VALUE ||
+		   parser->expect == STREAM_VALUE_OR_END) {
+		parser->expect = stream_after_value(parser);
+	} else {
+		return stream_error(parser, -EINVAL);
+	}
+
+	parser->lex = type;
+	parser->lex_pos = 0;
+
+	return stream_lex(parser, tok);
+}
+
+static int stream_open(struct json_stream_parser *parser,
+		       struct json_stream_token *tok, enum json_tokens type)
+{
+	if (parser->expect != STREAM_VALUE && parser->expect != STREAM_VALUE_OR_END) {
+		return stream_error(parser, -EINVAL);
+	}
+
+	if (parser->depth == JSON_STREAM_MAX_DEPTH) {
+		return stream_error(parser, -EINVAL);
+	}
+
+	WRITE_BIT(parser->nesting, parser->depth, type == JSON_TOK_OBJECT_START);
+	parser->depth++;
+	parser->expect = (type == JSON_TOK_OBJECT_START) ? STREAM_KEY_OR_END :
+							   STREAM_VALUE_OR_END;
+
+	*tok = (struct json_stream_token) { .type = type };
+
+	return 0;
+}
+
+static int stream_close(struct json_stream_parser *parser,
+			struct json_stream_token *tok, enum json_tokens type)
+{
+	bool obj = (type == JSON_TOK_OBJECT_END);
+
+	if (parser->depth == 0 || stream_in_obj(parser) != obj) {
+		return stream_error(parser, -EINVAL);
+	}
+
+	if (parser->expect != STREAM_COMMA_OR_END &&
+	    parser->expect != (obj ? STREAM_KEY_OR_END : STREAM_VALUE_OR_END)) {
+		return stream_error(parser, -EINVAL);
+	}
+
+	parser->depth--;
+	parser->expect = stream_after_value(parser);
+
+	*tok = (struct json_stream_token) { .type = type };
+
+	return 0;
+}
+
+int json_stream_parser_next(struct json_stream_parser *parser,
+			    struct json_stream_token *tok)
+{
+	if (parser->expect == STREAM_ERROR) {
+		return -EINVAL;
+	}
+
+	if (parser->lex != JSON_TOK_NONE) {
+		return stream_lex(parser, tok);
+	}
+
+	while (parser->pos < parser->end) {
+		char chr = *parser->pos++;
+
+		switch (chr) {
+		case ' ':
+		case '\t':
+		case '\n':
+		case '\r':
+			continue;
+		case '{':
+		case '[':
+			return stream_open(parser, tok, (enum json_tokens)chr);
+		case '}':
+		case ']':
+			return stream_close(parser, tok, (enum json_tokens)chr);
+		case ',':
+			if (parser->expect != STREAM_COMMA_OR_END) {
+				return stream_error(parser, -EINVAL);
+			}
+
+			parser->expect = stream_in_obj(parser) ? STREAM_KEY : STREAM_VALUE;
+			continue;
+		case ':':
+			if (parser->expect != STREAM_COLON) {
+				return stream_error(parser, -EINVAL);
+			}
+
+			parser->expect = STREAM_VALUE;
+			continue;
+		case '"':
+			return stream_start(parser, tok, JSON_TOK_STRING);
+		case 't':
+		case 'f':
+		case 'n':
+			parser->pos--;
+			return stream_start(parser, tok, (enum json_tokens)chr);
+		default:
+			if (chr == '-' || isdigit((unsigned char)chr) != 0) {
+				parser->pos--;
+				return stream_start(parser, tok, JSON_TOK_NUMBER);
+			}
+
+			return stream_error(parser, -EINVAL);
+		}
+	}
+
+	if (parser->expect == STREAM_DONE) {
+		*tok = (struct json_stream_token) { .type = JSON_TOK_EOF };
+		return 0;
+	}
+
+	return parser->last ? stream_error(parser, -EINVAL) : -EAGAIN;
+}
+
+int json_stream_encoder_init(struct json_stream_encoder *enc, char *buf,
+			     size_t buf_size, json_append_bytes_t flush,
+			     void *data)
+{
+	if (buf_size == 0) {
+		/* No progress could ever be made */
+		return -EINVAL;
+	}
+
+	*enc = (struct json_stream_encoder) {
+		.buf = buf,
+		.buf_size = buf_size,
+		.flush = flush,
+		.data = data,
+	};
+
+	return 0;
+}
+
+int json_stream_encoder_flush(struct json_stream_encoder *enc)
+{
+	int ret = 0;
+
+	if (enc->used != 0) {
+		ret = enc->flush(enc->buf, enc->used, enc->data);
+		enc->used = 0;
+	}
+
+	return ret;
+}
+
+static int stream_put(struct json_stream_encoder *enc, const char *bytes,
+		      size_t len)
+{
+	while (len > enc->buf_size - enc->used) {
+		size_t n = enc->buf_size - enc->used;
+		int ret;
+
+		memcpy(&enc->buf[enc->used], bytes, n);
+		enc->used += n;
+		bytes += n;
+		len -= n;
+
+		ret = json_stream_encoder_flush(enc);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	memcpy(&enc->buf[enc->used], bytes, len);
+	enc->used += len;
+
+	return 0;
+}
+
+static int stream_put_escaped(struct json_stream_encoder *enc, const char *str)
+{
+	const char *run = str;
+	int ret;
+
+	ret = stream_put(enc, "\"", 1);
+
+	/* Characters which need no escaping are written in runs */
+	for (; ret == 0 && *str != '\0'; str++) {
+		char escaped = escape_as(*str);
+
+		if (escaped) {
+			char bytes[2] = { '\\', escaped };
+
+			ret = stream_put(enc, run, str - run);
+			if (ret == 0) {
+				ret = stream_put(enc, bytes, sizeof(bytes));
+			}
+			run = str + 1;
+		}
+	}
+
+	if (ret == 0) {
+		ret = stream_put(enc, run, str - run);
+	}
+
+	return (ret == 0) ? stream_put(enc, "\"", 1) : ret;
+}
+
+/* Writes the comma and the key before a value */
+static int stream_value(struct json_stream_encoder *enc, const char *key)
+{
+	bool obj = (enc->depth != 0) && ((enc->nesting & BIT(enc->depth - 1)) != 0);
+	int ret = 0;
+
+	if (obj != (key != NULL)) {
+		return -EINVAL;
+	}
+
+	if (enc->depth == 0) {
+		return 0;
+	}
+
+	if ((enc->members & BIT(enc->depth - 1)) != 0) {
+		ret = stream_put(enc, ",", 1);
+	}
+	enc->members |= BIT(enc->depth - 1);
+
+	if (ret == 0 && obj) {
+		ret = stream_put_escaped(enc, key);
+		if (ret == 0) {
+			ret = stream_put(enc, ":", 1);
+		}
+	}
+
+	return ret;
+}
+
+static int stream_open_enc(struct json_stream_encoder *enc, const char *key,
+			   bool obj)
+{
+	int ret;
+
+	if (enc->depth == JSON_STREAM_MAX_DEPTH) {
+		return -EINVAL;
+	}
+
+	ret = stream_value(enc, key);
+	if (ret < 0) {
+		return ret;
+	}
+
+	WRITE_BIT(enc->nesting, enc->depth, obj);
+	enc->members &= ~BIT(enc->depth);
+	enc->depth++;
+
+	return stream_put(enc, obj ? "{" : "[", 1);
+}
+
+static int stream_close_enc(struct json_stream_encoder *enc, bool obj)
+{
+	if (enc->depth == 0 || ((enc->nesting & BIT(enc->depth - 1)) != 0) != obj) {
+		return -EINVAL;
+	}
+
+	enc->depth--;
+
+	return stream_put(enc, obj ? "}" : "]", 1);
+}
+
+int json_stream_encode_obj_start(struct json_stream_encoder *enc,
+				 const char *key)
+{
+	return stream_open_enc(enc, key, true);
+}
+
+int json_stream_encode_obj_end(struct json_stream_encoder *enc)
+{
+	return stream_close_enc(enc, true);
+}
+
+int json_stream_encode_arr_start(struct json_stream_encoder *enc,
+				 const char *key)
+{
+	return stream_open_enc(enc, key, false);
+}
+
+int json_stream_encode_arr_end(struct json_stream_encoder *enc)
+{
+	return stream_close_enc(enc, false);
+}
+
+int json_stream_encode_string(struct json_stream_encoder *enc, const char *key,
+			      const char *str)
+{
+	int ret = stream_value(enc, key);
+
+	return (ret < 0) ? ret : stream_put_escaped(enc, str);
+}
+
+int json_stream_encode_number(struct json_stream_encoder *enc, const char *key,
+			      int64_t num)
+{
+	char buf[21];
+	char *pos = &buf[sizeof(buf)];
+	uint64_t val = (num < 0) ? -(uint64_t)num : (uint64_t)num;
+	int ret;
+
+	ret = stream_value(enc, key);
+	if (ret < 0) {
+		return ret;
+	}
+
+	do {
+		*--pos = '0' + (val % 10U);
+		val /= 10U;
+	} while (val != 0U);
+
+	if (num < 0) {
+		*--pos = '-';
+	}
+
+	return stream_put(enc, pos, &buf[sizeof(buf)] - pos);
+}
+
+int json_stream_encode_bool(struct json_stream_encoder *enc, const char *key,
+			    bool value)
+{
+	int ret = stream_value(enc, key);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	return value ? stream_put(enc, "true", 4) : stream_put(enc, "false", 5);
+}
+
+int json_stream_encode_null(struct json_stream_encoder *enc, const char *key)
+{
+	int ret = stream_value(enc, key);
+
+	return (ret < 0) ? ret : stream_put(enc, "null", 4);
+}
@@ -0,0 +1,382 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Log Parser for the binary records frontend
+
+This decodes the records written by CONFIG_LOG_FRONTEND_BINARY, taking the
+format strings and the source names from the ELF file of the build, and
+prints the log messages.
+
+Records are read from a binary file, or with --hex from a console log in
+which they were printed after "LOGBIN:", one per line.
+"""
+
+import argparse
+import binascii
+import re
+import struct
+import sys
+
+LOG_HEX_PREFIX = "LOGBIN:"
+
+HDR_WLEN = 4
+FMT_TEXT = 0xFFFFFFFF
+FMT_DROPPED = 0xFFFFFFFE
+
+ARG_WORD = 0
+ARG_DWORD = 1
+ARG_DOUBLE = 2
+ARG_STR = 3
+
+LEVELS = ["none", "err", "wrn", "inf", "dbg"]
+
+HEXDUMP_BYTES_IN_LINE = 16
+
+# Conversion specifications of the C format strings
+FMT_SPEC = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<prec>\*|\d+))?"
+    r"(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conv>[diouxXcspfFeEgGaAn%])")
+
+
+class ElfFile:
+    """Minimal ELF reader, for the symbols and the data of allocated sections"""
+
+    SHT_SYMTAB = 2
+    SHT_NOBITS = 8
+    SHF_ALLOC = 0x2
+    ET_REL = 1
+
+    def __init__(self, path):
+        with open(path, "rb") as elffile:
+            self.data = elffile.read()
+
+        if self.data[:4] != b"\x7fELF":
+            sys.exit(f"{path} is not an ELF file")
+
+        self.is64 = self.data[4] == 2
+        self.endian = "<" if self.data[5] == 1 else ">"
+        self.ptr_size = 8 if self.is64 else 4
+
+        if self.is64:
+            (e_type, _, _, _, _, e_shoff, _, _, _, _, e_shentsize, e_shnum,
+             _) = struct.unpack_from(self.endian + "HHIQQQIHHHHHH", self.data, 16)
+            shdr_fmt = self.endian + "IIQQQQIIQQ"
+        else:
+            (e_type, _, _, _, _, e_shoff, _, _, _, _, e_shentsize, e_shnum,
+             _) = struct.unpack_from(self.endian + "HHIIIIIHHHHHH", self.data, 16)
+            shdr_fmt = self.endian + "IIIIIIIIII"
+
+        self.relocatable = e_type == self.ET_REL
+        self.sections = []
+        for i in range(e_shnum):
+            (_, sh_type, sh_flags, sh_addr, sh_offset, sh_size, sh_link, _, _,
+             sh_entsize) = struct.unpack_from(shdr_fmt, self.data, e_shoff + i * e_shentsize)
+            self.sections.append({"type": sh_type, "flags": sh_flags, "addr": sh_addr,
+                                  "offset": sh_offset, "size": sh_size, "link": sh_link,
+                                  "entsize": sh_entsize})
+
+        self.symbols = {}
+        for section in self.sections:
+            if section["type"] == self.SHT_SYMTAB:
+                self._read_symbols(section)
+
+    def _read_symbols(self, symtab):
+        strtab = self.sections[symtab["link"]]
+
+        for off in range(symtab["offset"], symtab["offset"] + symtab["size"],
+                         symtab["entsize"]):
+            if self.is64:
+                st_name, _, _, st_shndx, st_value, _ = struct.unpack_from(
+                    self.endian + "IBBHQQ", self.data, off)
+            else:
+                st_name, st_value, _, _, _, st_shndx = struct.unpack_from(
+                    self.endian + "IIIBBH", self.data, off)
+
+            name = self._cstring(strtab["offset"] + st_name)
+            if name:
+                self.symbols[name] = (st_shndx, st_value)
+
+    def _cstring(self, off):
+        end = self.data.index(b"\0", off)
+        return self.data[off:end].decode("utf-8", errors="replace")
+
+    def symbol_offset(self, name):
+        """File offset of the data of a symbol"""
+        shndx, value = self.symbols[name]
+        section = self.sections[shndx]
+
+        return section["offset"] + value - (0 if self.relocatable else section["addr"])
+
+    def addr_offset(self, addr):
+        """File offset of the data at an address, or None"""
+        if self.relocatable:
+            return None
+
+        for section in self.sections:
+            if (section["flags"] & self.SHF_ALLOC and section["type"] != self.SHT_NOBITS
+                    and section["addr"] <= addr < section["addr"] + section["size"]):
+                return section["offset"] + addr - section["addr"]
+
+        return None
+
+    def string_at(self, off):
+        """String at a file offset"""
+        return self._cstring(off)
+
+
+class LogDatabase:
+    """Format strings and source names of the build"""
+
+    def __init__(self, elf):
+        self.elf = elf
+
+        try:
+            self.strings = elf.symbol_offset("_log_strings_list_start")
+        except KeyError:
+            sys.exit("No log strings in the ELF file, "
+                     "is CONFIG_LOG_FRONTEND_BINARY enabled?")
+
+        self.sources = self._read_sources()
+
+    def _read_sources(self):
+        """Source names by ID, the index in the log_const section"""
+        elf = self.elf
+        start = elf.symbol_offset("_log_const_list_start")
+        end = elf.symbol_offset("_log_const_list_end")
+        entry_size = 2 * elf.ptr_size
+        sources = {}
+
+        # Name pointers cannot be read in a relocatable file, names are
+        # taken from the symbols of the entries then.
+        for name in elf.symbols:
+            if not name.startswith("log_const_"):
+                continue
+
+            off = elf.symbol_offset(name)
+            if start <= off < end:
+                sources[(off - start) // entry_size] = name[len("log_const_"):]
+
+        for idx in range((end - start) // entry_size):
+            ptr_fmt = elf.endian + ("Q" if elf.is64 else "I")
+            (ptr,) = struct.unpack_from(ptr_fmt, elf.data, start + idx * entry_size)
+            name_off = elf.addr_offset(ptr)
+            if name_off is not None:
+                sources[idx] = elf.string_at(name_off)
+
+        return sources
+
+    def fmt_get(self, offset):
+        """Format string at an offset of the log_strings section"""
+        return self.elf.string_at(self.strings + offset)
+
+    def source_get(self, source_id):
+        """Name of a source"""
+        return self.sources.get(source_id, f"<source {source_id}>")
+
+
+def format_string(fmt, args):
+    """Format a C format string, args being (type, value) tuples"""
+    args = list(args)
+    out = []
+    pos = 0
+
+    for spec in FMT_SPEC.finditer(fmt):
+        out.append(fmt[pos:spec.start()])
+        pos = spec.end()
+        conv = spec.group("conv")
+
+        if conv == "%":
+            out.append("%")
+            continue
+
+        width = spec.group("width")
+        prec = spec.group("prec")
+        if width == "*":
+            width = str(args.pop(0)[1]) if args else ""
+        if prec == "*":
+            prec = str(args.pop(0)[1]) if args else ""
+
+        if not args:
+            out.append(spec.group(0))
+            continue
+
+        arg_type, value = args.pop(0)
+        pyspec = "%" + spec.group("flags") + (width or "") + \
+            ("." + prec if prec is not None else "")
+
+        if conv in "di":
+            bits = 64 if arg_type == ARG_DWORD else 32
+            if value >= 1 << (bits - 1):
+                value -= 1 << bits
+            out.append((pyspec + "d") % value)
+        elif conv in "ouxX":
+            out.append((pyspec + conv) % value)
+        elif conv == "c":
+            out.append((pyspec + "c") % chr(value & 0xFF))
+        elif conv == "s":
+            out.append((pyspec + "s") % value)
+        elif conv == "p":
+            out.append((pyspec + "s") % f"0x{value:x}")
+        elif conv == "n":
+            pass
+        else:
+            out.append((pyspec + conv.replace("F", "f")) % value)
+
+    out.append(fmt[pos:])
+
+    return "".join(out)
+
+
+def hexdump(data):
+    """Hexdump lines, as printed by log_output"""
+    lines = []
+
+    for i in range(0, len(data), HEXDUMP_BYTES_IN_LINE):
+        chunk = data[i:i + HEXDUMP_BYTES_IN_LINE]
+        hexstr = " ".join(f"{b:02x}" for b in chunk)
+        text = "".join(chr(b) if 0x20 <= b < 0x7F else "." for b in chunk)
+        lines.append(f"{hexstr:<{3 * HEXDUMP_BYTES_IN_LINE}}|{text}")
+
+    return lines
+
+
+class RecordParser:
+    """Decoder of the records"""
+
+    def __init__(self, database, freq):
+        self.database = database
+        self.freq = freq
+        self.endian = database.elf.endian
+
+    def hdr_parse(self, word):
+        """Length, level and source in the first word of a record"""
+        if self.endian == "<":
+            return (word >> 2) & 0x3FF, (word >> 12) & 0x7, (word >> 15) & 0xFFFF
+
+        # Bit fields are allocated from the most significant bit
+        return (word >> 20) & 0x3FF, (word >> 17) & 0x7, (word >> 1) & 0xFFFF
+
+    def args_parse(self, data, desc):
+        """Arguments of a record, as (type, value) tuples"""
+        args = []
+        off = 0
+
+        for i in range(desc >> 28):
+            arg_type = (desc >> (2 * i)) & 0x3
+
+            if arg_type == ARG_WORD:
+                (value,) = struct.unpack_from(self.endian + "I", data, off)
+                off += 4
+            elif arg_type == ARG_DWORD:
+                (value,) = struct.unpack_from(self.endian + "Q", data, off)
+                off += 8
+            elif arg_type == ARG_DOUBLE:
+                (value,) = struct.unpack_from(self.endian + "d", data, off)
+                off += 8
+            else:
+                (length,) = struct.unpack_from(self.endian + "I", data, off)
+                value = data[off + 4:off + 4 + length]
+                off += 4 + (length + 3) // 4 * 4
+
+            args.append((arg_type, value))
+
+        return args
+
+    def timestamp_format(self, timestamp):
+        """Timestamp, in time if the frequency is known"""
+        if not self.freq:
+            return f"[{timestamp:08d}]"
+
+        usec = timestamp * 1000000 // self.freq
+        secs, usec = divmod(usec, 1000000)
+        mins, secs = divmod(secs, 60)
+        hours, mins = divmod(mins, 60)
+
+        return f"[{hours:02d}:{mins:02d}:{secs:02d}.{usec // 1000:03d},{usec % 1000:03d}]"
+
+    def record_decode(self, record):
+        """Log message lines of a record"""
+        word, fmt, timestamp, desc = struct.unpack_from(self.endian + "IIII", record)
+        _, level, source = self.hdr_parse(word)
+        args = self.args_parse(record[4 * HDR_WLEN:], desc)
+
+        if fmt == FMT_DROPPED:
+            return [f"--- {args[0][1]} messages dropped ---"]
+
+        prefix = (f"{self.timestamp_format(timestamp)} <{LEVELS[level]}> "
+                  f"{self.database.source_get(source)}: ")
+
+        if fmt == FMT_TEXT:
+            lines = [prefix + args[0][1].decode("utf-8", errors="replace")]
+            if len(args) > 1:
+                lines += [" " * len(prefix) + line for line in hexdump(args[1][1])]
+            return lines
+
+        args = [(t, v.decode("utf-8", errors="replace") if t == ARG_STR else v)
+                for t, v in args]
+
+        return [prefix + format_string(self.database.fmt_get(fmt), args)]
+
+    def parse(self, data):
+        """Decode a stream of records"""
+        off = 0
+
+        while off + 4 * HDR_WLEN <= len(data):
+            (word,) = struct.unpack_from(self.endian + "I", data, off)
+            wlen = self.hdr_parse(word)[0]
+
+            if wlen < HDR_WLEN or off + 4 * wlen > len(data):
+                print(f"Bad record at offset {off}", file=sys.stderr)
+                break
+
+            for line in self.record_decode(data[off:off + 4 * wlen]):
+                print(line)
+
+            off += 4 * wlen
+
+
+def read_log_file(args):
+    """Records in the log file"""
+    if not args.hex:
+        with open(args.logfile, "rb") as logfile:
+            return logfile.read()
+
+    records = bytearray()
+    with open(args.logfile, "r", encoding="iso-8859-1") as hexfile:
+        for line in hexfile:
+            idx = line.find(LOG_HEX_PREFIX)
+            if idx >= 0:
+                records += binascii.unhexlify(line[idx + len(LOG_HEX_PREFIX):].strip())
+
+    return bytes(records)
+
+
+def parse_args():
+    """Parse command line arguments"""
+    argparser = argparse.ArgumentParser(allow_abbrev=False)
+
+    argparser.add_argument("elffile", help="ELF file of the build")
+    argparser.add_argument("logfile", help="Log Data file")
+    argparser.add_argument("--hex", action="store_true",
+                           help="Records are hexadecimal strings after \"LOGBIN:\" "
+                           "in a console log")
+    argparser.add_argument("--freq", type=int, default=0,
+                           help="Frequency of the timestamps, to print them in time")
+
+    return argparser.parse_args()
+
+
+def main():
+    """Main function of log parser"""
+    args = parse_args()
+
+    database = LogDatabase(ElfFile(args.elffile))
+    RecordParser(database, args.freq).parse(read_log_file(args))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Fold the samples of the sampling profiler into stacks for flame graphs
+
+Reads the output of the "profiler dump" shell command (see
+CONFIG_SAMPLING_PROFILER), symbolises the return addresses of the samples
+against the ELF file of the image, and prints one line per distinct stack,
+in the "folded" format read by flame graph tools such as flamegraph.pl or
+speedscope:
+
+    thread;outermost function;...;innermost function count
+
+For example:
+
+    ./stackcollapse.py build/zephyr/zephyr.elf console.log > out.folded
+    flamegraph.pl out.folded > out.svg
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+# Functions dispatching the interrupts on the stack of the code interrupted,
+# removed from the stacks along with the timer handling they call.
+IRQ_ENTRIES = [
+    "posix_irq_handler",
+]
+
+THREAD_RE = re.compile(r"thread (0x[0-9a-fA-F]+) ?(.*)$")
+SAMPLE_RE = re.compile(r"sample (\d+) (0x[0-9a-fA-F]+)((?: 0x[0-9a-fA-F]+)*)\s*$")
+
+
+class Symbols:
+    """Address to symbol name lookup, for one type of symbols"""
+
+    def __init__(self, elf, sym_type):
+        symbols = []
+
+        for section in elf.iter_sections():
+            if not isinstance(section, SymbolTableSection):
+                continue
+
+            for sym in section.iter_symbols():
+                if (sym.entry["st_info"]["type"] == sym_type and
+                        sym.entry["st_shndx"] != "SHN_UNDEF"):
+                    symbols.append((sym.entry["st_value"],
+                                    sym.entry["st_size"], sym.name))
+
+        symbols.sort()
+        self.addrs = [sym[0] for sym in symbols]
+        self.symbols = symbols
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i >= 0:
+            start, size, name = self.symbols[i]
+            if addr < start + max(size, 1):
+                return name
+        return None
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        allow_abbrev=False)
+
+    parser.add_argument("elf", help="ELF file of the image profiled")
+    parser.add_argument("log", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin,
+                        help="output of \"profiler dump\" (default: stdin)")
+    parser.add_argument("--irq-entry", action="append", default=[],
+                        metavar="FUNCTION",
+                        help="function to cut the stacks at, with the "
+                        "functions it calls (repeatable)")
+    parser.add_argument("--no-thread", action="store_true",
+                        help="do not start the stacks with the thread")
+
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    irq_entries = set(IRQ_ENTRIES + args.irq_entry)
+
+    with open(args.elf, "rb") as f:
+        elf = ELFFile(f)
+        functions = Symbols(elf, "STT_FUNC")
+        objects = Symbols(elf, "STT_OBJECT")
+
+    thread_names = {}
+    stacks = collections.Counter()
+
+    for line in args.log:
+        match = THREAD_RE.search(line)
+        if match:
+            if match.group(2):
+                thread_names[int(match.group(1), 16)] = match.group(2)
+            continue
+
+        match = SAMPLE_RE.search(line)
+        if not match:
+            continue
+
+        frames = []
+        for pc in match.group(3).split():
+            pc = int(pc, 16)
+            # A return address may be just past its function, after a call
+            # to a function which does not return.
+            name = functions.lookup(pc - 1)
+            if name in irq_entries:
+                frames = []
+                continue
+            frames.append(name or f"[{pc:#x}]")
+
+        frames.reverse()
+
+        if not args.no_thread:
+            thread = int(match.group(2), 16)
+            name = (thread_names.get(thread) or objects.lookup(thread) or
+                    f"thread {thread:#x}")
+            frames.insert(0, name)
+
+        if frames:
+            stacks[";".join(frames)] += 1
+
+    for stack, count in sorted(stacks.items()):
+        print(f"{stack} {count}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sampling profiler
+ *
+ * A periodic timer records the thread running and the return addresses of
+ * the code it interrupted, found by walking the frame pointers from the
+ * timer callback. Each CPU has a ring of samples, filled by the timer
+ * callback and drained by the reader without locking.
+ */
+
+#include <stdlib.h>
+
+#include <zephyr/kernel.h>
+#include <kernel_internal.h>
+#include <zephyr/debug/sampling_profiler.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/spsc_lockfree.h>
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_SAMPLING_PROFILER_BUFFER_SIZE),
+	     "CONFIG_SAMPLING_PROFILER_BUFFER_SIZE must be a power of two");
+
+/* Largest frame expected, where stacks are not known */
+#define FRAME_MAX 8192
+
+static struct sampling_profiler_sample
+	buffers[CONFIG_MP_MAX_NUM_CPUS][CONFIG_SAMPLING_PROFILER_BUFFER_SIZE];
+
+#define RING_INIT(i, _) SPSC_INITIALIZER(CONFIG_SAMPLING_PROFILER_BUFFER_SIZE, buffers[i])
+
+SPSC_DECLARE(sampling_profiler_ring, struct sampling_profiler_sample) rings[] = {
+	LISTIFY(CONFIG_MP_MAX_NUM_CPUS, RING_INIT, (,))
+};
+
+static atomic_t dropped[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t running;
+
+static void sampling_profiler_tick(struct k_timer *timer);
+
+static K_TIMER_DEFINE(sampling_profiler_timer, sampling_profiler_tick, NULL);
+
+#ifndef CONFIG_ARCH_POSIX
+static bool in_irq_stack(uintptr_t fp)
+{
+	uintptr_t top = (uintptr_t)_current_cpu->irq_stack;
+
+	return (fp < top) &&
+	       (fp >= top - K_KERNEL_STACK_SIZEOF(z_interrupt_stacks[0]));
+}
+
+static bool in_thread_stack(uintptr_t fp)
+{
+	uintptr_t start = _current->stack_info.start;
+
+	return (fp >= start) && (fp < start + _current->stack_info.size);
+}
+#endif
+
+/* Whether @a fp is the frame pointer of the caller of frame @a prev */
+static bool frame_valid(uintptr_t fp, uintptr_t prev)
+{
+	if ((fp == 0U) || ((fp & (sizeof(uintptr_t) - 1)) != 0U)) {
+		return false;
+	}
+
+#ifdef CONFIG_ARCH_POSIX
+	/* The interrupts run on the stack of the code interrupted, itself
+	 * only known to the host: frames grow up to its base.
+	 */
+	return (fp > prev) && ((fp - prev) < FRAME_MAX);
+#else
+	/* The interrupts may run on a stack of their own, and the frames
+	 * continue on the stack of the thread interrupted.
+	 */
+	if (in_irq_stack(prev)) {
+		return (in_irq_stack(fp) && (fp > prev)) ||
+		       in_thread_stack(fp);
+	}
+
+	return in_thread_stack(fp) && (fp > prev) &&
+	       (fp + 2 * sizeof(uintptr_t) <=
+		_current->stack_info.start + _current->stack_info.size);
+#endif
+}
+
+/* Frame records are laid out as on x86 and ARM64: the frame pointer points
+ * to the frame pointer of the caller, followed by the return address.
+ */
+static void sampling_profiler_walk(uintptr_t *pc)
+{
+	uintptr_t *fp = __builtin_frame_address(0);
+	int n = 0;
+
+#if defined(CONFIG_X86) && !defined(CONFIG_X86_64)
+	/* The function interrupted has no return address yet: its address is
+	 * in the exception frame, pointed to by the stack pointer which
+	 * _interrupt_enter saved at the base of the interrupt stack, after
+	 * EDI, ECX, EDX and EAX.
+	 */
+	if (_current_cpu->nested == 1U) {
+		uintptr_t *sp = *((uintptr_t **)_current_cpu->irq_stack - 1);
+
+		pc[n++] = sp[4];
+	}
+#endif
+
+	while (n < CONFIG_SAMPLING_PROFILER_DEPTH) {
+		uintptr_t *next = (uintptr_t *)fp[0];
+
+#ifndef CONFIG_ARCH_POSIX
+		/* Skip the interrupt handling, when on a stack of its own */
+		if (!in_irq_stack((uintptr_t)fp))
+#endif
+		{
+			pc[n++] = fp[1];
+		}
+
+		if (!frame_valid((uintptr_t)next, (uintptr_t)fp)) {
+			break;
+		}
+
+		fp = next;
+	}
+
+	if (n < CONFIG_SAMPLING_PROFILER_DEPTH) {
+		pc[n] = 0U;
+	}
+}
+
+static void sampling_profiler_tick(struct k_timer *timer)
+{
+	unsigned int cpu = _current_cpu->id;
+	struct sampling_profiler_sample *sample;
+
+	ARG_UNUSED(timer);
+
+	/* The timer callback is the only producer, whatever its CPU */
+	sample = spsc_acquire(&rings[cpu]);
+	if (sample == NULL) {
+		atomic_inc(&dropped[cpu]);
+	} else {
+		sample->thread = _current;
+		sampling_profiler_walk(sample->pc);
+		spsc_produce(&rings[cpu]);
+	}
+
+#ifdef CONFIG_SMP
+	/* Only the thread is known on the other CPUs */
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		if (i == cpu) {
+			continue;
+		}
+
+		sample = spsc_acquire(&rings[i]);
+		if (sample == NULL) {
+			atomic_inc(&dropped[i]);
+			continue;
+		}
+
+		sample->thread = _kernel.cpus[i].current;
+		sample->pc[0] = 0U;
+		spsc_produce(&rings[i]);
+	}
+#endif
+}
+
+int sampling_profiler_start(uint32_t frequency)
+{
+	if ((frequency == 0U) ||
+	    (frequency > CONFIG_SYS_CLOCK_TICKS_PER_SEC)) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&running, 0, 1)) {
+		return -EALREADY;
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(dropped); i++) {
+		atomic_clear(&dropped[i]);
+	}
+
+	k_timer_start(&sampling_profiler_timer, K_USEC(USEC_PER_SEC / frequency),
+		      K_USEC(USEC_PER_SEC / frequency));
+
+	return 0;
+}
+
+void sampling_profiler_stop(void)
+{
+	k_timer_stop(&sampling_profiler_timer);
+	atomic_clear(&running);
+}
+
+size_t sampling_profiler_read(unsigned int cpu,
+			      struct sampling_profiler_sample *samples,
+			      size_t max)
+{
+	struct sampling_profiler_sample *sample;
+	size_t n = 0;
+
+	if (cpu >= ARRAY_SIZE(rings)) {
+		return 0;
+	}
+
+	while ((n < max) && ((sample = spsc_consume(&rings[cpu])) != NULL)) {
+		samples[n++] = *sample;
+		spsc_release(&rings[cpu]);
+	}
+
+	return n;
+}
+
+uint32_t sampling_profiler_dropped(unsigned int cpu)
+{
+	if (cpu >= ARRAY_SIZE(dropped)) {
+		return 0;
+	}
+
+	return (uint32_t)atomic_get(&dropped[cpu]);
+}
+
+#ifdef CONFIG_SAMPLING_PROFILER_SHELL
+
+static int cmd_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t frequency = 100;
+	int ret;
+
+	if (argc > 1) {
+		frequency = strtoul(argv[1], NULL, 10);
+	}
+
+	ret = sampling_profiler_start(frequency);
+	if (ret != 0) {
+		shell_error(sh, "Cannot start sampling: %d", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sampling_profiler_stop();
+
+	return 0;
+}
+
+static void print_thread(const struct k_thread *thread, void *user_data)
+{
+	const struct shell *sh = user_data;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+
+	shell_print(sh, "thread %p %s", thread, (name != NULL) ? name : "");
+}
+
+/* Printed in the format read by stackcollapse.py */
+static int cmd_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	struct sampling_profiler_sample sample;
+	char line[16 + 20 * CONFIG_SAMPLING_PROFILER_DEPTH];
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	/* The names of the threads still running */
+	k_thread_foreach(print_thread, (void *)sh);
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		while (sampling_profiler_read(cpu, &sample, 1) == 1) {
+			int len = 0;
+
+			for (int i = 0; (i < CONFIG_SAMPLING_PROFILER_DEPTH) &&
+					(sample.pc[i] != 0U); i++) {
+				len += snprintk(&line[len], sizeof(line) - len,
+						" 0x%lx", (unsigned long)sample.pc[i]);
+			}
+			line[len] = '\0';
+
+			shell_print(sh, "sample %u %p%s", cpu, sample.thread,
+				    line);
+		}
+
+		shell_print(sh, "dropped %u %u", cpu,
+			    sampling_profiler_dropped(cpu));
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL, "Start sampling [frequency, default 100 Hz]",
+		      cmd_start, 1, 1),
+	SHELL_CMD_ARG(stop, NULL, "Stop sampling", cmd_stop, 1, 0),
+	SHELL_CMD_ARG(dump, NULL, "Print and discard the samples taken",
+		      cmd_dump, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler", NULL);
+
+#endif /* CONFIG_SAMPLING_PROFILER_SHELL */
@@ -134,10 +134,30 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 	.flags = (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
 		  MPSC_PBUF_MODE_OVERWRITE : 0) |
 		 (IS_ENABLED(CONFIG_LOG_MEM_UTILIZATION) ?
-		  MPSC_PBUF_MAX_UTILIZATION : 0)
+		  MPSC_PBUF_MAX_UTILIZATION : 0) |
+		 (IS_ENABLED(CONFIG_MPSC_PBUF_LOCKFREE) ?
+		  MPSC_PBUF_MODE_LOCKFREE : 0)
 };
 #endif
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* CPU 0 uses log_buffer, the others one of these. Each buffer is paired
+ * with a message pointer, for the merge done by z_log_msg_claim_oldest().
+ */
+#define LOG_CPU_BUFFERS (CONFIG_MP_MAX_NUM_CPUS - 1)
+
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	cpu_buf32[LOG_CPU_BUFFERS][CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+static STRUCT_SECTION_ITERABLE_ARRAY_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer,
+					       log_cpu_buffer, LOG_CPU_BUFFERS);
+static STRUCT_SECTION_ITERABLE_ARRAY(log_msg_ptr, log_cpu_msg_ptr, LOG_CPU_BUFFERS);
+static atomic_t cpu_dropped_cnt[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
+/* Messages are taken from several buffers, oldest first */
+#define LOG_MERGE_BUFFERS \
+	(IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS))
+
 /* Check that default tag can fit in tag buffer. */
 COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, (),
 	(BUILD_ASSERT(sizeof(CONFIG_LOG_TAG_DEFAULT) <= CONFIG_LOG_TAG_MAX_LEN + 1,
@@ -613,6 +633,10 @@ uint32_t z_vrfy_log_buffered_cnt(void)
 void z_log_dropped(bool buffered)
 {
 	atomic_inc(&dropped_cnt);
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	/* A CPU only overwrites messages in its own buffer */
+	atomic_inc(&cpu_dropped_cnt[arch_curr_cpu()->id]);
+#endif
 	if (buffered) {
 		atomic_dec(&buffered_cnt);
 	}
@@ -628,13 +652,56 @@ bool z_log_dropped_pending(void)
 	return dropped_cnt > 0;
 }
 
+uint32_t log_cpu_dropped_get(unsigned int cpu)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	if (cpu < ARRAY_SIZE(cpu_dropped_cnt)) {
+		return (uint32_t)atomic_get(&cpu_dropped_cnt[cpu]);
+	}
+#else
+	ARG_UNUSED(cpu);
+#endif
+	return 0;
+}
+
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+	for (int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		config.buf = cpu_buf32[i];
+		mpsc_pbuf_init(&log_cpu_buffer[i], &config);
+		log_cpu_msg_ptr[i].msg = NULL;
+		atomic_clear(&cpu_dropped_cnt[i + 1]);
+	}
+	atomic_clear(&cpu_dropped_cnt[0]);
+#endif
+}
+
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+static struct mpsc_pbuf_buffer *cpu_buffer_get(unsigned int cpu)
+{
+	return (cpu == 0U) ? &log_buffer : &log_cpu_buffer[cpu - 1];
+}
+
+/* The thread may have moved to another CPU since it allocated the message */
+static struct mpsc_pbuf_buffer *msg_buffer_get(const struct log_msg *msg)
+{
+	for (int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		if (((const uint32_t *)msg >= cpu_buf32[i]) &&
+		    ((const uint32_t *)msg < &cpu_buf32[i][ARRAY_SIZE(cpu_buf32[i])])) {
+			return &log_cpu_buffer[i];
+		}
+	}
+
+	return &log_buffer;
 }
+#endif
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 {
@@ -651,7 +718,11 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	return msg_alloc(cpu_buffer_get(arch_curr_cpu()->id), wlen);
+#else
 	return msg_alloc(&log_buffer, wlen);
+#endif
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -673,7 +744,11 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	msg_commit(msg_buffer_get(msg), msg);
+#else
 	msg_commit(&log_buffer, msg);
+#endif
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -760,7 +835,7 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if (LOG_MERGE_BUFFERS && len > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -795,7 +870,7 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+	if (!LOG_MERGE_BUFFERS || (len == 1)) {
 		return msg_pending(&log_buffer);
 	}
 
@@ -877,6 +952,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < LOG_CPU_BUFFERS; i++) {
+		uint32_t size, now;
+
+		mpsc_pbuf_get_utilization(&log_cpu_buffer[i], &size, &now);
+		*buf_size += size;
+		*usage += now;
+	}
+#endif
+
 	return 0;
 }
 
@@ -888,7 +973,21 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	/* Sum of the maximums of each CPU, which may not have been reached at once */
+	int err = mpsc_pbuf_get_max_utilization(&log_buffer, max);
+
+	for (int i = 0; (err == 0) && (i < LOG_CPU_BUFFERS); i++) {
+		uint32_t cpu_max;
+
+		err = mpsc_pbuf_get_max_utilization(&log_cpu_buffer[i], &cpu_max);
+		*max += cpu_max;
+	}
+
+	return err;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log_frontend.h>
+#include <zephyr/logging/log_frontend_binary.h>
+#include <zephyr/logging/log_internal.h>
+#include <zephyr/sys/mpsc_pbuf.h>
+#include <zephyr/sys/cbprintf.h>
+
+BUILD_ASSERT(CONFIG_LOG_FRONTEND_BINARY_BUFFER_SIZE / sizeof(uint32_t) <
+	     BIT(10), "Buffer too large for the length of a record");
+
+TYPE_SECTION_START_EXTERN(char, log_strings);
+
+static uint32_t dbuf[CONFIG_LOG_FRONTEND_BINARY_BUFFER_SIZE / sizeof(uint32_t)];
+
+static uint32_t get_wlen(const union mpsc_pbuf_generic *packet)
+{
+	return ((const struct log_frontend_binary_hdr *)packet)->wlen;
+}
+
+static const struct mpsc_pbuf_buffer_config config = {
+	.buf = dbuf,
+	.size = ARRAY_SIZE(dbuf),
+	.get_wlen = get_wlen,
+	.flags = IS_ENABLED(CONFIG_MPSC_PBUF_LOCKFREE) ? MPSC_PBUF_MODE_LOCKFREE : 0,
+};
+
+static struct mpsc_pbuf_buffer buf;
+static atomic_t dropped;
+static volatile bool in_panic;
+static log_frontend_binary_output_t output_func;
+static void *output_ctx;
+
+static void flush_handler(struct k_work *work);
+static void flush_timeout(struct k_timer *timer);
+
+static K_WORK_DEFINE(flush_work, flush_handler);
+static K_TIMER_DEFINE(flush_timer, flush_timeout, NULL);
+
+/* Records are printed one per line, as the dictionary logging does with
+ * CONFIG_LOG_DICTIONARY_FORMAT_HEX.
+ */
+static int hex_out(const uint8_t *data, size_t len, void *ctx)
+{
+	static const char hex[] = "0123456789abcdef";
+	char line[64];
+	size_t n = 0;
+
+	ARG_UNUSED(ctx);
+
+	if (!IS_ENABLED(CONFIG_PRINTK)) {
+		return len;
+	}
+
+	k_str_out("LOGBIN:", strlen("LOGBIN:"));
+
+	for (size_t i = 0; i < len; i++) {
+		line[n++] = hex[data[i] >> 4];
+		line[n++] = hex[data[i] & 0xf];
+
+		if (n == sizeof(line)) {
+			k_str_out(line, n);
+			n = 0;
+		}
+	}
+
+	line[n++] = '\n';
+	k_str_out(line, n);
+
+	return len;
+}
+
+uint32_t *z_log_frontend_binary_alloc(uint32_t wlen)
+{
+	uint32_t *rec = (uint32_t *)mpsc_pbuf_alloc(&buf, wlen, K_NO_WAIT);
+
+	if (rec == NULL) {
+		atomic_inc(&dropped);
+		return NULL;
+	}
+
+	/* The length is needed as soon as allocated, to skip the record */
+	((struct log_frontend_binary_hdr *)rec)->wlen = wlen;
+
+	return rec;
+}
+
+static void record_commit(uint32_t *rec, uint32_t source, uint32_t level, uint32_t fmt,
+			  uint32_t desc)
+{
+	struct log_frontend_binary_hdr *hdr = (struct log_frontend_binary_hdr *)rec;
+
+	hdr->level = level;
+	hdr->source = source;
+	hdr->fmt = fmt;
+	hdr->timestamp = (uint32_t)z_log_timestamp();
+	hdr->desc = desc;
+
+	mpsc_pbuf_commit(&buf, (union mpsc_pbuf_generic *)rec);
+
+	if (in_panic) {
+		(void)log_frontend_binary_flush();
+	}
+}
+
+static uint32_t source_id(const void *source)
+{
+	if (source == NULL) {
+		return 0U;
+	}
+
+	return IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
+		log_dynamic_source_id((void *)source) :
+		log_const_source_id((void *)source);
+}
+
+void z_log_frontend_binary_commit(uint32_t *rec, const void *source, uint32_t level,
+				  const char *fmt, uint32_t desc)
+{
+	record_commit(rec, source_id(source), level,
+		      (uint32_t)((uintptr_t)fmt - (uintptr_t)TYPE_SECTION_START(log_strings)),
+		      desc);
+}
+
+static void words_put(const void *source, uint32_t level, const char *fmt,
+		      const uint32_t *args, uint32_t nargs)
+{
+	uint32_t *rec = z_log_frontend_binary_alloc(Z_LOG_BINARY_HDR_WLEN + nargs);
+
+	if (rec != NULL) {
+		memcpy(&rec[Z_LOG_BINARY_HDR_WLEN], args, nargs * sizeof(uint32_t));
+		z_log_frontend_binary_commit(rec, source, level, fmt, nargs << 28);
+	}
+}
+
+void log_frontend_simple_0(const void *source, uint32_t level, const char *fmt)
+{
+	words_put(source, level, fmt, NULL, 0);
+}
+
+void log_frontend_simple_1(const void *source, uint32_t level, const char *fmt, uint32_t arg)
+{
+	words_put(source, level, fmt, &arg, 1);
+}
+
+void log_frontend_simple_2(const void *source, uint32_t level,
+			   const char *fmt, uint32_t arg0, uint32_t arg1)
+{
+	uint32_t args[] = { arg0, arg1 };
+
+	words_put(source, level, fmt, args, ARRAY_SIZE(args));
+}
+
+struct text_ctx {
+	uint8_t *out;
+	size_t len;
+};
+
+static int text_out(int c, void *ctx)
+{
+	struct text_ctx *text = ctx;
+
+	if (text->out != NULL) {
+		text->out[text->len] = (uint8_t)c;
+	}
+	text->len++;
+
+	return c;
+}
+
+/* Messages which could not be written as binary records at the call site are
+ * formatted here.
+ */
+void log_frontend_msg(const void *source,
+		      const struct log_msg_desc desc,
+		      uint8_t *package, const void *data)
+{
+	struct text_ctx text = { 0 };
+	uint32_t nargs = (desc.data_len != 0U) ? 2U : 1U;
+	uint32_t *rec;
+	uint32_t *p;
+
+	if (desc.package_len != 0U) {
+		(void)cbpprintf(text_out, &text, package);
+	}
+
+	rec = z_log_frontend_binary_alloc(Z_LOG_BINARY_HDR_WLEN + nargs +
+					  DIV_ROUND_UP(text.len, sizeof(uint32_t)) +
+					  DIV_ROUND_UP(desc.data_len, sizeof(uint32_t)));
+	if (rec == NULL) {
+		return;
+	}
+
+	p = &rec[Z_LOG_BINARY_HDR_WLEN];
+	*p = text.len;
+	text.out = (uint8_t *)&p[1];
+	text.len = 0;
+	if (desc.package_len != 0U) {
+		(void)cbpprintf(text_out, &text, package);
+	}
+	p += 1 + DIV_ROUND_UP(text.len, sizeof(uint32_t));
+
+	if (desc.data_len != 0U) {
+		*p = desc.data_len;
+		memcpy(&p[1], data, desc.data_len);
+	}
+
+	record_commit(rec, source_id(source), desc.level, LOG_FRONTEND_BINARY_FMT_TEXT,
+		      (nargs << 28) | (LOG_FRONTEND_BINARY_ARG_STR << 2) |
+		      LOG_FRONTEND_BINARY_ARG_STR);
+}
+
+void log_frontend_binary_output_set(log_frontend_binary_output_t func, void *ctx)
+{
+	output_ctx = ctx;
+	output_func = (func != NULL) ? func : hex_out;
+}
+
+static void dropped_put(void)
+{
+	uint32_t cnt = (uint32_t)atomic_set(&dropped, 0);
+	uint32_t *rec;
+
+	if (cnt == 0U) {
+		return;
+	}
+
+	rec = (uint32_t *)mpsc_pbuf_alloc(&buf, Z_LOG_BINARY_HDR_WLEN + 1, K_NO_WAIT);
+	if (rec == NULL) {
+		atomic_add(&dropped, cnt);
+		return;
+	}
+
+	((struct log_frontend_binary_hdr *)rec)->wlen = Z_LOG_BINARY_HDR_WLEN + 1;
+	rec[Z_LOG_BINARY_HDR_WLEN] = cnt;
+	record_commit(rec, 0U, LOG_LEVEL_WRN, LOG_FRONTEND_BINARY_FMT_DROPPED, 1U << 28);
+}
+
+static int records_out(void)
+{
+	const union mpsc_pbuf_generic *rec;
+	int cnt = 0;
+
+	while ((rec = mpsc_pbuf_claim(&buf)) != NULL) {
+		output_func((const uint8_t *)rec, get_wlen(rec) * sizeof(uint32_t), output_ctx);
+		mpsc_pbuf_free(&buf, rec);
+		cnt++;
+	}
+
+	return cnt;
+}
+
+int log_frontend_binary_flush(void)
+{
+	int cnt = records_out();
+
+	/* Once there is room for it */
+	dropped_put();
+
+	return cnt + records_out();
+}
+
+static void flush_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)log_frontend_binary_flush();
+}
+
+static void flush_timeout(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	if (mpsc_pbuf_is_pending(&buf) || (atomic_get(&dropped) != 0)) {
+		k_work_submit(&flush_work);
+	}
+}
+
+void log_frontend_panic(void)
+{
+	in_panic = true;
+
+	(void)log_frontend_binary_flush();
+}
+
+void log_frontend_init(void)
+{
+	if (output_func == NULL) {
+		output_func = hex_out;
+	}
+
+	mpsc_pbuf_init(&buf, &config);
+}
+
+/* Cannot be started in log_frontend_init because it is called before kernel is ready. */
+static int log_frontend_binary_start_timer(void)
+{
+	k_timeout_t t = K_MSEC(CONFIG_LOG_FRONTEND_BINARY_FLUSH_PERIOD_MS);
+
+	k_timer_start(&flush_timer, t, t);
+
+	return 0;
+}
+
+SYS_INIT(log_frontend_binary_start_timer, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -14,6 +14,7 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 #define LOG_COLOR_CODE_DEFAULT "\x1B[0m"
 #define LOG_COLOR_CODE_RED     "\x1B[1;31m"
@@ -98,38 +99,63 @@ static int level_to_rfc5424_severity(uint32_t level)
 	return ret;
 }
 
-static int out_func(int c, void *ctx)
+static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
+			 void *ctx)
+{
+	int processed;
+
+	while (len != 0) {
+		processed = outf(buf, len, ctx);
+		len -= processed;
+		buf += processed;
+	}
+}
+
+static int out_func(const char *buf, size_t len, void *ctx)
 {
 	const struct log_output *out_ctx = (const struct log_output *)ctx;
-	int idx;
 
 	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
 		/* Backend must be thread safe in synchronous operation. */
-		/* Need that step for big endian */
-		char x = (char)c;
-
-		out_ctx->func((uint8_t *)&x, 1, out_ctx->control_block->ctx);
+		buffer_write(out_ctx->func, (uint8_t *)buf, len,
+			     out_ctx->control_block->ctx);
 		return 0;
 	}
 
-	if (out_ctx->control_block->offset == out_ctx->size) {
-		log_output_flush(out_ctx);
-	}
+	while (len != 0) {
+		size_t n;
+
+		if (out_ctx->control_block->offset == out_ctx->size) {
+			log_output_flush(out_ctx);
+		}
 
-	idx = atomic_inc(&out_ctx->control_block->offset);
-	out_ctx->buf[idx] = (uint8_t)c;
+		n = MIN(len, out_ctx->size - out_ctx->control_block->offset);
+		memcpy(&out_ctx->buf[out_ctx->control_block->offset], buf, n);
+		atomic_add(&out_ctx->control_block->offset, n);
+		buf += n;
+		len -= n;
+	}
 
 	__ASSERT_NO_MSG(out_ctx->control_block->offset <= out_ctx->size);
 
 	return 0;
 }
 
-static int cr_out_func(int c, void *ctx)
+static int cr_out_func(const char *buf, size_t len, void *ctx)
 {
-	if (c == '\n') {
-		out_func((int)'\r', ctx);
+	const char *end = buf + len;
+
+	while (buf < end) {
+		const char *nl = memchr(buf, '\n', end - buf);
+
+		if (nl == NULL) {
+			return out_func(buf, end - buf, ctx);
+		}
+
+		out_func(buf, nl - buf, ctx);
+		out_func("\r\n", 2, ctx);
+		buf = nl + 1;
 	}
-	out_func(c, ctx);
 
 	return 0;
 }
@@ -141,25 +167,12 @@ static int print_formatted(const struct log_output *output,
 	int length = 0;
 
 	va_start(args, fmt);
-	length = cbvprintf(out_func, (void *)output, fmt, args);
+	length = cbvprintf_bulk(out_func, (void *)output, fmt, args);
 	va_end(args);
 
 	return length;
 }
 
-static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
-			 void *ctx)
-{
-	int processed;
-
-	while (len != 0) {
-		processed = outf(buf, len, ctx);
-		len -= processed;
-		buf += processed;
-	}
-}
-
-
 void log_output_flush(const struct log_output *output)
 {
 	buffer_write(output->func, output->buf,
@@ -678,7 +691,7 @@ void log_output_process(const struct log_output *output,
 {
 	bool raw_string = (level == LOG_LEVEL_INTERNAL_RAW_STRING);
 	uint32_t prefix_offset;
-	cbprintf_cb cb;
+	cbprintf_bulk_cb cb;
 
 	if (!raw_string) {
 		prefix_offset = prefix_print(output, flags, 0, timestamp,
@@ -694,7 +707,7 @@ void log_output_process(const struct log_output *output,
 	}
 
 	if (package) {
-		int err = cbpprintf(cb, (void *)output, (void *)package);
+		int err = cbpprintf_bulk(cb, (void *)output, (void *)package);
 
 		(void)err;
 		__ASSERT_NO_MSG(err >= 0);
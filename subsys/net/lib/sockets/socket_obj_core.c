@@ -18,7 +18,8 @@ static struct k_obj_type sock_obj_type;
 static K_MUTEX_DEFINE(sock_obj_mutex);
 
 /* Allocate some extra socket objects so that we can track
- * closed sockets and get some historical statistics.
+ * closed sockets and get some historical statistics. With a growable
+ * fd table, the sockets opened beyond this have no object.
  */
 static struct sock_obj sock_objects[CONFIG_ZVFS_OPEN_MAX * 2] = {
 	[0 ... ((CONFIG_ZVFS_OPEN_MAX * 2) - 1)] = {
@@ -21,6 +21,7 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/sys/fdtable.h>
 #include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/zvfs/epoll.h>
 
 #if defined(CONFIG_SOCKS)
 #include "socks.h"
@@ -298,6 +299,10 @@ int z_impl_zsock_close(int sock)
 		return -1;
 	}
 
+#ifdef CONFIG_ZVFS_EPOLL
+	zvfs_epoll_fd_close(sock);
+#endif
+
 	(void)k_mutex_lock(lock, K_FOREVER);
 
 	NET_DBG("close: ctx=%p, fd=%d", ctx, sock);
@@ -356,6 +356,10 @@ static int cmd_kernel_heap(const struct shell *sh,
 	shell_print(sh, "free:           %zu", stats.free_bytes);
 	shell_print(sh, "allocated:      %zu", stats.allocated_bytes);
 	shell_print(sh, "max. allocated: %zu", stats.max_allocated_bytes);
+#ifdef CONFIG_HEAP_MEM_POOL_CACHE
+	/* Part of the allocated bytes */
+	shell_print(sh, "cached:         %zu", k_malloc_cache_size_get());
+#endif
 
 	return 0;
 }
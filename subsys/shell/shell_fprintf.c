@@ -7,24 +7,49 @@
 #include <zephyr/shell/shell_fprintf.h>
 #include <zephyr/shell/shell.h>
 #include <zephyr/sys/cbprintf.h>
+#include <string.h>
 
-static int out_func(int c, void *ctx)
+static void buf_put(const struct shell_fprintf *sh_fprintf, const char *buf, size_t len)
+{
+	while (len != 0) {
+		size_t n = MIN(len, sh_fprintf->buffer_size - sh_fprintf->ctrl_blk->buffer_cnt);
+
+		memcpy(&sh_fprintf->buffer[sh_fprintf->ctrl_blk->buffer_cnt], buf, n);
+		sh_fprintf->ctrl_blk->buffer_cnt += n;
+		buf += n;
+		len -= n;
+
+		if (sh_fprintf->ctrl_blk->buffer_cnt == sh_fprintf->buffer_size) {
+			z_shell_fprintf_buffer_flush(sh_fprintf);
+		}
+	}
+}
+
+static int out_func(const char *buf, size_t len, void *ctx)
 {
 	const struct shell_fprintf *sh_fprintf;
 	const struct shell *sh;
+	const char *end = buf + len;
 
 	sh_fprintf = (const struct shell_fprintf *)ctx;
 	sh = (const struct shell *)sh_fprintf->user_ctx;
 
-	if ((sh->shell_flag == SHELL_FLAG_OLF_CRLF) && (c == '\n')) {
-		(void)out_func('\r', ctx);
+	if (sh->shell_flag != SHELL_FLAG_OLF_CRLF) {
+		buf_put(sh_fprintf, buf, len);
+		return 0;
 	}
 
-	sh_fprintf->buffer[sh_fprintf->ctrl_blk->buffer_cnt] = (uint8_t)c;
-	sh_fprintf->ctrl_blk->buffer_cnt++;
+	while (buf < end) {
+		const char *nl = memchr(buf, '\n', end - buf);
 
-	if (sh_fprintf->ctrl_blk->buffer_cnt == sh_fprintf->buffer_size) {
-		z_shell_fprintf_buffer_flush(sh_fprintf);
+		if (nl == NULL) {
+			buf_put(sh_fprintf, buf, end - buf);
+			break;
+		}
+
+		buf_put(sh_fprintf, buf, nl - buf);
+		buf_put(sh_fprintf, "\r\n", 2);
+		buf = nl + 1;
 	}
 
 	return 0;
@@ -33,7 +58,7 @@ static int out_func(int c, void *ctx)
 void z_shell_fprintf_fmt(const struct shell_fprintf *sh_fprintf,
 			 const char *fmt, va_list args)
 {
-	(void)cbvprintf(out_func, (void *)sh_fprintf, fmt, args);
+	(void)cbvprintf_bulk(out_func, (void *)sh_fprintf, fmt, args);
 
 	if (sh_fprintf->ctrl_blk->autoflush) {
 		z_shell_fprintf_buffer_flush(sh_fprintf);
@@ -180,6 +180,9 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_work_queue_start_exit(queue)                                              \
 	SEGGER_SYSVIEW_RecordEndCall(TID_WORK_QUEUE_START)
 
+#define sys_port_trace_k_work_queue_worker_add_enter(queue, worker)
+#define sys_port_trace_k_work_queue_worker_add_exit(queue, worker, ret)
+
 #define sys_port_trace_k_work_queue_drain_enter(queue)                                             \
 	SEGGER_SYSVIEW_RecordU32(TID_WORK_QUEUE_DRAIN, (uint32_t)(uintptr_t)queue)
 
@@ -505,6 +508,12 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_msgq_get_enter(msgq, timeout)
 #define sys_port_trace_k_msgq_get_blocking(msgq, timeout)
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret)
 #define sys_port_trace_k_msgq_purge(msgq)
 
@@ -536,6 +545,12 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_pipe_get_enter(pipe, timeout)
 #define sys_port_trace_k_pipe_get_blocking(pipe, timeout)
 #define sys_port_trace_k_pipe_get_exit(pipe, timeout, ret)
+#define sys_port_trace_k_pipe_put_claim_enter(pipe, timeout)
+#define sys_port_trace_k_pipe_put_claim_blocking(pipe, timeout)
+#define sys_port_trace_k_pipe_put_claim_exit(pipe, timeout, ret)
+#define sys_port_trace_k_pipe_get_claim_enter(pipe, timeout)
+#define sys_port_trace_k_pipe_get_claim_blocking(pipe, timeout)
+#define sys_port_trace_k_pipe_get_claim_exit(pipe, timeout, ret)
 
 #define sys_port_trace_k_event_init(event)
 #define sys_port_trace_k_event_post_enter(event, events, events_mask)
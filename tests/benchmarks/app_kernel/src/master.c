@@ -130,6 +130,10 @@ static void test_thread_entry(void *p1, void *p2, void *p3)
 	}
 
 	pipe_test();
+
+	if (!skip_mem_and_mbox) {
+		pipe_claim_test();
+	}
 }
 
 /**
@@ -36,6 +36,8 @@
 #define NR_OF_MAP_RUNS 1000
 #define NR_OF_MBOX_RUNS 128
 #define NR_OF_PIPE_RUNS 256
+#define PIPE_CLAIM_MIN_SIZE 64
+#define PIPE_CLAIM_MAX_SIZE 4096
 #define SEMA_WAIT_TIME (5000)
 
 #ifdef CONFIG_USERSPACE
@@ -80,6 +82,7 @@ extern void message_queue_test(void);
 extern void mutex_test(void);
 extern void memorymap_test(void);
 extern void pipe_test(void);
+extern void pipe_claim_test(void);
 
 /* kernel objects needed for benchmarking */
 extern struct k_mutex DEMO_MUTEX;
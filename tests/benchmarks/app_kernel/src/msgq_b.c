@@ -8,6 +8,48 @@
 
 #include "master.h"
 
+/* Messages moved per k_msgq_put_many()/k_msgq_get_many() call */
+#define MSGQ_BATCH 20
+#define BATCH_STR  ", batches of " STRINGIFY(MSGQ_BATCH)
+
+BUILD_ASSERT((NR_OF_MSGQ_RUNS % MSGQ_BATCH) == 0);
+BUILD_ASSERT((192 * MSGQ_BATCH) <= MESSAGE_SIZE);
+
+/**
+ * @brief Batched message queue transfer speed test
+ *
+ * Moves NR_OF_MSGQ_RUNS messages in and out of @a msgq, MSGQ_BATCH at a
+ * time, and prints the average cost per message.
+ */
+static void message_queue_batch_test(struct k_msgq *msgq, const char *put_str,
+				     const char *get_str)
+{
+	uint32_t et; /* elapsed time */
+	int i;
+	timing_t  start;
+	timing_t  end;
+
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_MSGQ_RUNS; i += MSGQ_BATCH) {
+		k_msgq_put_many(msgq, data_bench, MSGQ_BATCH, K_FOREVER);
+	}
+	end = timing_timestamp_get();
+	et = (uint32_t)timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, put_str,
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_MSGQ_RUNS));
+
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_MSGQ_RUNS; i += MSGQ_BATCH) {
+		k_msgq_get_many(msgq, data_bench, MSGQ_BATCH, K_FOREVER);
+	}
+	end = timing_timestamp_get();
+	et = (uint32_t)timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, get_str,
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_MSGQ_RUNS));
+}
+
 /**
  * @brief Message queue transfer speed test
  */
@@ -78,6 +120,16 @@ void message_queue_test(void)
 	PRINT_F(FORMAT, "dequeue 192 bytes msg in MSGQ",
 		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_MSGQ_RUNS));
 
+	message_queue_batch_test(&DEMOQX1,
+				 "enqueue 1 byte msg in MSGQ" BATCH_STR,
+				 "dequeue 1 byte msg from MSGQ" BATCH_STR);
+	message_queue_batch_test(&DEMOQX4,
+				 "enqueue 4 bytes msg in MSGQ" BATCH_STR,
+				 "dequeue 4 bytes msg in MSGQ" BATCH_STR);
+	message_queue_batch_test(&DEMOQX192,
+				 "enqueue 192 bytes msg in MSGQ" BATCH_STR,
+				 "dequeue 192 bytes msg in MSGQ" BATCH_STR);
+
 	k_sem_give(&STARTRCV);
 
 	start = timing_timestamp_get();
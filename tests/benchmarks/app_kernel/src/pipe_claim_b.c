@@ -0,0 +1,123 @@
+/* pipe_claim_b.c */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "master.h"
+
+#define PRINT_HEADER()                                                       \
+	do {                                                                 \
+		PRINT_STRING("|   size(B) |       time/packet (nsec)       |" \
+			     "          KB/sec                |\n");         \
+		PRINT_STRING("|           |      copy     |   zero-copy    |" \
+			     "      copy     |   zero-copy    |\n");         \
+	} while (0)
+
+#define PRINT_ONE_RESULT()                                                   \
+	PRINT_F("|%11u|%15u|%16u|%15u|%16u|\n", putsize,                     \
+		puttime[0], puttime[1],                                      \
+		(uint32_t)(((uint64_t)putsize * 1000000U) /                  \
+			   SAFE_DIVISOR(puttime[0])),                        \
+		(uint32_t)(((uint64_t)putsize * 1000000U) /                  \
+			   SAFE_DIVISOR(puttime[1])))
+
+/**
+ * @brief Write a data portion to the pipe in place
+ *
+ * @return 0 on success, 1 on error
+ *
+ * @param pipe     The pipe to be tested.
+ * @param size     Data chunk size.
+ */
+static int pipe_claim_put(struct k_pipe *pipe, size_t size)
+{
+	uint8_t *area;
+	size_t claimed;
+
+	while (size != 0U) {
+		if (k_pipe_put_claim(pipe, &area, size, &claimed,
+				     K_FOREVER) != 0) {
+			return 1;
+		}
+
+		/* The data would be produced in place here */
+
+		(void)k_pipe_put_finish(pipe, claimed);
+		size -= claimed;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Stream data through the pipe and measure time
+ *
+ * @return Average time per data chunk, in nsec
+ *
+ * @param pipe     The pipe to be tested.
+ * @param claim    Write in place rather than copy the data.
+ * @param size     Data chunk size.
+ */
+static uint32_t pipe_stream(struct k_pipe *pipe, bool claim, uint32_t size)
+{
+	int i;
+	unsigned int t;
+	timing_t  start;
+	timing_t  end;
+	size_t sizexferd;
+	struct getinfo getinfo;
+
+	/* first sync with the receiver */
+	k_sem_give(&SEM0);
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_PIPE_RUNS; i++) {
+		if (claim) {
+			(void)pipe_claim_put(pipe, size);
+		} else {
+			(void)k_pipe_put(pipe, data_bench, size, &sizexferd,
+					 size, K_FOREVER);
+		}
+	}
+
+	/* waiting for the receiver to get all the data */
+	k_msgq_get(&CH_COMM, &getinfo, K_FOREVER);
+
+	end = timing_timestamp_get();
+	t = (unsigned int)timing_cycles_get(&start, &end);
+
+	return SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, NR_OF_PIPE_RUNS);
+}
+
+/**
+ * @brief Test the zero-copy pipe transfer speed
+ */
+void pipe_claim_test(void)
+{
+	uint32_t putsize;
+	uint32_t puttime[2];
+
+	k_sem_reset(&SEM0);
+	k_sem_give(&STARTRCV);
+
+	PRINT_STRING(dashline);
+	PRINT_STRING("|          "
+		     "Z E R O - C O P Y   P I P E   M E A S U R E M E N T S"
+		     "              |\n");
+	PRINT_STRING(dashline);
+	PRINT_F("| Stream data through a %4u bytes pipe buffer to the "
+		"receiving task          |\n", (uint32_t)PIPE_BIGBUFF.size);
+	PRINT_STRING(dashline);
+	PRINT_HEADER();
+	PRINT_STRING(dashline);
+
+	for (putsize = PIPE_CLAIM_MIN_SIZE; putsize <= PIPE_CLAIM_MAX_SIZE;
+	     putsize <<= 1) {
+		puttime[0] = pipe_stream(&PIPE_BIGBUFF, false, putsize);
+		puttime[1] = pipe_stream(&PIPE_BIGBUFF, true, putsize);
+		PRINT_ONE_RESULT();
+	}
+	PRINT_STRING(dashline);
+}
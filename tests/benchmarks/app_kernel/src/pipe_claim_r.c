@@ -0,0 +1,73 @@
+/* pipe_claim_r.c */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "receiver.h"
+#include "master.h"
+
+/**
+ * @brief Read a data portion from the pipe in place
+ *
+ * @return 0 on success, 1 on error
+ *
+ * @param pipe     Pipe to read data from.
+ * @param size     Data chunk size.
+ */
+static int pipe_claim_get(struct k_pipe *pipe, size_t size)
+{
+	uint8_t *area;
+	size_t claimed;
+
+	while (size != 0U) {
+		if (k_pipe_get_claim(pipe, &area, size, &claimed,
+				     K_FOREVER) != 0) {
+			return 1;
+		}
+
+		/* The data would be consumed in place here */
+
+		(void)k_pipe_get_finish(pipe, claimed);
+		size -= claimed;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Receive task for the zero-copy pipe transfer speed test
+ */
+void pipeclaimrecvtask(void)
+{
+	int getsize;
+	int claim;
+	int i;
+	size_t sizexferd;
+	struct getinfo getinfo = { 0 };
+
+	for (getsize = PIPE_CLAIM_MIN_SIZE; getsize <= PIPE_CLAIM_MAX_SIZE;
+	     getsize <<= 1) {
+		for (claim = 0; claim < 2; claim++) {
+			/* sync with the sender */
+			k_sem_take(&SEM0, K_FOREVER);
+			for (i = 0; i < NR_OF_PIPE_RUNS; i++) {
+				if (claim != 0) {
+					(void)pipe_claim_get(&PIPE_BIGBUFF,
+							     getsize);
+				} else {
+					(void)k_pipe_get(&PIPE_BIGBUFF,
+							 data_recv, getsize,
+							 &sizexferd, getsize,
+							 K_FOREVER);
+				}
+			}
+			getinfo.size = getsize;
+			getinfo.count = NR_OF_PIPE_RUNS;
+			/* acknowledge to master */
+			k_msgq_put(&CH_COMM, &getinfo, K_FOREVER);
+		}
+	}
+}
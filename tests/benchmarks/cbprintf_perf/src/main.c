@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief cbprintf output to a buffer
+ *
+ * Formats a few common strings to a buffer, one character at a time with
+ * cbvprintf() and in sequences with cbvprintf_bulk(), and reports the cycles
+ * taken per format. Both outputs must be identical.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/cbprintf.h>
+
+#define ITERATIONS 10000
+
+struct out_buf {
+	char data[128];
+	size_t len;
+};
+
+static struct out_buf char_buf, bulk_buf;
+
+static int char_out(int c, void *ctx)
+{
+	struct out_buf *buf = ctx;
+
+	if (buf->len < sizeof(buf->data)) {
+		buf->data[buf->len++] = (char)c;
+	}
+
+	return c;
+}
+
+static int bulk_out(const char *data, size_t len, void *ctx)
+{
+	struct out_buf *buf = ctx;
+	size_t n = MIN(len, sizeof(buf->data) - buf->len);
+
+	memcpy(&buf->data[buf->len], data, n);
+	buf->len += n;
+
+	return (int)len;
+}
+
+static int char_fmt(const char *fmt, ...)
+{
+	va_list ap;
+	int rc;
+
+	char_buf.len = 0;
+	va_start(ap, fmt);
+	rc = cbvprintf(char_out, &char_buf, fmt, ap);
+	va_end(ap);
+
+	return rc;
+}
+
+static int bulk_fmt(const char *fmt, ...)
+{
+	va_list ap;
+	int rc;
+
+	bulk_buf.len = 0;
+	va_start(ap, fmt);
+	rc = cbvprintf_bulk(bulk_out, &bulk_buf, fmt, ap);
+	va_end(ap);
+
+	return rc;
+}
+
+/* A format and its arguments, for both functions */
+#define BENCH(_name, _fmt, ...) do { \
+	timing_t start, end; \
+	uint64_t char_cycles, bulk_cycles; \
+	\
+	start = timing_counter_get(); \
+	for (int i = 0; i < ITERATIONS; i++) { \
+		(void)char_fmt(_fmt, __VA_ARGS__); \
+	} \
+	end = timing_counter_get(); \
+	char_cycles = timing_cycles_get(&start, &end); \
+	\
+	start = timing_counter_get(); \
+	for (int i = 0; i < ITERATIONS; i++) { \
+		(void)bulk_fmt(_fmt, __VA_ARGS__); \
+	} \
+	end = timing_counter_get(); \
+	bulk_cycles = timing_cycles_get(&start, &end); \
+	\
+	TC_PRINT("%-10s char %6u bulk %6u cycles per format\n", _name, \
+		 (uint32_t)(char_cycles / ITERATIONS), \
+		 (uint32_t)(bulk_cycles / ITERATIONS)); \
+	\
+	zassert_equal(char_fmt(_fmt, __VA_ARGS__), bulk_fmt(_fmt, __VA_ARGS__)); \
+	zassert_equal(char_buf.len, bulk_buf.len); \
+	zassert_mem_equal(char_buf.data, bulk_buf.data, char_buf.len); \
+} while (false)
+
+ZTEST(cbprintf_perf, test_formats)
+{
+	static const char *name = "thread_analyzer";
+
+	timing_init();
+	timing_start();
+
+	BENCH("literal", "%s", "Lorem ipsum dolor sit amet, consectetur adipiscing elit");
+	BENCH("text", "uptime: %u ms, free: %u of %u bytes\n", 123456789U, 5678U, 16384U);
+	BENCH("int", "%d %d %d %d", -1, 42, 1000000, INT_MIN);
+	BENCH("hex", "%08x %#x %p", 0xdeadbeefU, 0x1234U, (void *)name);
+	BENCH("string", "[%-20s] %.4s|%8s", name, name, "end");
+	BENCH("long", "%llu %lld", 18446744073709551615ULL, -1234567890123LL);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(cbprintf_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief CRC throughput
+ *
+ * Reports the bytes processed per thousand cycles by each CRC which depends
+ * on CONFIG_CRC_TABLE, CONFIG_CRC_X86 and CONFIG_CRC_ARM64, for short and
+ * long buffers. The results are checked against known values first.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/crc.h>
+
+#define ITERATIONS 100
+
+static uint8_t data[4096];
+
+static const uint8_t check[] = "123456789";
+
+static uint32_t crc32_ieee_run(const uint8_t *buf, size_t len)
+{
+	return crc32_ieee(buf, len);
+}
+
+static uint32_t crc32_c_run(const uint8_t *buf, size_t len)
+{
+	return crc32_c(0, buf, len, true, true);
+}
+
+static uint32_t crc16_ccitt_run(const uint8_t *buf, size_t len)
+{
+	return crc16_ccitt(0, buf, len);
+}
+
+static uint32_t crc16_itu_t_run(const uint8_t *buf, size_t len)
+{
+	return crc16_itu_t(0, buf, len);
+}
+
+static const struct {
+	const char *name;
+	uint32_t (*run)(const uint8_t *buf, size_t len);
+	uint32_t check;
+} crcs[] = {
+	{ "crc32_ieee", crc32_ieee_run, 0xcbf43926U },
+	{ "crc32_c", crc32_c_run, 0xe3069283U },
+	{ "crc16_ccitt", crc16_ccitt_run, 0x2189U },
+	{ "crc16_itu_t", crc16_itu_t_run, 0x31c3U },
+};
+
+static uint32_t bytes_per_kcycle(uint32_t (*run)(const uint8_t *buf, size_t len), size_t len)
+{
+	timing_t start, end;
+	uint64_t cycles;
+
+	start = timing_counter_get();
+	for (int i = 0; i < ITERATIONS; i++) {
+		(void)run(data, len);
+	}
+	end = timing_counter_get();
+	cycles = timing_cycles_get(&start, &end);
+
+	return (cycles == 0U) ? 0U : (uint32_t)(1000ULL * len * ITERATIONS / cycles);
+}
+
+ZTEST(crc_perf, test_throughput)
+{
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 31U + (i >> 8));
+	}
+
+	timing_init();
+	timing_start();
+
+	TC_PRINT("bytes per 1000 cycles, for %s tables%s\n",
+		 IS_ENABLED(CONFIG_CRC_TABLE_NIBBLE) ? "nibble" :
+		 IS_ENABLED(CONFIG_CRC_TABLE_BYTE) ? "byte" : "slicing-by-8",
+		 IS_ENABLED(CONFIG_CRC_HW) ? " and instructions" : "");
+
+	for (size_t i = 0; i < ARRAY_SIZE(crcs); i++) {
+		zassert_equal(crcs[i].run(check, sizeof(check) - 1), crcs[i].check, "%s",
+			      crcs[i].name);
+
+		TC_PRINT("%-12s 64 B: %6u 4 KiB: %6u\n", crcs[i].name,
+			 bytes_per_kcycle(crcs[i].run, 64),
+			 bytes_per_kcycle(crcs[i].run, sizeof(data)));
+	}
+
+	timing_stop();
+}
+
+ZTEST_SUITE(crc_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Lock-free queue throughput
+ *
+ * Puts and gets batches of elements of 4 bytes through a queue, from a
+ * single thread, and reports the elements per second for each batch size.
+ * The ring_buf under an irq_lock(), as its users need when putting from an
+ * interrupt, is the reference for the lock-free SPSC ring buffer.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/spsc_ring_buf.h>
+#include <zephyr/sys/mpmc_lockfree.h>
+
+#define ELEMS 64
+#define ELEM_SIZE sizeof(uint32_t)
+#define ITERATIONS 100000
+
+static const size_t batch_sizes[] = { 1, 4, 16, 64 };
+
+static uint32_t in[ELEMS], out[ELEMS];
+
+RING_BUF_DECLARE(locked_rb, ELEMS * ELEM_SIZE);
+SPSC_RING_BUF_DEFINE(lockfree_rb, ELEMS * ELEM_SIZE);
+MPMC_DEFINE(lockfree_q, ELEM_SIZE, ELEMS);
+
+static void locked_rb_put_get(size_t batch)
+{
+	unsigned int key;
+
+	key = irq_lock();
+	ring_buf_put(&locked_rb, (uint8_t *)in, batch * ELEM_SIZE);
+	irq_unlock(key);
+
+	key = irq_lock();
+	ring_buf_get(&locked_rb, (uint8_t *)out, batch * ELEM_SIZE);
+	irq_unlock(key);
+}
+
+static void lockfree_rb_put_get(size_t batch)
+{
+	spsc_ring_buf_put(&lockfree_rb, (uint8_t *)in, batch * ELEM_SIZE);
+	spsc_ring_buf_get(&lockfree_rb, (uint8_t *)out, batch * ELEM_SIZE);
+}
+
+static void mpmc_put_get(size_t batch)
+{
+	mpmc_put_many(&lockfree_q, in, batch);
+	mpmc_get_many(&lockfree_q, out, batch);
+}
+
+static void mpmc_put_get_single(size_t batch)
+{
+	for (size_t i = 0; i < batch; i++) {
+		mpmc_put(&lockfree_q, &in[i]);
+	}
+	for (size_t i = 0; i < batch; i++) {
+		mpmc_get(&lockfree_q, &out[i]);
+	}
+}
+
+static void run(const char *name, void (*put_get)(size_t batch))
+{
+	timing_t start_time, end_time;
+	uint64_t ns;
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(batch_sizes); i++) {
+		size_t batch = batch_sizes[i];
+		uint32_t iterations = ITERATIONS / batch;
+
+		start_time = timing_counter_get();
+
+		for (uint32_t j = 0; j < iterations; j++) {
+			put_get(batch);
+		}
+
+		end_time = timing_counter_get();
+		ns = timing_cycles_to_ns(timing_cycles_get(&start_time, &end_time));
+
+		/* One op is an element put and got */
+		TC_PRINT("%-16s batch %2zu: %u ops/s (%u ns per op)\n", name, batch,
+			 (uint32_t)(ns ? (uint64_t)iterations * batch * NSEC_PER_SEC / ns : 0),
+			 (uint32_t)(ns / ((uint64_t)iterations * batch)));
+	}
+
+	timing_stop();
+}
+
+ZTEST(lockfree_perf, test_ring_buf_irq_lock)
+{
+	run("ring_buf", locked_rb_put_get);
+	zassert_true(ring_buf_is_empty(&locked_rb));
+}
+
+ZTEST(lockfree_perf, test_spsc_ring_buf)
+{
+	run("spsc_ring_buf", lockfree_rb_put_get);
+	zassert_true(spsc_ring_buf_is_empty(&lockfree_rb));
+}
+
+ZTEST(lockfree_perf, test_mpmc)
+{
+	run("mpmc", mpmc_put_get);
+	zassert_false(mpmc_get(&lockfree_q, out));
+}
+
+ZTEST(lockfree_perf, test_mpmc_single)
+{
+	run("mpmc (single)", mpmc_put_get_single);
+	zassert_false(mpmc_get(&lockfree_q, out));
+}
+
+ZTEST_SUITE(lockfree_perf, NULL, NULL, NULL, NULL, NULL);
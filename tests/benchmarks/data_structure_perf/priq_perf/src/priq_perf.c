@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <ksched.h>
+#include <priority_q.h>
+
+/* Measures the cost of the multi-queue ready queue operations used by
+ * CONFIG_SCHED_MULTIQ: adding a thread, removing it, and looking up
+ * the best thread, with as many priorities as the build configures.
+ * The priq is driven directly with thread structs that are never
+ * started, so only the data structure itself is timed.
+ */
+
+#define NUM_THREADS 64
+#define NUM_PRIOS   K_NUM_THREAD_PRIO
+
+static struct k_thread threads[NUM_THREADS];
+static struct _priq_mq pq;
+
+static void pq_init(void)
+{
+	memset(&pq, 0, sizeof(pq));
+	for (int i = 0; i < ARRAY_SIZE(pq.queues); i++) {
+		sys_dlist_init(&pq.queues[i]);
+	}
+}
+
+static int thread_prio(int i)
+{
+	/* Spread the threads over the whole priority range, in an
+	 * order that is neither ascending nor descending
+	 */
+	return K_HIGHEST_THREAD_PRIO + (i * 37) % NUM_PRIOS;
+}
+
+static void report(const char *op, uint64_t cycles, uint32_t n)
+{
+	TC_PRINT("%-24s %3d priorities: %6u cycles (%6u ns) per op\n", op,
+		 NUM_PRIOS, (uint32_t)(cycles / n),
+		 (uint32_t)(timing_cycles_to_ns(cycles) / n));
+}
+
+static void add_all(void)
+{
+	for (int i = 0; i < NUM_THREADS; i++) {
+		z_priq_mq_add(&pq, &threads[i]);
+	}
+}
+
+static void remove_all(void)
+{
+	for (int i = 0; i < NUM_THREADS; i++) {
+		z_priq_mq_remove(&pq, &threads[i]);
+	}
+}
+
+ZTEST(priq_perf, test_priq_mq_add_remove)
+{
+	timing_t start, end;
+
+	pq_init();
+
+	start = timing_counter_get();
+	add_all();
+	end = timing_counter_get();
+	report("z_priq_mq_add", timing_cycles_get(&start, &end), NUM_THREADS);
+
+	start = timing_counter_get();
+	remove_all();
+	end = timing_counter_get();
+	report("z_priq_mq_remove", timing_cycles_get(&start, &end),
+	       NUM_THREADS);
+
+	zassert_is_null(z_priq_mq_best(&pq), "queue not empty");
+}
+
+ZTEST(priq_perf, test_priq_mq_best)
+{
+	timing_t start, end;
+	struct k_thread *best = NULL;
+	uint64_t cycles = 0U;
+
+	pq_init();
+	add_all();
+
+	/* Take the best thread out one at a time, so the lookup is
+	 * timed with the highest priority at every position
+	 */
+	for (int i = 0; i < NUM_THREADS; i++) {
+		struct k_thread *prev = best;
+
+		start = timing_counter_get();
+		best = z_priq_mq_best(&pq);
+		end = timing_counter_get();
+		cycles += timing_cycles_get(&start, &end);
+
+		zassert_not_null(best, "no best thread");
+		zassert_true(prev == NULL || prev->base.prio <= best->base.prio,
+			     "priority order broken");
+		z_priq_mq_remove(&pq, best);
+	}
+	report("z_priq_mq_best", cycles, NUM_THREADS);
+
+	zassert_is_null(z_priq_mq_best(&pq), "queue not empty");
+
+	/* Worst case for a scan: only the lowest priority is queued */
+	threads[0].base.prio = K_LOWEST_THREAD_PRIO;
+	z_priq_mq_add(&pq, &threads[0]);
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_THREADS; i++) {
+		best = z_priq_mq_best(&pq);
+	}
+	end = timing_counter_get();
+	report("z_priq_mq_best (lowest)", timing_cycles_get(&start, &end),
+	       NUM_THREADS);
+
+	zassert_equal_ptr(best, &threads[0], "wrong best thread");
+	z_priq_mq_remove(&pq, &threads[0]);
+	threads[0].base.prio = thread_prio(0);
+}
+
+static void *priq_perf_setup(void)
+{
+	for (int i = 0; i < NUM_THREADS; i++) {
+		threads[i].base.prio = thread_prio(i);
+	}
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+ZTEST_SUITE(priq_perf, NULL, priq_perf_setup, NULL, NULL, NULL);
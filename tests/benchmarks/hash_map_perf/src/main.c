@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Hashmap backends performance
+ *
+ * Reports the cycles per operation of each enabled sys_hashmap backend, for
+ * insertions growing the table, lookups of present and absent keys, churn
+ * (a removal and an insertion of a new key, at constant size), lookups after
+ * the churn and removals shrinking the table.
+ *
+ * Also reports the distribution of the cycles taken by single insertions,
+ * whose maximum is that of the insertions resizing the table, unless it is
+ * resized incrementally (CONFIG_SYS_HASH_MAP_INCREMENTAL_REHASH).
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/hash_map.h>
+
+#define N_ENTRIES 2048
+
+/* Insertions taking [2^(i-1), 2^i) cycles are counted in bin i */
+#define N_BINS 32
+
+SYS_HASHMAP_SC_DEFINE_STATIC(sc_map);
+SYS_HASHMAP_OA_LP_DEFINE_STATIC(oa_lp_map);
+SYS_HASHMAP_OA_RH_DEFINE_STATIC(oa_rh_map);
+#ifdef CONFIG_SYS_HASH_MAP_CXX
+SYS_HASHMAP_CXX_DEFINE_STATIC(cxx_map);
+#endif
+
+static const struct {
+	const char *name;
+	struct sys_hashmap *map;
+} backends[] = {
+	{ "sc", &sc_map },
+	{ "oa_lp", &oa_lp_map },
+	{ "oa_rh", &oa_rh_map },
+#ifdef CONFIG_SYS_HASH_MAP_CXX
+	{ "cxx", &cxx_map },
+#endif
+};
+
+enum {
+	INSERT,
+	LOOKUP,
+	MISS,
+	CHURN,
+	LOOKUP_CHURNED,
+	REMOVE,
+	N_MIXES,
+};
+
+static const char *const mix_names[] = {
+	"insert", "lookup", "miss", "churn", "lookup'", "remove",
+};
+
+/* Keys spread over 64 bits, as pointers or addresses would be */
+static inline uint64_t key_of(size_t i)
+{
+	return (uint64_t)(i + 1) * 0x9e3779b97f4a7c15ULL;
+}
+
+static uint32_t run(struct sys_hashmap *map, int mix)
+{
+	timing_t start, end;
+	uint64_t cycles;
+	size_t errors = 0;
+
+	start = timing_counter_get();
+
+	for (size_t i = 0; i < N_ENTRIES; i++) {
+		switch (mix) {
+		case INSERT:
+			errors += sys_hashmap_insert(map, key_of(i), i, NULL) != 1;
+			break;
+		case LOOKUP:
+			errors += !sys_hashmap_contains_key(map, key_of(i));
+			break;
+		case MISS:
+			errors += sys_hashmap_contains_key(map, key_of(N_ENTRIES * 2 + i));
+			break;
+		case CHURN:
+			errors += !sys_hashmap_remove(map, key_of(i), NULL);
+			errors += sys_hashmap_insert(map, key_of(N_ENTRIES + i), i, NULL) != 1;
+			break;
+		case LOOKUP_CHURNED:
+			errors += !sys_hashmap_contains_key(map, key_of(N_ENTRIES + i));
+			break;
+		case REMOVE:
+			errors += !sys_hashmap_remove(map, key_of(N_ENTRIES + i), NULL);
+			break;
+		default:
+			break;
+		}
+	}
+
+	end = timing_counter_get();
+	cycles = timing_cycles_get(&start, &end);
+
+	zassert_equal(errors, 0, "%s: %zu errors", mix_names[mix], errors);
+
+	return (uint32_t)(cycles / N_ENTRIES);
+}
+
+ZTEST(hash_map_perf, test_mixes)
+{
+	timing_init();
+	timing_start();
+
+	TC_PRINT("cycles per operation, %u entries\n", N_ENTRIES);
+	TC_PRINT("%-6s", "");
+	for (int mix = 0; mix < N_MIXES; mix++) {
+		TC_PRINT(" %8s", mix_names[mix]);
+	}
+	TC_PRINT("\n");
+
+	for (size_t i = 0; i < ARRAY_SIZE(backends); i++) {
+		TC_PRINT("%-6s", backends[i].name);
+		for (int mix = 0; mix < N_MIXES; mix++) {
+			TC_PRINT(" %8u", run(backends[i].map, mix));
+		}
+		TC_PRINT("\n");
+
+		zassert_true(sys_hashmap_is_empty(backends[i].map));
+		sys_hashmap_clear(backends[i].map, NULL, NULL);
+	}
+
+	timing_stop();
+}
+
+ZTEST(hash_map_perf, test_insert_latency)
+{
+	timing_t start, end;
+	uint64_t cycles;
+	uint64_t max_cycles;
+	uint32_t bins[N_BINS];
+
+	timing_init();
+	timing_start();
+
+	TC_PRINT("cycles per insertion, %u entries, incremental rehash %s\n", N_ENTRIES,
+		 IS_ENABLED(CONFIG_SYS_HASH_MAP_INCREMENTAL_REHASH) ? "on" : "off");
+
+	for (size_t i = 0; i < ARRAY_SIZE(backends); i++) {
+		struct sys_hashmap *map = backends[i].map;
+
+		memset(bins, 0, sizeof(bins));
+		max_cycles = 0;
+
+		for (size_t j = 0; j < N_ENTRIES; j++) {
+			start = timing_counter_get();
+			zassert_equal(sys_hashmap_insert(map, key_of(j), j, NULL), 1);
+			end = timing_counter_get();
+
+			cycles = timing_cycles_get(&start, &end);
+			bins[MIN(LOG2(cycles) + 1, N_BINS - 1)]++;
+			max_cycles = MAX(max_cycles, cycles);
+		}
+
+		TC_PRINT("%-6s max %llu\n", backends[i].name, (unsigned long long)max_cycles);
+		for (int bin = 0; bin < N_BINS; bin++) {
+			if (bins[bin] != 0) {
+				TC_PRINT("%6s < %-10llu %u\n", "", 1ULL << bin, bins[bin]);
+			}
+		}
+
+		sys_hashmap_clear(map, NULL, NULL);
+	}
+
+	timing_stop();
+}
+
+ZTEST_SUITE(hash_map_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief JSON parsing and encoding of a large array
+ *
+ * Encodes and parses an array of objects with the descriptor based functions,
+ * which need the whole payload in memory, and with the streaming parser and
+ * encoder, which go through it in chunks. Reports the cycles taken by each.
+ * Both must give the same results.
+ */
+
+#include <stdlib.h>
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/data/json.h>
+
+#define ITERATIONS 20
+#define NUM_ELEMS 100
+#define CHUNK_SIZE 64
+
+/* Without padding between the fields, as expected by the descriptors */
+struct elem {
+	const char *name;
+	int32_t id;
+	bool ok;
+};
+
+struct arr {
+	struct elem elems[NUM_ELEMS];
+	size_t len;
+};
+
+static const struct json_obj_descr elem_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct elem, id, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct elem, name, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct elem, ok, JSON_TOK_TRUE),
+};
+
+static const struct json_obj_descr arr_descr[] = {
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct arr, elems, NUM_ELEMS, len,
+				 elem_descr, ARRAY_SIZE(elem_descr)),
+};
+
+static const char *const names[] = {
+	"temperature", "humidity", "pressure", "light \"lux\"",
+};
+
+static struct arr values, parsed, stream_parsed;
+static char payload[NUM_ELEMS * 64];
+static char copy[sizeof(payload)];
+static size_t payload_len;
+
+struct sink {
+	char data[sizeof(payload)];
+	size_t len;
+};
+
+static struct sink stream_out;
+
+static int sink_write(const char *bytes, size_t len, void *data)
+{
+	struct sink *sink = data;
+
+	if (len > sizeof(sink->data) - sink->len) {
+		return -ENOMEM;
+	}
+
+	memcpy(&sink->data[sink->len], bytes, len);
+	sink->len += len;
+
+	return 0;
+}
+
+static int stream_encode(void)
+{
+	struct json_stream_encoder enc;
+	char buf[CHUNK_SIZE];
+	int ret;
+
+	stream_out.len = 0;
+	ret = json_stream_encoder_init(&enc, buf, sizeof(buf), sink_write, &stream_out);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret |= json_stream_encode_arr_start(&enc, NULL);
+	for (size_t i = 0; i < values.len; i++) {
+		ret |= json_stream_encode_obj_start(&enc, NULL);
+		ret |= json_stream_encode_number(&enc, "id", values.elems[i].id);
+		ret |= json_stream_encode_string(&enc, "name", values.elems[i].name);
+		ret |= json_stream_encode_bool(&enc, "ok", values.elems[i].ok);
+		ret |= json_stream_encode_obj_end(&enc);
+	}
+	ret |= json_stream_encode_arr_end(&enc);
+	ret |= json_stream_encoder_flush(&enc);
+
+	return ret;
+}
+
+static int32_t token_num(const struct json_stream_token *tok)
+{
+	char num[12];
+
+	if (tok->length >= sizeof(num)) {
+		return 0;
+	}
+
+	memcpy(num, tok->start, tok->length);
+	num[tok->length] = '\0';
+
+	return (int32_t)strtol(num, NULL, 10);
+}
+
+/* Fills stream_parsed, without the names which are only valid with their chunk */
+static int stream_parse(void)
+{
+	struct json_stream_parser parser;
+	struct json_stream_token tok;
+	char buf[32];
+	char field = '\0';
+	size_t pos = 0;
+	int ret;
+
+	stream_parsed.len = 0;
+	json_stream_parser_init(&parser, buf, sizeof(buf));
+
+	while (true) {
+		ret = json_stream_parser_next(&parser, &tok);
+		if (ret == -EAGAIN) {
+			size_t n = MIN(CHUNK_SIZE, payload_len - pos);
+
+			json_stream_parser_feed(&parser, &payload[pos], n);
+			pos += n;
+			continue;
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		struct elem *elem = &stream_parsed.elems[stream_parsed.len];
+
+		switch (tok.type) {
+		case JSON_TOK_EOF:
+			return 0;
+		case JSON_TOK_STRING:
+			if (tok.key) {
+				field = tok.start[0];
+			}
+			break;
+		case JSON_TOK_NUMBER:
+			if (field == 'i') {
+				elem->id = token_num(&tok);
+			}
+			break;
+		case JSON_TOK_TRUE:
+		case JSON_TOK_FALSE:
+			if (field == 'o') {
+				elem->ok = (tok.type == JSON_TOK_TRUE);
+			}
+			break;
+		case JSON_TOK_OBJECT_END:
+			if (stream_parsed.len == NUM_ELEMS) {
+				return -ENOMEM;
+			}
+			stream_parsed.len++;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static int arr_parse(void)
+{
+	/* Strings are terminated in place */
+	memcpy(copy, payload, payload_len);
+
+	return json_arr_parse(copy, payload_len, arr_descr, &parsed);
+}
+
+static int arr_copy(void)
+{
+	memcpy(copy, payload, payload_len);
+
+	return 0;
+}
+
+#define BENCH(_func) ({ \
+	timing_t start, end; \
+	\
+	start = timing_counter_get(); \
+	for (int i = 0; i < ITERATIONS; i++) { \
+		zassert_ok(_func()); \
+	} \
+	end = timing_counter_get(); \
+	(uint32_t)(timing_cycles_get(&start, &end) / ITERATIONS); \
+})
+
+static int arr_encode(void)
+{
+	return json_arr_encode_buf(arr_descr, &values, payload, sizeof(payload));
+}
+
+ZTEST(json_perf, test_array)
+{
+	uint32_t arr_cycles, stream_cycles, copy_cycles;
+
+	values.len = NUM_ELEMS;
+	for (size_t i = 0; i < NUM_ELEMS; i++) {
+		values.elems[i] = (struct elem) {
+			.id = (int32_t)(i * 7919U) - 100000,
+			.name = names[i % ARRAY_SIZE(names)],
+			.ok = (i % 3) == 0,
+		};
+	}
+
+	timing_init();
+	timing_start();
+
+	arr_cycles = BENCH(arr_encode);
+	stream_cycles = BENCH(stream_encode);
+	payload_len = strlen(payload);
+	TC_PRINT("encode %zu bytes: json_arr_encode_buf %u stream %u cycles\n",
+		 payload_len, arr_cycles, stream_cycles);
+	zassert_equal(stream_out.len, payload_len);
+	zassert_mem_equal(stream_out.data, payload, payload_len);
+
+	copy_cycles = BENCH(arr_copy);
+	arr_cycles = BENCH(arr_parse);
+	stream_cycles = BENCH(stream_parse);
+	TC_PRINT("parse %zu bytes: json_arr_parse %u stream %u cycles\n",
+		 payload_len, arr_cycles - MIN(arr_cycles, copy_cycles), stream_cycles);
+
+	timing_stop();
+
+	zassert_equal(parsed.len, NUM_ELEMS);
+	zassert_equal(stream_parsed.len, NUM_ELEMS);
+	for (size_t i = 0; i < NUM_ELEMS; i++) {
+		zassert_equal(parsed.elems[i].id, values.elems[i].id);
+		zassert_equal(parsed.elems[i].ok, values.elems[i].ok);
+		zassert_equal(stream_parsed.elems[i].id, values.elems[i].id);
+		zassert_equal(stream_parsed.elems[i].ok, values.elems[i].ok);
+	}
+}
+
+ZTEST_SUITE(json_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure time to post events with many waiters
+ *
+ * This file contains the test that measures the time to post events to an
+ * event object on which a number of threads wait, and which wakes all of
+ * them. The context switches to the woken threads are not accounted for:
+ * the scheduler is locked while posting.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+#include "timing_sc.h"
+
+#define MAX_WAITERS        16
+#define WAITER_STACK_SIZE  (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define BENCH_EVENT        0x1
+
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, MAX_WAITERS,
+				   WAITER_STACK_SIZE);
+static struct k_thread waiter_threads[MAX_WAITERS];
+
+static K_EVENT_DEFINE(waiters_event);
+
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t  num_iterations = (uint32_t)(uintptr_t)p1;
+	uint32_t  i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < num_iterations; i++) {
+		k_event_wait(&waiters_event, BENCH_EVENT, false, K_FOREVER);
+	}
+}
+
+/**
+ *
+ * @brief Test for the time to post events waking several threads
+ *
+ * The routine starts @a num_waiters threads of higher priority, which
+ * wait on an event object, then posts the event they wait for multiple
+ * times to measure the necessary time. The woken threads only run, and
+ * wait again, once the scheduler is unlocked.
+ *
+ * @return 0 on success
+ */
+int event_waiters_ops(uint32_t num_iterations, uint32_t num_waiters)
+{
+	char      tag[50];
+	char      description[120];
+	int       priority;
+	timing_t  start;
+	timing_t  finish;
+	uint64_t  cycles = 0;
+	uint32_t  i;
+
+	__ASSERT_NO_MSG(num_waiters <= MAX_WAITERS);
+
+	timing_start();
+
+	priority = k_thread_priority_get(k_current_get());
+
+	k_event_clear(&waiters_event, BENCH_EVENT);
+
+	/* The waiters run right away, and wait for the event */
+	for (i = 0; i < num_waiters; i++) {
+		k_thread_create(&waiter_threads[i], waiter_stacks[i],
+				K_THREAD_STACK_SIZEOF(waiter_stacks[i]),
+				waiter_entry,
+				(void *)(uintptr_t)num_iterations, NULL, NULL,
+				priority - 1, 0, K_NO_WAIT);
+	}
+
+	for (i = 0; i < num_iterations; i++) {
+		k_sched_lock();
+
+		start = timing_timestamp_get();
+		k_event_post(&waiters_event, BENCH_EVENT);
+		finish = timing_timestamp_get();
+
+		cycles += timing_cycles_get(&start, &finish);
+
+		/* Have the waiters wait again once they have run */
+		k_event_clear(&waiters_event, BENCH_EVENT);
+		k_sched_unlock();
+	}
+
+	for (i = 0; i < num_waiters; i++) {
+		k_thread_join(&waiter_threads[i], K_FOREVER);
+	}
+
+	snprintf(tag, sizeof(tag), "events.post.wake_%u.kernel", num_waiters);
+	snprintf(description, sizeof(description),
+		 "%-40s - Post events with %u waiters (no ctx switch)",
+		 tag, num_waiters);
+	PRINT_STATS_AVG(description, (uint32_t)cycles, num_iterations,
+			false, "");
+
+	timing_stop();
+
+	return 0;
+}
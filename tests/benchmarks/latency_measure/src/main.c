@@ -40,6 +40,7 @@ extern void thread_switch_yield(uint32_t num_iterations, bool is_cooperative);
 extern void int_to_thread(uint32_t num_iterations);
 extern void sema_test_signal(uint32_t num_iterations, uint32_t options);
 extern void mutex_lock_unlock(uint32_t num_iterations, uint32_t options);
+extern int sys_mutex_sem_ops(uint32_t num_iterations, uint32_t options);
 extern void sema_context_switch(uint32_t num_iterations,
 				uint32_t start_options, uint32_t alt_options);
 extern int thread_ops(uint32_t num_iterations, uint32_t start_options,
@@ -53,12 +54,14 @@ extern int lifo_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 extern int event_ops(uint32_t num_iterations, uint32_t options);
 extern int event_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 			      uint32_t alt_options);
+extern int event_waiters_ops(uint32_t num_iterations, uint32_t num_waiters);
 extern int condvar_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 				uint32_t alt_options);
 extern int stack_ops(uint32_t num_iterations, uint32_t options);
 extern int stack_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 			       uint32_t alt_options);
 extern void heap_malloc_free(void);
+extern int timeout_smp_contention(uint32_t num_iterations);
 
 static void test_thread(void *arg1, void *arg2, void *arg3)
 {
@@ -84,6 +87,14 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 
 	timestamp_overhead_init(CONFIG_BENCHMARK_NUM_ITERATIONS);
 
+#if defined(CONFIG_SMP) && (CONFIG_MP_MAX_NUM_CPUS > 1)
+	/* All other measurements assume a single CPU */
+	timeout_smp_contention(CONFIG_BENCHMARK_NUM_ITERATIONS);
+
+	TC_END_REPORT(error_count);
+	return;
+#endif
+
 	/* Preemptive threads context switching */
 	thread_switch_yield(CONFIG_BENCHMARK_NUM_ITERATIONS, false);
 
@@ -138,6 +149,10 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 	event_blocking_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER, K_USER);
 #endif
 
+	event_waiters_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, 1);
+	event_waiters_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, 4);
+	event_waiters_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, 16);
+
 	sema_test_signal(CONFIG_BENCHMARK_NUM_ITERATIONS, 0);
 #ifdef CONFIG_USERSPACE
 	sema_test_signal(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER);
@@ -174,6 +189,11 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 	mutex_lock_unlock(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER);
 #endif
 
+	sys_mutex_sem_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, 0);
+#ifdef CONFIG_USERSPACE
+	sys_mutex_sem_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER);
+#endif
+
 	heap_malloc_free();
 
 	TC_END_REPORT(error_count);
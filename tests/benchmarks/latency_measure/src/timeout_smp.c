@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure timeout queue contention between CPUs
+ *
+ * This file contains the test that measures the time to start and stop
+ * a kernel timer, first on a single CPU and then on all CPUs at once,
+ * each CPU using its own timer.  The difference between the two shows
+ * how much the CPUs contend on the kernel timeout queue.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+#include "timing_sc.h"
+
+#if defined(CONFIG_SMP) && (CONFIG_MP_MAX_NUM_CPUS > 1)
+
+#define TIMER_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(timer_stacks, CONFIG_MP_MAX_NUM_CPUS,
+				   TIMER_STACK_SIZE);
+static struct k_thread timer_threads[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_timer timers[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t timer_cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static K_SEM_DEFINE(go_sem, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+static void start_stop_timer(void *p1, void *p2, void *p3)
+{
+	uint32_t  i;
+	uint32_t  id = (uint32_t)(uintptr_t)p1;
+	uint32_t  num_iterations = (uint32_t)(uintptr_t)p2;
+	timing_t  start;
+	timing_t  finish;
+
+	ARG_UNUSED(p3);
+
+	k_sem_take(&go_sem, K_FOREVER);
+
+	start = timing_timestamp_get();
+
+	for (i = 0; i < num_iterations; i++) {
+		k_timer_start(&timers[id], K_SECONDS(10), K_NO_WAIT);
+		k_timer_stop(&timers[id]);
+	}
+
+	finish = timing_timestamp_get();
+
+	timer_cycles[id] = timing_cycles_get(&start, &finish);
+}
+
+static uint64_t run_timer_threads(uint32_t num_threads, uint32_t num_iterations)
+{
+	uint64_t  cycles = 0;
+	int       priority;
+	uint32_t  i;
+
+	priority = k_thread_priority_get(k_current_get());
+
+	for (i = 0; i < num_threads; i++) {
+		k_timer_init(&timers[i], NULL, NULL);
+		k_thread_create(&timer_threads[i], timer_stacks[i],
+				K_THREAD_STACK_SIZEOF(timer_stacks[i]),
+				start_stop_timer,
+				(void *)(uintptr_t)i,
+				(void *)(uintptr_t)num_iterations, NULL,
+				priority - 1, 0, K_NO_WAIT);
+	}
+
+	/* Release all threads at once, so they overlap as much as possible */
+	for (i = 0; i < num_threads; i++) {
+		k_sem_give(&go_sem);
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_join(&timer_threads[i], K_FOREVER);
+		cycles += timer_cycles[i];
+	}
+
+	return cycles / num_threads;
+}
+
+/**
+ *
+ * @brief Test for timeout queue contention between CPUs
+ *
+ * The routine starts and stops a timer in a loop, first on a single
+ * CPU and then concurrently on every CPU in the system.
+ *
+ * @return 0 on success
+ */
+int timeout_smp_contention(uint32_t num_iterations)
+{
+	char tag[50];
+	char description[120];
+	uint32_t  num_cpus = arch_num_cpus();
+	uint64_t  cycles;
+
+	timing_start();
+
+	cycles = run_timer_threads(1, num_iterations);
+
+	snprintf(tag, sizeof(tag), "timer.start_stop.smp.1cpu");
+	snprintf(description, sizeof(description),
+		 "%-40s - Start and stop a timer on 1 CPU", tag);
+	PRINT_STATS_AVG(description, (uint32_t)cycles, num_iterations,
+			false, "");
+
+	cycles = run_timer_threads(num_cpus, num_iterations);
+
+	snprintf(tag, sizeof(tag), "timer.start_stop.smp.%ucpu", num_cpus);
+	snprintf(description, sizeof(description),
+		 "%-40s - Start and stop a timer on %u CPUs at once", tag,
+		 num_cpus);
+	PRINT_STATS_AVG(description, (uint32_t)cycles, num_iterations,
+			false, "");
+
+	timing_stop();
+	return 0;
+}
+
+#endif /* CONFIG_SMP && CONFIG_MP_MAX_NUM_CPUS > 1 */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* This is a small block allocator throughput benchmark.  A number of
+ * threads each keep a window of live blocks of 16 to 256 bytes, and
+ * repeatedly free the oldest and allocate a new one of another size,
+ * as networking or JSON code handling short-lived buffers would.  It
+ * is run against a plain k_heap, i.e. sys_heap under a single lock,
+ * and against k_malloc(), which goes through the per-CPU block cache
+ * when CONFIG_HEAP_MEM_POOL_CACHE is enabled.
+ */
+
+#define NUM_THREADS	4
+#define NUM_OPS		20000
+#define WINDOW		8
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_HEAP_DEFINE(plain_heap, CONFIG_HEAP_MEM_POOL_SIZE);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+static K_SEM_DEFINE(go_sem, 0, NUM_THREADS);
+static uint32_t failures;
+
+#if defined(CONFIG_HEAP_MEM_POOL_CACHE)
+#define CACHE "enabled"
+#else
+#define CACHE "disabled"
+#endif
+
+static void *plain_alloc(size_t size)
+{
+	return k_heap_alloc(&plain_heap, size, K_NO_WAIT);
+}
+
+static void plain_free(void *ptr)
+{
+	k_heap_free(&plain_heap, ptr);
+}
+
+struct allocator {
+	const char *name;
+	void *(*alloc)(size_t size);
+	void (*free)(void *ptr);
+};
+
+static const struct allocator allocators[] = {
+	{ "sys_heap", plain_alloc, plain_free },
+	{ "k_malloc", k_malloc, k_free },
+};
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	const struct allocator *a = p1;
+	uint32_t seed = (uint32_t)(uintptr_t)p2;
+	void *live[WINDOW] = { NULL };
+
+	ARG_UNUSED(p3);
+
+	k_sem_take(&go_sem, K_FOREVER);
+
+	for (uint32_t i = 0; i < NUM_OPS; i++) {
+		uint32_t slot = i % WINDOW;
+
+		a->free(live[slot]);
+
+		/* Pseudo-random, but reproducible, sizes of 16-256 bytes */
+		seed = seed * 1103515245U + 12345U;
+		live[slot] = a->alloc(16 + (seed >> 16) % 241);
+		if (live[slot] == NULL) {
+			failures++;
+		}
+	}
+
+	for (uint32_t slot = 0; slot < WINDOW; slot++) {
+		a->free(live[slot]);
+	}
+}
+
+static void run(const struct allocator *a, int num_threads)
+{
+	timing_t start, end;
+	uint64_t ns;
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_create(&threads[i], stacks[i],
+				K_THREAD_STACK_SIZEOF(stacks[i]), worker,
+				(void *)a, (void *)(uintptr_t)(i + 1), NULL,
+				prio, 0, K_NO_WAIT);
+	}
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < num_threads; i++) {
+		k_sem_give(&go_sem);
+	}
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	end = timing_counter_get();
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	/* One op is a free plus an allocation */
+	printk("%-8s %d threads: %u ops/s (%u ns per op)\n", a->name,
+	       num_threads,
+	       (uint32_t)(ns ? (uint64_t)num_threads * NUM_OPS * NSEC_PER_SEC / ns : 0),
+	       (uint32_t)(ns / ((uint64_t)num_threads * NUM_OPS)));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("Small block allocator benchmark (cache %s, %u CPUs)\n",
+	       CACHE, arch_num_cpus());
+
+	for (int i = 0; i < ARRAY_SIZE(allocators); i++) {
+		run(&allocators[i], 1);
+		run(&allocators[i], NUM_THREADS);
+	}
+
+	timing_stop();
+
+	if (failures != 0) {
+		printk("Error: %u allocations failed\n", failures);
+	}
+
+	printk("PROJECT EXECUTION SUCCESSFUL\n");
+	return 0;
+}
@@ -32,10 +32,30 @@
 #define N_RUNS 1000
 #define N_SETTLE 10
 
+/* After that, it measures context switch throughput: NUM_WORKERS
+ * threads of equal priority loop calling k_yield(), each of which
+ * switches to the next ready worker, and the total number of switches
+ * per second is reported.  To show how this scales with the number of
+ * CPUs, it is repeated for every CPU count from 1 to arch_num_cpus(),
+ * with the CPUs not in use kept busy by "hog" threads of higher
+ * priority that never enter the scheduler.
+ */
+#define NUM_WORKERS (4 * CONFIG_MP_MAX_NUM_CPUS)
+#define THROUGHPUT_MS 1000
+
 
 static K_THREAD_STACK_DEFINE(partner_stack, 1024);
 static struct k_thread partner_thread;
 
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, 1024);
+static struct k_thread worker_threads[NUM_WORKERS];
+static uint32_t worker_switches[NUM_WORKERS];
+
+static K_THREAD_STACK_ARRAY_DEFINE(hog_stacks, CONFIG_MP_MAX_NUM_CPUS, 512);
+static struct k_thread hog_threads[CONFIG_MP_MAX_NUM_CPUS];
+
+static volatile bool throughput_done;
+
 _wait_q_t waitq;
 
 enum {
@@ -88,6 +108,87 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 	}
 }
 
+/* On native targets simulated time only advances while the CPU idles
+ * or busy waits, so the measurement would otherwise never end there.
+ */
+static inline void throughput_spin(void)
+{
+	if (IS_ENABLED(CONFIG_ARCH_POSIX)) {
+		k_busy_wait(1);
+	}
+}
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	uint32_t *switches = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (!throughput_done) {
+		k_yield();
+		(*switches)++;
+		throughput_spin();
+	}
+}
+
+static void hog_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (!throughput_done) {
+		throughput_spin();
+	}
+}
+
+static void switch_throughput(int main_prio, unsigned int num_cpus)
+{
+	unsigned int num_hogs = arch_num_cpus() - num_cpus;
+	uint64_t switches = 0U;
+	int64_t start, elapsed;
+
+	throughput_done = false;
+
+	for (unsigned int i = 0; i < num_hogs; i++) {
+		k_thread_create(&hog_threads[i], hog_stacks[i],
+				K_THREAD_STACK_SIZEOF(hog_stacks[i]),
+				hog_fn, NULL, NULL, NULL,
+				main_prio + 1, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		worker_switches[i] = 0U;
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				worker_fn, &worker_switches[i], NULL, NULL,
+				main_prio + 2, 0, K_NO_WAIT);
+	}
+
+	start = k_uptime_get();
+	k_sleep(K_MSEC(THROUGHPUT_MS));
+	elapsed = k_uptime_delta(&start);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		switches += worker_switches[i];
+	}
+
+	throughput_done = true;
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+	}
+	for (unsigned int i = 0; i < num_hogs; i++) {
+		k_thread_join(&hog_threads[i], K_FOREVER);
+	}
+
+	printk("throughput cpus %u threads %d switches/s %u (per cpu %u)\n",
+	       num_cpus, NUM_WORKERS,
+	       (uint32_t)(switches * 1000U / elapsed),
+	       (uint32_t)(switches * 1000U / elapsed / num_cpus));
+}
+
 int main(void)
 {
 	z_waitq_init(&waitq);
@@ -150,6 +251,11 @@ int main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+	for (unsigned int n = 1; n <= arch_num_cpus(); n++) {
+		switch_throughput(main_prio, n);
+	}
+
 	printk("fin\n");
 	return 0;
 }
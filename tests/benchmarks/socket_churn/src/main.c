@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* This is a socket open/close throughput benchmark.  Most of the file
+ * descriptor table is filled with socket pairs kept open, then threads
+ * repeatedly create a socket pair, yield to the others and close it, so
+ * that descriptors are reserved and released concurrently.
+ */
+
+#ifdef CONFIG_ZVFS_OPEN_DYNAMIC
+#define FD_MAX		CONFIG_ZVFS_OPEN_DYNAMIC_MAX
+#else
+#define FD_MAX		CONFIG_ZVFS_OPEN_MAX
+#endif
+
+#define NUM_THREADS	4
+#define NUM_PAIRS	256
+/* Leave room for stdio and a pair per thread */
+#define HELD_PAIRS	((FD_MAX - 3) / 2 - NUM_THREADS)
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct churn_stats {
+	uint64_t open_ns;
+	uint64_t open_max_ns;
+	uint32_t errors;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+static struct churn_stats stats[NUM_THREADS];
+static int held[HELD_PAIRS][2];
+
+static void churn(void *p1, void *p2, void *p3)
+{
+	struct churn_stats *st = p1;
+	timing_t start, end;
+	uint64_t ns;
+	int sv[2];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NUM_PAIRS; i++) {
+		start = timing_counter_get();
+		if (zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+			st->errors++;
+			continue;
+		}
+		end = timing_counter_get();
+
+		ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+		st->open_ns += ns;
+		st->open_max_ns = MAX(st->open_max_ns, ns);
+
+		/* Let the other threads open theirs meanwhile */
+		k_yield();
+
+		(void)zsock_close(sv[0]);
+		(void)zsock_close(sv[1]);
+	}
+}
+
+static void run(int num_threads)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+	timing_t start, end;
+	uint64_t ns, open_ns = 0, open_max_ns = 0;
+	uint32_t errors = 0;
+
+	memset(stats, 0, sizeof(stats));
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_create(&threads[i], stacks[i], K_THREAD_STACK_SIZEOF(stacks[i]),
+				churn, &stats[i], NULL, NULL, prio, 0, K_NO_WAIT);
+	}
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		open_ns += stats[i].open_ns;
+		open_max_ns = MAX(open_max_ns, stats[i].open_max_ns);
+		errors += stats[i].errors;
+	}
+
+	end = timing_counter_get();
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	printk("%d threads: %u pairs/s, open latency %u us (max %u us)\n",
+	       num_threads,
+	       (uint32_t)(ns ? (uint64_t)num_threads * NUM_PAIRS * NSEC_PER_SEC / ns : 0),
+	       (uint32_t)(open_ns / (num_threads * NUM_PAIRS) / NSEC_PER_USEC),
+	       (uint32_t)(open_max_ns / NSEC_PER_USEC));
+
+	if (errors != 0) {
+		printk("%u socket pairs could not be created\n", errors);
+	}
+}
+
+int main(void)
+{
+	int n;
+
+	timing_init();
+	timing_start();
+
+	for (n = 0; n < HELD_PAIRS; n++) {
+		if (zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, held[n]) < 0) {
+			break;
+		}
+	}
+
+	printk("Socket churn benchmark (%u CPUs, %d fds held)\n", arch_num_cpus(), 2 * n);
+
+	run(1);
+	run(NUM_THREADS);
+
+	while (n-- > 0) {
+		(void)zsock_close(held[n][0]);
+		(void)zsock_close(held[n][1]);
+	}
+
+	timing_stop();
+
+	printk("PROJECT EXECUTION SUCCESSFUL\n");
+	return 0;
+}
@@ -0,0 +1,166 @@
+/* mem_slab_smp.c */
+
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "syskernel.h"
+
+#if CONFIG_MP_MAX_NUM_CPUS > 1
+
+#define SMP_SLAB_BLOCK_SIZE  (32)
+#define SMP_SLAB_BLOCK_CNT   (16 * CONFIG_MP_MAX_NUM_CPUS)
+#define SMP_SLAB_BLOCK_ALIGN (4)
+
+/* Blocks each thread holds at once, so that the per-CPU caches (if
+ * any) have to be refilled and drained now and then
+ */
+#define SMP_SLAB_BURST       (4)
+
+K_MEM_SLAB_DEFINE_STATIC(smp_slab,
+		  SMP_SLAB_BLOCK_SIZE,
+		  SMP_SLAB_BLOCK_CNT,
+		  SMP_SLAB_BLOCK_ALIGN);
+
+static K_THREAD_STACK_ARRAY_DEFINE(smp_stacks, CONFIG_MP_MAX_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread smp_threads[CONFIG_MP_MAX_NUM_CPUS];
+
+static K_SEM_DEFINE(smp_done, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+static atomic_t smp_ready;
+static atomic_t smp_running;
+static atomic_t smp_failures;
+static uint32_t smp_start;
+static uint32_t smp_end;
+
+/**
+ *
+ * @brief Memslab thread for the multi-CPU test.
+ *
+ * Waits for all the other threads to be running, then allocates and
+ * frees bursts of blocks from the shared slab.  The last thread to
+ * start records the start time and the last one to finish the end
+ * time.
+ *
+ * @param p1 Number of threads.
+ * @param p2 Number of loops to run.
+ * @param p3 Unused.
+ */
+static void mem_slab_smp_thread(void *p1, void *p2, void *p3)
+{
+	atomic_val_t nthreads = (atomic_val_t)(uintptr_t)p1;
+	int no_of_loops = (int)(uintptr_t)p2;
+	void *blocks[SMP_SLAB_BURST];
+
+	ARG_UNUSED(p3);
+
+	if (atomic_inc(&smp_ready) == nthreads - 1) {
+		smp_start = k_cycle_get_32();
+		atomic_set(&smp_running, 1);
+	}
+	while (atomic_get(&smp_running) == 0) {
+		arch_spin_relax();
+	}
+
+	for (int i = 0; i < no_of_loops; i++) {
+		for (int j = 0; j < SMP_SLAB_BURST; j++) {
+			if (k_mem_slab_alloc(&smp_slab, &blocks[j],
+					     K_NO_WAIT) != 0) {
+				atomic_inc(&smp_failures);
+				blocks[j] = NULL;
+			}
+		}
+		for (int j = 0; j < SMP_SLAB_BURST; j++) {
+			if (blocks[j] != NULL) {
+				k_mem_slab_free(&smp_slab, blocks[j]);
+			}
+		}
+	}
+
+	if (atomic_dec(&smp_ready) == 1) {
+		smp_end = k_cycle_get_32();
+	}
+	k_sem_give(&smp_done);
+}
+
+/**
+ *
+ * @brief Runs the memslab threads on the given number of CPUs.
+ *
+ * @return 1 if success and 0 on failure
+ */
+static int mem_slab_smp_run(unsigned int ncpus)
+{
+	char title[32];
+	uint64_t ns;
+
+	snprintf(title, sizeof(title), "Memslab SMP %u CPU(s)", ncpus);
+	fprintf(output_file, sz_test_case_fmt, title);
+	fprintf(output_file, sz_description,
+		"\n\tk_mem_slab_alloc"
+		"\n\tk_mem_slab_free");
+	printf(sz_test_start_fmt);
+
+	atomic_set(&smp_ready, 0);
+	atomic_set(&smp_running, 0);
+	atomic_set(&smp_failures, 0);
+
+	for (unsigned int i = 0; i < ncpus; i++) {
+		k_thread_create(&smp_threads[i], smp_stacks[i], STACK_SIZE,
+				mem_slab_smp_thread,
+				(void *)(uintptr_t)ncpus,
+				(void *)(uintptr_t)number_of_loops, NULL,
+				K_PRIO_COOP(1), 0, K_NO_WAIT);
+	}
+	for (unsigned int i = 0; i < ncpus; i++) {
+		k_sem_take(&smp_done, K_FOREVER);
+	}
+	for (unsigned int i = 0; i < ncpus; i++) {
+		k_thread_join(&smp_threads[i], K_FOREVER);
+	}
+
+	if ((atomic_get(&smp_failures) != 0) ||
+	    (k_mem_slab_num_used_get(&smp_slab) != 0)) {
+		fprintf(output_file, sz_case_result_fmt, sz_fail);
+		fprintf(output_file, sz_case_details_fmt,
+			"allocation failures or leaked blocks");
+		fprintf(output_file, sz_case_end_fmt);
+		return 0;
+	}
+
+	/* Time per alloc/free pair, all CPUs together */
+	ns = k_cyc_to_ns_floor64(smp_end - smp_start) /
+	     ((uint64_t)ncpus * number_of_loops * SMP_SLAB_BURST);
+
+	fprintf(output_file, sz_case_result_fmt, sz_success);
+	fprintf(output_file, sz_case_details_fmt,
+		"Average time for 1 iteration: ");
+	fprintf(output_file, sz_case_timing_fmt, (uint32_t)ns);
+	fprintf(output_file, sz_case_end_fmt);
+
+	return 1;
+}
+
+/**
+ *
+ * @brief Memslab contention test, from 1 to all CPUs.
+ *
+ * One alloc/free pair counts as an iteration.
+ *
+ * @return Number of successful CPU counts.
+ */
+int mem_slab_smp_test(void)
+{
+	int return_value = 0;
+
+	for (unsigned int ncpus = 1; ncpus <= arch_num_cpus(); ncpus++) {
+		return_value += mem_slab_smp_run(ncpus);
+	}
+
+	return return_value;
+}
+
+#endif /* CONFIG_MP_MAX_NUM_CPUS > 1 */
@@ -157,6 +157,21 @@ int main(void)
 
 		test_result = 0;
 
+#if CONFIG_MP_MAX_NUM_CPUS > 1
+		/* The other tests assume a single CPU: only measure
+		 * memory slab contention from 1 to all CPUs.
+		 */
+		test_result += mem_slab_smp_test();
+
+		if (test_result == arch_num_cpus()) {
+			fprintf(output_file, sz_module_result_fmt, sz_success);
+		} else {
+			fprintf(output_file, sz_module_result_fmt, sz_fail);
+		}
+		TC_PRINT_RUNID;
+		continue;
+#endif
+
 		test_result += sema_test();
 		test_result += lifo_test();
 		test_result += fifo_test();
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/drivers/timer/system_timer.h>
+#include <timeout_q.h>
+
+/* This is a timeout queue microbenchmark.  It measures the cost of
+ * z_add_timeout(), z_abort_timeout() and of expiring timeouts from
+ * sys_clock_announce() with different numbers of timeouts pending,
+ * independent of the overhead of the k_timer or k_sleep() APIs built
+ * on top of them.  All measurements are made with interrupts locked,
+ * so the system timer never gets to announce ticks of its own.
+ */
+
+#define MAX_TIMEOUTS 10000
+#define SPREAD_TICKS 65536
+
+static const uint32_t queue_sizes[] = { 10, 1000, MAX_TIMEOUTS };
+
+static struct _timeout timeouts[MAX_TIMEOUTS];
+static uint32_t expired;
+
+#if defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
+#define BACKEND "TIMEOUT_QUEUE_WHEEL"
+#else
+#define BACKEND "TIMEOUT_QUEUE_DLIST"
+#endif
+
+static void expiry_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	expired++;
+}
+
+/* Pseudo-random, but reproducible, spread of expiry times */
+static k_timeout_t delay(uint32_t i)
+{
+	return K_TICKS((i * 7919U) % SPREAD_TICKS);
+}
+
+static void report(const char *op, uint32_t n, uint64_t total, uint64_t max)
+{
+	uint32_t avg = total / n;
+
+	printk("%-6s %5u timeouts: avg %8u cycles (%8u ns)", op, n, avg,
+	       (uint32_t)timing_cycles_to_ns(avg));
+	if (max != 0U) {
+		printk(", max %8u cycles (%8u ns)", (uint32_t)max,
+		       (uint32_t)timing_cycles_to_ns(max));
+	}
+	printk("\n");
+}
+
+static void fill(uint32_t n, bool measure)
+{
+	timing_t start, end;
+	uint64_t cycles, total = 0U, max = 0U;
+
+	for (uint32_t i = 0; i < n; i++) {
+		start = timing_counter_get();
+		z_add_timeout(&timeouts[i], expiry_fn, delay(i));
+		end = timing_counter_get();
+
+		cycles = timing_cycles_get(&start, &end);
+		total += cycles;
+		max = MAX(max, cycles);
+	}
+
+	if (measure) {
+		report("insert", n, total, max);
+	}
+}
+
+static void bench_abort(uint32_t n)
+{
+	timing_t start, end;
+	uint64_t cycles, total = 0U, max = 0U;
+
+	/* Walk the timeouts with a stride coprime to every queue size,
+	 * so that they are not aborted in the order they were added.
+	 */
+	for (uint32_t i = 0, j = 0; i < n; i++, j = (j + 7U) % n) {
+		start = timing_counter_get();
+		z_abort_timeout(&timeouts[j]);
+		end = timing_counter_get();
+
+		cycles = timing_cycles_get(&start, &end);
+		total += cycles;
+		max = MAX(max, cycles);
+	}
+
+	report("abort", n, total, max);
+}
+
+static void bench_expire(uint32_t n)
+{
+	timing_t start, end;
+
+	expired = 0U;
+
+	start = timing_counter_get();
+	sys_clock_announce(2 * SPREAD_TICKS);
+	end = timing_counter_get();
+
+	if (expired != n) {
+		printk("Error: %u of %u timeouts expired\n", expired, n);
+	}
+
+	report("expire", n, timing_cycles_get(&start, &end), 0U);
+}
+
+int main(void)
+{
+	unsigned int key;
+
+	timing_init();
+	timing_start();
+
+	printk("Timeout queue benchmark (%s)\n", BACKEND);
+
+	for (int i = 0; i < ARRAY_SIZE(queue_sizes); i++) {
+		uint32_t n = queue_sizes[i];
+
+		key = irq_lock();
+
+		fill(n, true);
+		bench_abort(n);
+
+		fill(n, false);
+		bench_expire(n);
+
+		irq_unlock(key);
+	}
+
+	timing_stop();
+
+	printk("PROJECT EXECUTION SUCCESSFUL\n");
+	return 0;
+}
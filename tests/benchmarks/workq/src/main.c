@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* This is a work queue throughput benchmark.  A batch of work items is
+ * submitted at once, most of them short and CPU bound, and one in eight
+ * waiting for a while as a handler waiting on a bus or a socket would.
+ * The batch is run by a work queue with a single thread, then by the
+ * same work queue with more threads added by k_work_queue_worker_add(),
+ * where the short items no longer wait behind the long ones.
+ */
+
+#define NUM_WORKERS	3
+#define NUM_ITEMS	64
+#define NUM_ROUNDS	4
+#define SLOW_EVERY	8
+#define SLOW_MS		5
+#define FAST_US		50
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct bench_item {
+	struct k_work work;
+	timing_t submitted;
+	timing_t done;
+	bool slow;
+};
+
+static K_THREAD_STACK_DEFINE(queue_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_work_q queue;
+static struct k_work_q_worker workers[NUM_WORKERS];
+
+static struct bench_item items[NUM_ITEMS];
+static K_SEM_DEFINE(done_sem, 0, NUM_ITEMS);
+
+static void item_handler(struct k_work *work)
+{
+	struct bench_item *item = CONTAINER_OF(work, struct bench_item, work);
+
+	if (item->slow) {
+		k_msleep(SLOW_MS);
+	} else {
+		k_busy_wait(FAST_US);
+	}
+
+	item->done = timing_counter_get();
+	k_sem_give(&done_sem);
+}
+
+static void run(int num_threads)
+{
+	timing_t start, end;
+	uint64_t ns = 0;
+	uint64_t fast_ns = 0;
+	uint64_t fast_max_ns = 0;
+	uint32_t fast_items = 0;
+
+	for (int round = 0; round < NUM_ROUNDS; round++) {
+		start = timing_counter_get();
+
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			items[i].submitted = timing_counter_get();
+			(void)k_work_submit_to_queue(&queue, &items[i].work);
+		}
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			k_sem_take(&done_sem, K_FOREVER);
+		}
+
+		end = timing_counter_get();
+		ns += timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			uint64_t latency;
+
+			if (items[i].slow) {
+				continue;
+			}
+
+			latency = timing_cycles_to_ns(
+				timing_cycles_get(&items[i].submitted,
+						  &items[i].done));
+			fast_ns += latency;
+			fast_max_ns = MAX(fast_max_ns, latency);
+			fast_items++;
+		}
+	}
+
+	/* Latency is from submission to the end of the handler */
+	printk("%d threads: %u items/s, short item latency %u us (max %u us)\n",
+	       num_threads,
+	       (uint32_t)(ns ? (uint64_t)NUM_ROUNDS * NUM_ITEMS * NSEC_PER_SEC / ns : 0),
+	       (uint32_t)(fast_ns / fast_items / NSEC_PER_USEC),
+	       (uint32_t)(fast_max_ns / NSEC_PER_USEC));
+}
+
+int main(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "bench_workq",
+	};
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	timing_init();
+	timing_start();
+
+	printk("Work queue benchmark (%u CPUs)\n", arch_num_cpus());
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i].work, item_handler);
+		items[i].slow = (i % SLOW_EVERY) == 0;
+	}
+
+	k_work_queue_start(&queue, queue_stack, K_THREAD_STACK_SIZEOF(queue_stack),
+			   prio, &cfg);
+	run(1);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		(void)k_work_queue_worker_add(&queue, &workers[i],
+					      worker_stacks[i],
+					      K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+					      -1, &cfg);
+	}
+	run(NUM_WORKERS + 1);
+
+	timing_stop();
+
+	printk("PROJECT EXECUTION SUCCESSFUL\n");
+	return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define NUM_WAITERS    8
+#define DELAY          K_MSEC(50)
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_thread waiters[NUM_WAITERS];
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, NUM_WAITERS, STACK_SIZE);
+
+static K_EVENT_DEFINE(waiters_event);
+
+/* Events received by each waiter, 0 until it is woken */
+static uint32_t waiter_events[NUM_WAITERS];
+static atomic_t woken;
+
+/* Even waiters wait for all of 0x3, odd waiters for any of 0xc */
+static void entry_waiter(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	if ((id % 2) == 0) {
+		waiter_events[id] = k_event_wait_all(&waiters_event, 0x3,
+						     false, K_FOREVER);
+	} else {
+		waiter_events[id] = k_event_wait(&waiters_event, 0xc, false,
+						 K_FOREVER);
+	}
+
+	atomic_inc(&woken);
+}
+
+static void check_woken(int parity, uint32_t events)
+{
+	for (int i = parity; i < NUM_WAITERS; i += 2) {
+		zassert_equal(waiter_events[i], events,
+			      "waiter %d received 0x%x", i, waiter_events[i]);
+	}
+}
+
+/**
+ * Test that posting events wakes all the matching waiters, and only them,
+ * whatever the number of threads woken at once (see
+ * CONFIG_EVENTS_WAKE_BATCH).
+ */
+ZTEST(events_api, test_event_many_waiters)
+{
+	k_event_init(&waiters_event);
+	atomic_clear(&woken);
+	memset(waiter_events, 0, sizeof(waiter_events));
+
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		k_thread_create(&waiters[i], waiter_stacks[i], STACK_SIZE,
+				entry_waiter, INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(i % 4), 0, K_NO_WAIT);
+	}
+	k_sleep(DELAY);
+
+	/* Matches neither condition */
+	k_event_post(&waiters_event, 0x1);
+	k_sleep(DELAY);
+	zassert_equal(atomic_get(&woken), 0);
+
+	/* Completes the condition of the even waiters */
+	k_event_post(&waiters_event, 0x2);
+	k_sleep(DELAY);
+	zassert_equal(atomic_get(&woken), NUM_WAITERS / 2);
+	check_woken(0, 0x3);
+	check_woken(1, 0);
+
+	/* Wakes the others, which only see the events they wait for */
+	k_event_post(&waiters_event, 0x8);
+	k_sleep(DELAY);
+	zassert_equal(atomic_get(&woken), NUM_WAITERS);
+	check_woken(0, 0x3);
+	check_woken(1, 0x8);
+
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		zassert_ok(k_thread_join(&waiters[i], K_FOREVER));
+	}
+}
@@ -265,3 +265,54 @@ ZTEST(k_heap_api, test_k_heap_alloc_pending_null)
 
 	k_heap_free(&k_heap_test, p);
 }
+
+#ifdef CONFIG_HEAP_MEM_POOL_CACHE
+/**
+ * @brief Test the per-CPU cache in front of the heap memory pool
+ *
+ * @ingroup kernel_kheap_api_tests
+ *
+ * @details Free a small k_malloc() block and verify that the next
+ * allocation of the same size class gets it back, and that the cached
+ * bytes account for it meanwhile.  Then fill the heap with small blocks,
+ * free them all into the cache, and verify that a large allocation still
+ * succeeds, flushing the cache to do so.
+ */
+ZTEST(k_heap_api, test_k_malloc_cache)
+{
+	static void *blocks[CONFIG_HEAP_MEM_POOL_SIZE / 256];
+	size_t cached;
+	void *p, *q;
+	int n;
+
+	p = k_malloc(20);
+	zassert_not_null(p, "k_malloc operation failed");
+	cached = k_malloc_cache_size_get();
+	k_free(p);
+	zassert_true(k_malloc_cache_size_get() >= cached + 20, "cached bytes not accounted");
+
+	q = k_malloc(30);
+	zassert_equal_ptr(p, q, "block not reused from the cache");
+	zassert_equal(k_malloc_cache_size_get(), cached, "cached bytes not accounted");
+	k_free(q);
+
+	for (n = 0; n < ARRAY_SIZE(blocks); n++) {
+		blocks[n] = k_malloc(200);
+		if (blocks[n] == NULL) {
+			break;
+		}
+	}
+	zassert_true(n > 1, "too few blocks allocated");
+
+	for (int i = 0; i < n; i++) {
+		k_free(blocks[i]);
+	}
+
+	p = k_malloc(CONFIG_HEAP_MEM_POOL_SIZE / 2);
+	zassert_not_null(p, "cache not flushed under memory pressure");
+	k_free(p);
+
+	k_malloc_cache_flush();
+	zassert_equal(k_malloc_cache_size_get(), 0, "cache not flushed");
+}
+#endif /* CONFIG_HEAP_MEM_POOL_CACHE */
@@ -92,3 +92,50 @@ ZTEST(mslab_threadsafe, test_mslab_threadsafe)
 		zassert_true(success[i], "thread %d failed", i);
 	}
 }
+
+#if defined(CONFIG_MEM_SLAB_CPU_CACHE) && defined(CONFIG_SCHED_CPU_MASK)
+#define CACHE_BLOCKS CONFIG_MEM_SLAB_CPU_CACHE_DEPTH
+
+K_MEM_SLAB_DEFINE_STATIC(cache_slab, BLK_SIZE2, CACHE_BLOCKS, BLK_ALIGN);
+static K_THREAD_STACK_DEFINE(cache_stack, STACK_SIZE);
+static struct k_thread cache_thread;
+
+static void alloc_free_all(void *p1, void *p2, void *p3)
+{
+	void *block[CACHE_BLOCKS];
+
+	for (int i = 0; i < CACHE_BLOCKS; i++) {
+		zassert_ok(k_mem_slab_alloc(&cache_slab, &block[i], K_NO_WAIT),
+			   "block %d is not allocated", i);
+	}
+	for (int i = 0; i < CACHE_BLOCKS; i++) {
+		k_mem_slab_free(&cache_slab, block[i]);
+	}
+}
+
+static void run_on_cpu(int cpu)
+{
+	k_thread_create(&cache_thread, cache_stack, STACK_SIZE,
+			alloc_free_all, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_FOREVER);
+	zassert_ok(k_thread_cpu_pin(&cache_thread, cpu));
+	k_thread_start(&cache_thread);
+	zassert_ok(k_thread_join(&cache_thread, K_FOREVER));
+}
+
+/**
+ * @brief Verify blocks cached by a CPU can be allocated on another
+ *
+ * @details Test frees all the blocks of a memory slab on CPU 1, most of
+ * them into its cache, then allocates all of them on CPU 0.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_threadsafe, test_mslab_cpu_cache_reclaim)
+{
+	run_on_cpu(1);
+	zassert_equal(k_mem_slab_num_free_get(&cache_slab), CACHE_BLOCKS);
+	run_on_cpu(0);
+	zassert_equal(k_mem_slab_num_free_get(&cache_slab), CACHE_BLOCKS);
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE && CONFIG_SCHED_CPU_MASK */
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+/* Odd length, so that batches wrap around the ring buffer at various
+ * offsets
+ */
+#define BATCH_MSGQ_LEN 5
+#define BATCH_LEN 8
+#define MSG_WRITER 0x5555
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) tbuffer[MSG_SIZE * BATCH_MSGQ_LEN];
+static ZTEST_DMEM uint32_t tx[BATCH_LEN];
+static ZTEST_DMEM uint32_t rx[BATCH_LEN];
+static ZTEST_DMEM uint32_t rx_thread;
+static ZTEST_DMEM uint32_t tx_thread = MSG_WRITER;
+
+static void batch_put_get(struct k_msgq *q)
+{
+	uint32_t seq = 0U, expect = 0U;
+	int ret;
+
+	zassert_equal(k_msgq_put_many(q, tx, 0, K_NO_WAIT), -EINVAL);
+	zassert_equal(k_msgq_get_many(q, rx, 0, K_NO_WAIT), -EINVAL);
+
+	/* Move the read/write pointers all around the ring buffer with
+	 * batches of every size
+	 */
+	for (uint32_t round = 0U; round < 2U * BATCH_MSGQ_LEN; round++) {
+		uint32_t n = (round % BATCH_MSGQ_LEN) + 1U;
+
+		for (uint32_t i = 0U; i < BATCH_LEN; i++) {
+			tx[i] = seq + i;
+		}
+
+		/**TESTPOINT: put only as many messages as there is room for */
+		ret = k_msgq_put_many(q, tx, BATCH_LEN, K_NO_WAIT);
+		zassert_equal(ret, BATCH_MSGQ_LEN, "put %d", ret);
+		seq += ret;
+		zassert_equal(k_msgq_num_free_get(q), 0);
+		zassert_equal(k_msgq_put_many(q, tx, 1, K_NO_WAIT), -ENOMSG);
+
+		/**TESTPOINT: get messages in order, in batches */
+		ret = k_msgq_get_many(q, rx, n, K_NO_WAIT);
+		zassert_equal(ret, n, "got %d", ret);
+		for (uint32_t i = 0U; i < n; i++) {
+			zassert_equal(rx[i], expect++);
+		}
+
+		/**TESTPOINT: get only the messages left */
+		if (n < BATCH_MSGQ_LEN) {
+			ret = k_msgq_get_many(q, rx, BATCH_LEN, K_NO_WAIT);
+			zassert_equal(ret, BATCH_MSGQ_LEN - n, "got %d", ret);
+			for (uint32_t i = 0U; i < (uint32_t)ret; i++) {
+				zassert_equal(rx[i], expect++);
+			}
+		}
+		zassert_equal(k_msgq_num_used_get(q), 0);
+		zassert_equal(k_msgq_get_many(q, rx, 1, K_NO_WAIT), -ENOMSG);
+
+		/* Leave the pointers in a new position for the next round */
+		zassert_equal(k_msgq_put_many(q, tx, n, K_NO_WAIT), n);
+		zassert_equal(k_msgq_get_many(q, rx, n, K_NO_WAIT), n);
+		seq = expect = seq + n;
+	}
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test putting and getting batches of messages
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api, test_msgq_batch)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_MSGQ_LEN);
+
+	batch_put_get(&msgq);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test putting and getting batches of messages from user mode
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST_USER(msgq_api, test_msgq_user_batch)
+{
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, BATCH_MSGQ_LEN));
+
+	batch_put_get(q);
+}
+#endif
+
+static void batch_reader_entry(void *p1, void *p2, void *p3)
+{
+	int ret = k_msgq_get_many((struct k_msgq *)p1, &rx_thread, 1, K_FOREVER);
+
+	zassert_equal(ret, 1);
+}
+
+static void batch_writer_entry(void *p1, void *p2, void *p3)
+{
+	int ret = k_msgq_put_many((struct k_msgq *)p1, &tx_thread, 1, K_FOREVER);
+
+	zassert_equal(ret, 1);
+}
+
+/**
+ * @brief Test that batches are exchanged with waiting threads
+ *
+ * @details A batch put on an empty queue goes to the waiting reader
+ * first, and a batch get on a full queue lets the waiting writer add
+ * its message behind the remaining ones.
+ *
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_batch_pending)
+{
+	int ret;
+
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_MSGQ_LEN);
+
+	for (uint32_t i = 0U; i < BATCH_LEN; i++) {
+		tx[i] = i;
+	}
+
+	/**TESTPOINT: the waiting reader gets the first message */
+	k_thread_create(&tdata, tstack, STACK_SIZE,
+			batch_reader_entry, &msgq, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	ret = k_msgq_put_many(&msgq, tx, 3, K_NO_WAIT);
+	zassert_equal(ret, 3);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(rx_thread, 0);
+	zassert_equal(k_msgq_num_used_get(&msgq), 2);
+
+	/**TESTPOINT: the waiting writer refills the queue */
+	zassert_equal(k_msgq_put_many(&msgq, &tx[3], BATCH_LEN, K_NO_WAIT),
+		      BATCH_MSGQ_LEN - 2);
+	k_thread_create(&tdata, tstack, STACK_SIZE,
+			batch_writer_entry, &msgq, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	ret = k_msgq_get_many(&msgq, rx, 2, K_NO_WAIT);
+	zassert_equal(ret, 2);
+	zassert_equal(rx[0], 1);
+	zassert_equal(rx[1], 2);
+	k_thread_join(&tdata, K_FOREVER);
+
+	ret = k_msgq_get_many(&msgq, rx, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, BATCH_MSGQ_LEN - 1);
+	zassert_equal(rx[ret - 1], MSG_WRITER);
+
+	/**TESTPOINT: time out waiting for a message */
+	zassert_equal(k_msgq_get_many(&msgq, rx, BATCH_LEN, TIMEOUT), -EAGAIN);
+}
+
+/**
+ * @}
+ */
@@ -67,6 +67,9 @@ static SYS_MUTEX_DEFINE(no_access_mutex);
 #endif
 static ZTEST_BMEM SYS_MUTEX_DEFINE(not_my_mutex);
 static ZTEST_BMEM SYS_MUTEX_DEFINE(bad_count_mutex);
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+static ZTEST_BMEM SYS_MUTEX_DEFINE(corrupt_mutex);
+#endif
 
 #ifdef CONFIG_USERSPACE
 #define ZTEST_USER_OR_NOT ZTEST_USER
@@ -470,15 +473,63 @@ ZTEST_USER_OR_NOT(mutex_complex, test_user_access)
 #ifdef CONFIG_USERSPACE
 	int rv;
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	/* The fast path accesses the mutex before the kernel can check it,
+	 * which faults rather than fails: go to the kernel directly
+	 */
+	rv = z_sys_mutex_kernel_lock(&no_access_mutex, K_NO_WAIT);
+	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
+	rv = z_sys_mutex_kernel_unlock(&no_access_mutex);
+	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
+#else
 	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
 	rv = sys_mutex_unlock(&no_access_mutex);
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 #else
 	ztest_test_skip();
 #endif /* CONFIG_USERSPACE */
 }
 
+/* The owner word of a sys_mutex is in user memory: the kernel must reject
+ * an owner word which does not match the kernel mutex, rather than act on it.
+ */
+ZTEST_USER_OR_NOT(mutex_complex, test_user_corrupt_word)
+{
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	int rv;
+
+	/* Flagged as taken over by the kernel, with no owner */
+	atomic_set(&corrupt_mutex.val, BIT(0));
+	rv = sys_mutex_lock(&corrupt_mutex, K_MSEC(10));
+	zassert_equal(rv, -EINVAL, "accepted a flagged word with no owner");
+	rv = sys_mutex_unlock(&corrupt_mutex);
+	zassert_equal(rv, -EINVAL, "accepted a flagged word with no owner");
+
+	/* Flagged as taken over by the kernel for this thread, which it is not */
+	atomic_set(&corrupt_mutex.val, (atomic_val_t)k_current_get() | BIT(0));
+	rv = sys_mutex_lock(&corrupt_mutex, K_MSEC(10));
+	zassert_equal(rv, -EINVAL, "accepted a word flagged for a free mutex");
+	rv = sys_mutex_unlock(&corrupt_mutex);
+	zassert_equal(rv, -EINVAL, "accepted a word flagged for a free mutex");
+
+	/* Owned by something which is not a thread */
+	atomic_set(&corrupt_mutex.val, (atomic_val_t)&corrupt_mutex);
+	rv = sys_mutex_lock(&corrupt_mutex, K_MSEC(10));
+	zassert_equal(rv, -EINVAL, "accepted an owner which is not a thread");
+
+	/* Still usable once restored */
+	atomic_set(&corrupt_mutex.val, 0);
+	rv = sys_mutex_lock(&corrupt_mutex, K_NO_WAIT);
+	zassert_equal(rv, 0, "failed to lock a restored mutex");
+	rv = sys_mutex_unlock(&corrupt_mutex);
+	zassert_equal(rv, 0, "failed to unlock a restored mutex");
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+}
+
 /*test case main entry*/
 static void *sys_mutex_tests_setup(void)
 {
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define CLAIM_PIPE_LEN	16
+#define CLAIM_XFER_LEN	200
+#define TIMEOUT_MS	100
+
+K_PIPE_DEFINE(claim_pipe, CLAIM_PIPE_LEN, 4);
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+
+static unsigned char tx[CLAIM_PIPE_LEN];
+static unsigned char rx[CLAIM_PIPE_LEN];
+
+/* Fills the pipe buffer through a put claim of exactly @a len bytes */
+static void claim_put(struct k_pipe *p, const unsigned char *src, size_t len)
+{
+	uint8_t *area;
+	size_t claimed;
+
+	zassert_ok(k_pipe_put_claim(p, &area, len, &claimed, K_NO_WAIT));
+	zassert_equal(claimed, len, "claimed %zu", claimed);
+	memcpy(area, src, len);
+	zassert_ok(k_pipe_put_finish(p, len));
+}
+
+/**
+ * @addtogroup kernel_pipe_tests
+ * @{
+ */
+
+/**
+ * @brief Test writing and reading a pipe through claimed areas
+ * @see k_pipe_put_claim(), k_pipe_put_finish(),
+ *      k_pipe_get_claim(), k_pipe_get_finish()
+ */
+ZTEST(pipe_api, test_pipe_claim)
+{
+	struct k_pipe bufferless;
+	uint8_t *area;
+	size_t claimed;
+	size_t bytes;
+
+	for (int i = 0; i < CLAIM_PIPE_LEN; i++) {
+		tx[i] = i;
+	}
+
+	k_pipe_init(&bufferless, NULL, 0);
+	zassert_equal(k_pipe_put_claim(&bufferless, &area, 1, &claimed,
+				       K_NO_WAIT), -EINVAL);
+	zassert_equal(k_pipe_get_claim(&bufferless, &area, 1, &claimed,
+				       K_NO_WAIT), -EINVAL);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &area, 0, &claimed,
+				       K_NO_WAIT), -EINVAL);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 0), -EINVAL);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 0), -EINVAL);
+
+	/**TESTPOINT: nothing to read from an empty pipe */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &area, 1, &claimed,
+				       K_NO_WAIT), -EIO);
+
+	/**TESTPOINT: only one put claim at a time, finished in part */
+	zassert_ok(k_pipe_put_claim(&claim_pipe, &area, 10, &claimed,
+				    K_NO_WAIT));
+	zassert_equal(claimed, 10);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &area, 1, &claimed,
+				       K_NO_WAIT), -EBUSY);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+	memcpy(area, tx, 6);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 11), -EINVAL);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, 6));
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 6);
+
+	/**TESTPOINT: fill up the pipe */
+	claim_put(&claim_pipe, &tx[6], CLAIM_PIPE_LEN - 6);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &area, 1, &claimed,
+				       K_NO_WAIT), -EIO);
+
+	/**TESTPOINT: read in place, in part */
+	zassert_ok(k_pipe_get_claim(&claim_pipe, &area, 4, &claimed,
+				    K_NO_WAIT));
+	zassert_equal(claimed, 4);
+	zassert_mem_equal(area, tx, 4);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &area, 1, &claimed,
+				       K_NO_WAIT), -EBUSY);
+
+	/**TESTPOINT: claimed data can not be read with k_pipe_get() */
+	zassert_equal(k_pipe_get(&claim_pipe, rx, 1, &bytes, 1, K_NO_WAIT),
+		      -EIO);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 3));
+
+	/**TESTPOINT: the free space wraps around, claims do not */
+	zassert_ok(k_pipe_put_claim(&claim_pipe, &area, CLAIM_PIPE_LEN,
+				    &claimed, K_NO_WAIT));
+	zassert_equal(claimed, 3);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, 0));
+
+	/**TESTPOINT: data is read in order, whatever the API */
+	zassert_ok(k_pipe_get(&claim_pipe, rx, CLAIM_PIPE_LEN, &bytes, 1,
+			      K_NO_WAIT));
+	zassert_equal(bytes, CLAIM_PIPE_LEN - 3);
+	zassert_mem_equal(rx, &tx[3], bytes);
+
+	/**TESTPOINT: an empty pipe can be claimed in full */
+	zassert_ok(k_pipe_put_claim(&claim_pipe, &area, CLAIM_PIPE_LEN,
+				    &claimed, K_NO_WAIT));
+	zassert_equal(claimed, CLAIM_PIPE_LEN);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, 0));
+}
+
+static void claim_reader_entry(void *p1, void *p2, void *p3)
+{
+	size_t bytes;
+
+	zassert_ok(k_pipe_get(p1, rx, 8, &bytes, 8, K_FOREVER));
+	zassert_equal(bytes, 8);
+}
+
+static void claim_writer_entry(void *p1, void *p2, void *p3)
+{
+	static const unsigned char writer_data[4] = { 0xa, 0xb, 0xc, 0xd };
+	size_t bytes;
+
+	zassert_ok(k_pipe_put(p1, writer_data, sizeof(writer_data), &bytes,
+			      sizeof(writer_data), K_FOREVER));
+	zassert_equal(bytes, sizeof(writer_data));
+}
+
+/**
+ * @brief Test that releasing a claim serves waiting readers and writers
+ * @see k_pipe_put_finish(), k_pipe_get_finish()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_waiters)
+{
+	uint8_t *area;
+	size_t claimed;
+	size_t bytes;
+
+	k_pipe_flush(&claim_pipe);
+
+	/**TESTPOINT: a waiting reader gets the data written in place */
+	k_thread_create(&tdata, tstack, STACK_SIZE, claim_reader_entry,
+			&claim_pipe, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+	k_msleep(TIMEOUT_MS);
+
+	memset(rx, 0, sizeof(rx));
+	claim_put(&claim_pipe, tx, 8);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_mem_equal(rx, tx, 8);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+
+	/**TESTPOINT: a waiting writer refills the space read in place */
+	claim_put(&claim_pipe, tx, CLAIM_PIPE_LEN);
+	k_thread_create(&tdata, tstack, STACK_SIZE, claim_writer_entry,
+			&claim_pipe, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+	k_msleep(TIMEOUT_MS);
+
+	zassert_ok(k_pipe_get_claim(&claim_pipe, &area, CLAIM_PIPE_LEN,
+				    &claimed, K_NO_WAIT));
+	zassert_equal(claimed, CLAIM_PIPE_LEN);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 4));
+	k_thread_join(&tdata, K_FOREVER);
+
+	zassert_ok(k_pipe_get(&claim_pipe, rx, CLAIM_PIPE_LEN, &bytes,
+			      CLAIM_PIPE_LEN, K_NO_WAIT));
+	zassert_mem_equal(rx, &tx[4], CLAIM_PIPE_LEN - 4);
+	zassert_equal(rx[CLAIM_PIPE_LEN - 1], 0xd);
+
+	/**TESTPOINT: time out waiting for data */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &area, 1, &claimed,
+				       K_MSEC(TIMEOUT_MS)), -EAGAIN);
+}
+
+static void claim_producer_entry(void *p1, void *p2, void *p3)
+{
+	uint8_t *area;
+	size_t claimed;
+	size_t i = 0;
+
+	while (i < CLAIM_XFER_LEN) {
+		zassert_ok(k_pipe_put_claim(p1, &area, CLAIM_XFER_LEN - i,
+					    &claimed, K_FOREVER));
+		for (size_t j = 0; j < claimed; j++) {
+			area[j] = (uint8_t)(i + j);
+		}
+		zassert_ok(k_pipe_put_finish(p1, claimed));
+		i += claimed;
+	}
+}
+
+/**
+ * @brief Test a zero-copy stream between two threads
+ *
+ * @details Both threads wait on each other in turn for data or space, as
+ * the stream is much larger than the pipe.
+ *
+ * @see k_pipe_put_claim(), k_pipe_get_claim()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_stream)
+{
+	uint8_t *area;
+	size_t claimed;
+	size_t i = 0;
+
+	k_pipe_flush(&claim_pipe);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, claim_producer_entry,
+			&claim_pipe, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+			K_NO_WAIT);
+
+	while (i < CLAIM_XFER_LEN) {
+		/* Read a few bytes at a time to vary the claims' positions */
+		zassert_ok(k_pipe_get_claim(&claim_pipe, &area, 5, &claimed,
+					    K_FOREVER));
+		for (size_t j = 0; j < claimed; j++) {
+			zassert_equal(area[j], (uint8_t)(i + j));
+		}
+		zassert_ok(k_pipe_get_finish(&claim_pipe, claimed));
+		i += claimed;
+	}
+
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define WAIT_MS 50
+
+static struct k_poll_set set;
+static K_SEM_DEFINE(set_sem, 0, 1);
+static K_FIFO_DEFINE(set_fifo);
+static struct k_poll_signal set_signal;
+
+static struct k_poll_event set_events[] = {
+	K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SEM_AVAILABLE,
+				 K_POLL_MODE_NOTIFY_ONLY, &set_sem),
+	K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+				 K_POLL_MODE_NOTIFY_ONLY, &set_fifo),
+	K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL,
+				 K_POLL_MODE_NOTIFY_ONLY, &set_signal),
+};
+
+static struct fifo_msg {
+	void *private;
+} set_msg;
+
+static void set_setup(void)
+{
+	k_sem_reset(&set_sem);
+	while (k_fifo_get(&set_fifo, K_NO_WAIT) != NULL) {
+	}
+	k_poll_signal_init(&set_signal);
+
+	k_poll_set_init(&set);
+	for (int i = 0; i < ARRAY_SIZE(set_events); i++) {
+		zassert_ok(k_poll_set_add(&set, &set_events[i]));
+	}
+}
+
+static void set_teardown(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(set_events); i++) {
+		zassert_ok(k_poll_set_remove(&set, &set_events[i]));
+	}
+}
+
+/**
+ * @brief Test that a poll set returns the events ready, and only them
+ *
+ * @see k_poll_set_add(), k_poll_set_wait(), k_poll_set_remove()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_ready)
+{
+	struct k_poll_event *ready[ARRAY_SIZE(set_events)];
+
+	set_setup();
+
+	zassert_equal(k_poll_set_add(&set, &set_events[0]), -EBUSY);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN);
+
+	/**TESTPOINT: an event signaled is returned */
+	k_sem_give(&set_sem);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[0]);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE);
+
+	/**TESTPOINT: and returned again as long as it is ready */
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[0]);
+
+	zassert_ok(k_sem_take(&set_sem, K_NO_WAIT));
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN);
+
+	/**TESTPOINT: the events are returned in the order signaled */
+	k_poll_signal_raise(&set_signal, 0);
+	k_fifo_put(&set_fifo, &set_msg);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 2);
+	zassert_equal_ptr(ready[0], &set_events[2]);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SIGNALED);
+	zassert_equal_ptr(ready[1], &set_events[1]);
+	zassert_equal(ready[1]->state, K_POLL_STATE_FIFO_DATA_AVAILABLE);
+
+	/**TESTPOINT: the events not returned are left for the next call */
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[2]);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[1]);
+
+	/**TESTPOINT: an event removed is no longer returned */
+	zassert_ok(k_poll_set_remove(&set, &set_events[2]));
+	zassert_equal(k_poll_set_remove(&set, &set_events[2]), -EINVAL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[1]);
+	zassert_ok(k_poll_set_add(&set, &set_events[2]));
+
+	/**TESTPOINT: an event ready when added is returned */
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 2);
+
+	zassert_not_null(k_fifo_get(&set_fifo, K_NO_WAIT));
+	k_poll_signal_reset(&set_signal);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN);
+
+	set_teardown();
+}
+
+static void set_give(struct k_timer *timer)
+{
+	k_sem_give(&set_sem);
+}
+
+static void set_cancel(struct k_timer *timer)
+{
+	k_fifo_cancel_wait(&set_fifo);
+}
+
+/**
+ * @brief Test waiting on a poll set
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	struct k_poll_event *ready[ARRAY_SIZE(set_events)];
+	static struct k_timer timer;
+
+	set_setup();
+
+	/**TESTPOINT: time out */
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_MSEC(WAIT_MS)), -EAGAIN);
+
+	/**TESTPOINT: wake up on an event signaled from an ISR */
+	k_timer_init(&timer, set_give, NULL);
+	k_timer_start(&timer, K_MSEC(WAIT_MS), K_NO_WAIT);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_FOREVER), 1);
+	zassert_equal_ptr(ready[0], &set_events[0]);
+	zassert_ok(k_sem_take(&set_sem, K_NO_WAIT));
+
+	/**TESTPOINT: wait without taking the events */
+	k_timer_start(&timer, K_MSEC(WAIT_MS), K_NO_WAIT);
+	zassert_equal(k_poll_set_wait(&set, NULL, 0, K_FOREVER), 0);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_ok(k_sem_take(&set_sem, K_NO_WAIT));
+
+	/**TESTPOINT: a cancelled wait is returned once */
+	k_timer_init(&timer, set_cancel, NULL);
+	k_timer_start(&timer, K_MSEC(WAIT_MS), K_NO_WAIT);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_FOREVER), 1);
+	zassert_equal_ptr(ready[0], &set_events[1]);
+	zassert_equal(ready[0]->state, K_POLL_STATE_CANCELLED);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN);
+
+	set_teardown();
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKERS_PRIORITY K_PRIO_PREEMPT(1)
+#define NUM_WORKERS 2
+/* The queue thread and the workers */
+#define NUM_THREADS (NUM_WORKERS + 1)
+#define RELEASE_MS 50
+
+static K_THREAD_STACK_DEFINE(workers_queue_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_work_q workers_queue;
+static struct k_work_q_worker workers[NUM_WORKERS];
+static struct k_work_q unstarted_queue;
+static struct k_work_q_worker unused_worker;
+
+static struct k_work works[NUM_THREADS];
+
+/* Work synchronization objects must be in cache-coherent memory,
+ * which excludes stacks on some architectures.
+ */
+static struct k_work_sync workers_sync;
+
+/* Given to release blocking handlers. */
+static K_SEM_DEFINE(release_sem, 0, NUM_THREADS);
+
+/* Number of handlers running, and number of handlers done. */
+static atomic_t running;
+static atomic_t done;
+
+static void block_handler(struct k_work *work)
+{
+	atomic_inc(&running);
+	(void)k_sem_take(&release_sem, K_FOREVER);
+	atomic_dec(&running);
+	atomic_inc(&done);
+}
+
+static void release_cb(struct k_timer *timer)
+{
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_sem_give(&release_sem);
+	}
+}
+
+static K_TIMER_DEFINE(releaser, release_cb, NULL);
+
+static void reset_works(void)
+{
+	atomic_set(&running, 0);
+	atomic_set(&done, 0);
+	k_sem_reset(&release_sem);
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_work_init(&works[i], block_handler);
+	}
+}
+
+/* Check that adding threads to a queue is validated. */
+ZTEST(work_workers, test_workers_add)
+{
+	int rc;
+
+	rc = k_work_queue_worker_add(&unstarted_queue, &unused_worker,
+				     worker_stacks[0], STACK_SIZE, -1, NULL);
+	zassert_equal(rc, -ENODEV);
+
+	rc = k_work_queue_worker_add(&workers_queue, &unused_worker,
+				     worker_stacks[0], STACK_SIZE,
+				     arch_num_cpus(), NULL);
+	zassert_equal(rc, -EINVAL);
+}
+
+/* Check that items submitted to the queue run concurrently. */
+ZTEST(work_workers, test_workers_concurrent)
+{
+	reset_works();
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		zassert_equal(k_work_submit_to_queue(&workers_queue, &works[i]),
+			      1);
+	}
+
+	/* Each thread is blocked in a handler */
+	k_sleep(K_MSEC(RELEASE_MS));
+	zassert_equal(atomic_get(&running), NUM_THREADS);
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_sem_give(&release_sem);
+	}
+	k_sleep(K_MSEC(RELEASE_MS));
+	zassert_equal(atomic_get(&done), NUM_THREADS);
+	zassert_equal(atomic_get(&running), 0);
+}
+
+/* Check that an item resubmitted while running does not run concurrently
+ * with itself, although threads are idle.
+ */
+ZTEST(work_workers, test_workers_not_reentrant)
+{
+	reset_works();
+
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &works[0]), 1);
+	k_sleep(K_MSEC(RELEASE_MS));
+	zassert_equal(atomic_get(&running), 1);
+
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &works[0]), 2);
+	zassert_equal(k_work_busy_get(&works[0]),
+		      K_WORK_RUNNING | K_WORK_QUEUED);
+
+	/* Other items are not held up by the one waiting */
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &works[1]), 1);
+	k_sleep(K_MSEC(RELEASE_MS));
+	zassert_equal(atomic_get(&running), 2);
+	zassert_equal(k_work_busy_get(&works[0]),
+		      K_WORK_RUNNING | K_WORK_QUEUED);
+
+	/* Release one handler at a time */
+	for (int i = 0; i < 3; i++) {
+		k_sem_give(&release_sem);
+		k_sleep(K_MSEC(RELEASE_MS));
+		zassert_equal(atomic_get(&done), i + 1);
+	}
+	zassert_equal(atomic_get(&running), 0);
+	zassert_equal(k_work_busy_get(&works[0]), 0);
+}
+
+/* Check that flushing a running item waits for its handler to return,
+ * although threads are idle.
+ */
+ZTEST(work_workers, test_workers_running_flush)
+{
+	reset_works();
+
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &works[0]), 1);
+	k_sleep(K_MSEC(RELEASE_MS));
+	zassert_equal(atomic_get(&running), 1);
+
+	k_timer_start(&releaser, K_MSEC(RELEASE_MS), K_NO_WAIT);
+	zassert_true(k_work_flush(&works[0], &workers_sync));
+	zassert_equal(atomic_get(&done), 1);
+	zassert_equal(k_work_busy_get(&works[0]), 0);
+}
+
+/* Check that draining the queue waits for all the threads. */
+ZTEST(work_workers, test_workers_drain)
+{
+	reset_works();
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		zassert_equal(k_work_submit_to_queue(&workers_queue, &works[i]),
+			      1);
+	}
+	k_sleep(K_MSEC(RELEASE_MS));
+	zassert_equal(atomic_get(&running), NUM_THREADS);
+
+	k_timer_start(&releaser, K_MSEC(RELEASE_MS), K_NO_WAIT);
+	zassert_equal(k_work_queue_drain(&workers_queue, false), 1);
+	zassert_equal(atomic_get(&done), NUM_THREADS);
+}
+
+/* Check that a running item can be cancelled. */
+ZTEST(work_workers, test_workers_running_cancel_sync)
+{
+	reset_works();
+
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &works[0]), 1);
+	k_sleep(K_MSEC(RELEASE_MS));
+	zassert_equal(k_work_submit_to_queue(&workers_queue, &works[0]), 2);
+
+	k_timer_start(&releaser, K_MSEC(RELEASE_MS), K_NO_WAIT);
+	zassert_true(k_work_cancel_sync(&works[0], &workers_sync));
+	zassert_equal(atomic_get(&done), 1);
+	zassert_equal(k_work_busy_get(&works[0]), 0);
+}
+
+static void *workers_setup(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "wq.workers",
+	};
+
+	k_work_queue_start(&workers_queue, workers_queue_stack, STACK_SIZE,
+			   WORKERS_PRIORITY, &cfg);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_ok(k_work_queue_worker_add(&workers_queue, &workers[i],
+						   worker_stacks[i], STACK_SIZE,
+						   -1, &cfg));
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(work_workers, NULL, workers_setup, NULL, NULL, NULL);
+
+#endif /* CONFIG_WORKQUEUE_WORKERS */
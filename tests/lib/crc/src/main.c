@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief CRC32 implementations against a bitwise reference
+ *
+ * The CRC32 IEEE and CRC32C computed with the configured tables and, with
+ * CONFIG_CRC_X86 or CONFIG_CRC_ARM64, the CRC instructions are checked for
+ * every length up to a few hundred bytes, at every alignment, so that the
+ * unaligned heads, the blocks and the tails of the instruction paths are all
+ * covered.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/crc.h>
+
+#define MAX_LEN 300
+
+static uint8_t data[MAX_LEN + 8];
+
+static uint32_t crc32_bitwise(uint32_t poly, uint32_t crc, const uint8_t *buf, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= buf[i];
+		for (int b = 0; b < 8; b++) {
+			crc = (crc >> 1) ^ ((crc & 1U) ? poly : 0U);
+		}
+	}
+
+	return crc;
+}
+
+static void *crc_setup(void)
+{
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 167U + (i >> 3));
+	}
+
+	return NULL;
+}
+
+ZTEST(crc, test_crc32_ieee)
+{
+	for (size_t offs = 0; offs < 8; offs++) {
+		for (size_t len = 0; len <= MAX_LEN; len++) {
+			uint32_t ref = ~crc32_bitwise(0xedb88320U, 0xffffffffU, &data[offs], len);
+
+			zassert_equal(crc32_ieee(&data[offs], len), ref, "offset %zu length %zu",
+				      offs, len);
+		}
+	}
+}
+
+ZTEST(crc, test_crc32_c)
+{
+	for (size_t offs = 0; offs < 8; offs++) {
+		for (size_t len = 0; len <= MAX_LEN; len++) {
+			uint32_t ref = ~crc32_bitwise(0x82f63b78U, 0xffffffffU, &data[offs], len);
+
+			zassert_equal(crc32_c(0, &data[offs], len, true, true), ref,
+				      "offset %zu length %zu", offs, len);
+		}
+	}
+
+	/* In two steps, the CRC not being inverted in between */
+	zassert_equal(crc32_c(crc32_c(0, data, 100, true, false), &data[100], MAX_LEN - 100,
+			      false, true),
+		      ~crc32_bitwise(0x82f63b78U, 0xffffffffU, data, MAX_LEN));
+}
+
+ZTEST_SUITE(crc, NULL, crc_setup, NULL, NULL, NULL);
@@ -19,6 +19,12 @@ static struct fd_op_vtable fd_vtable = { 0 };
 
 #define VTABLE_INIT (&fd_vtable)
 
+#ifdef CONFIG_ZVFS_OPEN_DYNAMIC
+#define FD_MAX CONFIG_ZVFS_OPEN_DYNAMIC_MAX
+#else
+#define FD_MAX CONFIG_ZVFS_OPEN_MAX
+#endif
+
 K_THREAD_STACK_DEFINE(fd_thread_stack, CONFIG_ZTEST_STACK_SIZE +
 		      CONFIG_TEST_EXTRA_STACK_SIZE);
 
@@ -133,6 +139,45 @@ ZTEST(fdtable, test_zvfs_free_fd)
 	zassert_equal_ptr(obj, NULL, "obj is not NULL after freeing");
 }
 
+ZTEST(fdtable, test_zvfs_reserve_fd_lowest)
+{
+	int fd1 = zvfs_reserve_fd();
+	int fd2 = zvfs_reserve_fd();
+
+	zassert_true(fd1 >= 0 && fd2 > fd1);
+
+	/* The lowest free descriptor is reserved first */
+	zvfs_free_fd(fd1);
+	zassert_equal(zvfs_reserve_fd(), fd1);
+
+	zvfs_free_fd(fd1);
+	zvfs_free_fd(fd2);
+}
+
+ZTEST(fdtable, test_zvfs_reserve_fd_all)
+{
+	static int fds[FD_MAX];
+	const struct fd_op_vtable *vtable;
+	int n = 0;
+
+	for (int fd = zvfs_reserve_fd(); fd >= 0; fd = zvfs_reserve_fd()) {
+		zassert_true(n < ARRAY_SIZE(fds));
+		zassert_true(fd < FD_MAX);
+		zvfs_finalize_fd(fd, &fds[n], VTABLE_INIT);
+		fds[n++] = fd;
+	}
+	zassert_equal(errno, ENFILE);
+	zassert_equal(fds[n - 1], FD_MAX - 1);
+
+	for (int i = 0; i < n; i++) {
+		zassert_equal_ptr(zvfs_get_fd_obj_and_vtable(fds[i], &vtable, NULL), &fds[i]);
+		zvfs_free_fd(fds[i]);
+	}
+
+	zassert_equal(zvfs_reserve_fd(), fds[0]);
+	zvfs_free_fd(fds[0]);
+}
+
 static void test_cb(void *p1, void *p2, void *p3)
 {
 	ARG_UNUSED(p2);
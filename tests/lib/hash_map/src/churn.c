@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+
+#include "_main.h"
+
+#define N_KEYS (2 * MANY)
+#define N_OPS  (20 * MANY)
+
+static uint32_t seed = 42;
+static bool present[N_KEYS];
+static uint64_t values[N_KEYS];
+
+static uint32_t next_rand(void)
+{
+	seed = seed * 1103515245U + 12345U;
+	return seed >> 8;
+}
+
+static void foreach_callback(uint64_t key, uint64_t value, void *cookie)
+{
+	size_t *n = cookie;
+
+	zassert_true(key < N_KEYS && present[key], "unexpected key %llu", key);
+	zassert_equal(value, values[key]);
+	++*n;
+}
+
+/* Random insertions and removals, with the table growing and shrinking */
+ZTEST(hash_map, test_churn)
+{
+	int ret;
+	size_t n = 0;
+	size_t size = 0;
+	uint64_t value;
+
+	for (size_t i = 0; i < N_OPS; ++i) {
+		uint32_t r = next_rand();
+		uint64_t key = r % N_KEYS;
+		/* mostly insert during the first half, mostly remove during the second */
+		bool insert = ((r >> 16) % 4) != 0;
+
+		if (i >= N_OPS / 2) {
+			insert = !insert;
+		}
+
+		if (insert) {
+			ret = sys_hashmap_insert(&map, key, r, NULL);
+			zassert_equal(ret, present[key] ? 0 : 1, "insert %llu: %d", key, ret);
+			size += !present[key];
+			present[key] = true;
+			values[key] = r;
+		} else {
+			zassert_equal(sys_hashmap_remove(&map, key, &value), present[key],
+				      "remove %llu", key);
+			if (present[key]) {
+				zassert_equal(value, values[key]);
+				--size;
+			}
+			present[key] = false;
+		}
+
+		zassert_equal(sys_hashmap_size(&map), size);
+	}
+
+	for (uint64_t key = 0; key < N_KEYS; ++key) {
+		zassert_equal(sys_hashmap_get(&map, key, &value), present[key], "get %llu", key);
+		if (present[key]) {
+			zassert_equal(value, values[key]);
+		}
+	}
+
+	sys_hashmap_foreach(&map, foreach_callback, &n);
+	zassert_equal(n, size);
+}
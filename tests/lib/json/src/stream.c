@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/data/json.h>
+
+static const char payload[] =
+	"{\"some_string\": \"zephyr \\\"123\\u00e9\\\"\", \"some_int\": -42,\n"
+	" \"some_array\": [1, 2.5e3, true, false, null, [], {}],\n"
+	" \"nested\": {\"a\": [\"\", {\"b\": 123456789}]}}";
+
+/* One token per line: its type, 'k' for keys, and its text */
+static const char tokens[] =
+	"{\n"
+	"\"ksome_string\n"
+	"\"zephyr \\\"123\\u00e9\\\"\n"
+	"\"ksome_int\n"
+	"0-42\n"
+	"\"ksome_array\n"
+	"[\n"
+	"01\n"
+	"02.5e3\n"
+	"ttrue\n"
+	"ffalse\n"
+	"nnull\n"
+	"[\n"
+	"]\n"
+	"{\n"
+	"}\n"
+	"]\n"
+	"\"knested\n"
+	"{\n"
+	"\"ka\n"
+	"[\n"
+	"\"\n"
+	"{\n"
+	"\"kb\n"
+	"0123456789\n"
+	"}\n"
+	"]\n"
+	"}\n"
+	"}\n";
+
+static char dump[512];
+static size_t dump_len;
+
+static void dump_token(const struct json_stream_token *tok)
+{
+	zassert_true(dump_len + tok->length + 3 < sizeof(dump));
+
+	dump[dump_len++] = (char)tok->type;
+	if (tok->key) {
+		dump[dump_len++] = 'k';
+	}
+	memcpy(&dump[dump_len], tok->start, tok->length);
+	dump_len += tok->length;
+	dump[dump_len++] = '\n';
+	dump[dump_len] = '\0';
+}
+
+/* Parses the payload in chunks of chunk_len bytes, after a first one of first_len */
+static int parse(const char *json, size_t first_len, size_t chunk_len,
+		 char *buf, size_t buf_size)
+{
+	struct json_stream_parser parser;
+	struct json_stream_token tok;
+	size_t len = strlen(json);
+	size_t pos = MIN(first_len, len);
+	int ret;
+
+	dump_len = 0;
+	dump[0] = '\0';
+
+	json_stream_parser_init(&parser, buf, buf_size);
+	json_stream_parser_feed(&parser, json, pos);
+
+	while (true) {
+		ret = json_stream_parser_next(&parser, &tok);
+		if (ret == -EAGAIN) {
+			size_t n = MIN(chunk_len, len - pos);
+
+			json_stream_parser_feed(&parser, &json[pos], n);
+			pos += n;
+			continue;
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (tok.type == JSON_TOK_EOF) {
+			return 0;
+		}
+
+		dump_token(&tok);
+	}
+}
+
+ZTEST(lib_json_stream, test_stream_tokens)
+{
+	char buf[32];
+
+	zassert_ok(parse(payload, sizeof(payload), 0, buf, sizeof(buf)));
+	zassert_str_equal(dump, tokens);
+
+	/* Without buffer, as nothing is split */
+	zassert_ok(parse(payload, sizeof(payload), 0, NULL, 0));
+	zassert_str_equal(dump, tokens);
+}
+
+ZTEST(lib_json_stream, test_stream_chunks)
+{
+	char buf[32];
+
+	for (size_t i = 1; i < sizeof(payload) - 1; i++) {
+		zassert_ok(parse(payload, i, sizeof(payload), buf, sizeof(buf)),
+			   "split at %zu", i);
+		zassert_str_equal(dump, tokens, "split at %zu", i);
+	}
+
+	for (size_t i = 1; i < 8; i++) {
+		zassert_ok(parse(payload, i, i, buf, sizeof(buf)), "chunks of %zu", i);
+		zassert_str_equal(dump, tokens, "chunks of %zu", i);
+	}
+}
+
+ZTEST(lib_json_stream, test_stream_top_level)
+{
+	char buf[8];
+
+	zassert_ok(parse("  -1234 ", 3, 1, buf, sizeof(buf)));
+	zassert_str_equal(dump, "0-1234\n");
+
+	/* Only the end of the payload ends the number */
+	zassert_ok(parse("5678", 2, 1, buf, sizeof(buf)));
+	zassert_str_equal(dump, "05678\n");
+
+	zassert_ok(parse("\"str\"", 1, 1, buf, sizeof(buf)));
+	zassert_str_equal(dump, "\"str\n");
+
+	zassert_ok(parse("[]", 1, 1, buf, sizeof(buf)));
+	zassert_str_equal(dump, "[\n]\n");
+}
+
+ZTEST(lib_json_stream, test_stream_invalid)
+{
+	static const char *const invalid[] = {
+		"",
+		"{",
+		"[1,]",
+		"{\"a\":1,}",
+		"{\"a\" 1}",
+		"{\"a\":1 \"b\":2}",
+		"{1:2}",
+		"[\"a\":1]",
+		"[1}",
+		"{\"a\":1]",
+		"]",
+		"[tru]",
+		"[nul",
+		"[falsy]",
+		"[\"\\x\"]",
+		"[\"\\u12g4\"]",
+		"[\"abc",
+		"[+1]",
+		"[1 2]",
+		"{\"a\"::1}",
+	};
+	char buf[8];
+
+	for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+		zassert_equal(parse(invalid[i], SIZE_MAX, 0, buf, sizeof(buf)), -EINVAL,
+			      "%s", invalid[i]);
+		zassert_equal(parse(invalid[i], 1, 1, buf, sizeof(buf)), -EINVAL,
+			      "%s", invalid[i]);
+	}
+
+	/* Once the value is complete, the rest of the chunk is still checked */
+	zassert_equal(parse("[1] [2]", SIZE_MAX, 0, buf, sizeof(buf)), -EINVAL);
+}
+
+ZTEST(lib_json_stream, test_stream_nesting)
+{
+	char json[2 * (JSON_STREAM_MAX_DEPTH + 1) + 1];
+
+	memset(json, '[', JSON_STREAM_MAX_DEPTH);
+	memset(&json[JSON_STREAM_MAX_DEPTH], ']', JSON_STREAM_MAX_DEPTH);
+	json[2 * JSON_STREAM_MAX_DEPTH] = '\0';
+	zassert_ok(parse(json, SIZE_MAX, 0, NULL, 0));
+
+	memset(json, '[', JSON_STREAM_MAX_DEPTH + 1);
+	memset(&json[JSON_STREAM_MAX_DEPTH + 1], ']', JSON_STREAM_MAX_DEPTH + 1);
+	json[2 * (JSON_STREAM_MAX_DEPTH + 1)] = '\0';
+	zassert_equal(parse(json, SIZE_MAX, 0, NULL, 0), -EINVAL);
+}
+
+ZTEST(lib_json_stream, test_stream_nomem)
+{
+	char buf[4];
+
+	/* Split tokens up to the size of the buffer */
+	zassert_ok(parse("[\"abcd\"]", 3, 1, buf, sizeof(buf)));
+	zassert_str_equal(dump, "[\n\"abcd\n]\n");
+	zassert_ok(parse("[1234]", 3, 1, buf, sizeof(buf)));
+
+	zassert_equal(parse("[\"abcde\"]", 3, 1, buf, sizeof(buf)), -ENOMEM);
+	zassert_equal(parse("[12345]", 3, 1, buf, sizeof(buf)), -ENOMEM);
+	zassert_equal(parse("[1234]", 3, 1, NULL, 0), -ENOMEM);
+}
+
+struct enc_out {
+	char data[256];
+	size_t len;
+	size_t flushes;
+};
+
+static int enc_flush(const char *bytes, size_t len, void *data)
+{
+	struct enc_out *out = data;
+
+	zassert_true(out->len + len < sizeof(out->data));
+	memcpy(&out->data[out->len], bytes, len);
+	out->len += len;
+	out->data[out->len] = '\0';
+	out->flushes++;
+
+	return 0;
+}
+
+static int encode(struct json_stream_encoder *enc)
+{
+	int ret = 0;
+
+	ret |= json_stream_encode_obj_start(enc, NULL);
+	ret |= json_stream_encode_string(enc, "some_string", "zephyr \"123\"\n");
+	ret |= json_stream_encode_number(enc, "some_int", -42);
+	ret |= json_stream_encode_arr_start(enc, "some_array");
+	ret |= json_stream_encode_number(enc, NULL, INT64_MIN);
+	ret |= json_stream_encode_number(enc, NULL, 0);
+	ret |= json_stream_encode_bool(enc, NULL, true);
+	ret |= json_stream_encode_bool(enc, NULL, false);
+	ret |= json_stream_encode_null(enc, NULL);
+	ret |= json_stream_encode_arr_start(enc, NULL);
+	ret |= json_stream_encode_arr_end(enc);
+	ret |= json_stream_encode_obj_start(enc, NULL);
+	ret |= json_stream_encode_obj_end(enc);
+	ret |= json_stream_encode_arr_end(enc);
+	ret |= json_stream_encode_obj_start(enc, "nested");
+	ret |= json_stream_encode_string(enc, "a", "");
+	ret |= json_stream_encode_obj_end(enc);
+	ret |= json_stream_encode_obj_end(enc);
+	ret |= json_stream_encoder_flush(enc);
+
+	return ret;
+}
+
+ZTEST(lib_json_stream, test_stream_encode)
+{
+	static const char expected[] =
+		"{\"some_string\":\"zephyr \\\"123\\\"\\n\",\"some_int\":-42,"
+		"\"some_array\":[-9223372036854775808,0,true,false,null,[],{}],"
+		"\"nested\":{\"a\":\"\"}}";
+	struct json_stream_encoder enc;
+	struct enc_out out;
+	char buf[16];
+
+	for (size_t size = 1; size <= sizeof(buf); size++) {
+		out = (struct enc_out) { 0 };
+		zassert_ok(json_stream_encoder_init(&enc, buf, size, enc_flush, &out));
+
+		zassert_ok(encode(&enc), "buffer of %zu", size);
+		zassert_str_equal(out.data, expected, "buffer of %zu", size);
+		zassert_equal(out.flushes, DIV_ROUND_UP(sizeof(expected) - 1, size));
+	}
+
+	/* Parsed back */
+	zassert_ok(parse(out.data, SIZE_MAX, 0, NULL, 0));
+}
+
+static int enc_fail(const char *bytes, size_t len, void *data)
+{
+	ARG_UNUSED(bytes);
+	ARG_UNUSED(len);
+	ARG_UNUSED(data);
+
+	return -EIO;
+}
+
+ZTEST(lib_json_stream, test_stream_encode_invalid)
+{
+	struct json_stream_encoder enc;
+	struct enc_out out = { 0 };
+	char buf[8];
+
+	/* An empty buffer would never be flushed */
+	zassert_equal(json_stream_encoder_init(&enc, buf, 0, enc_flush, &out), -EINVAL);
+
+	zassert_ok(json_stream_encoder_init(&enc, buf, sizeof(buf), enc_flush, &out));
+
+	/* Keys only in objects */
+	zassert_equal(json_stream_encode_number(&enc, "a", 1), -EINVAL);
+	zassert_ok(json_stream_encode_arr_start(&enc, NULL));
+	zassert_equal(json_stream_encode_null(&enc, "a"), -EINVAL);
+	zassert_equal(json_stream_encode_obj_end(&enc), -EINVAL);
+	zassert_ok(json_stream_encode_obj_start(&enc, NULL));
+	zassert_equal(json_stream_encode_null(&enc, NULL), -EINVAL);
+	zassert_equal(json_stream_encode_arr_end(&enc), -EINVAL);
+	zassert_ok(json_stream_encode_obj_end(&enc));
+	zassert_ok(json_stream_encode_arr_end(&enc));
+	zassert_equal(json_stream_encode_arr_end(&enc), -EINVAL);
+	zassert_ok(json_stream_encoder_flush(&enc));
+	zassert_str_equal(out.data, "[{}]");
+
+	for (int i = 0; i < JSON_STREAM_MAX_DEPTH; i++) {
+		zassert_ok(json_stream_encode_arr_start(&enc, NULL));
+	}
+	zassert_equal(json_stream_encode_arr_start(&enc, NULL), -EINVAL);
+
+	/* Errors of the flush function */
+	zassert_ok(json_stream_encoder_init(&enc, buf, sizeof(buf), enc_fail, NULL));
+	zassert_ok(json_stream_encode_string(&enc, NULL, "123456"));
+	zassert_equal(json_stream_encoder_flush(&enc), -EIO);
+	zassert_equal(json_stream_encode_string(&enc, NULL, "12345678"), -EIO);
+}
+
+ZTEST_SUITE(lib_json_stream, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mpmc_lockfree.h>
+
+MPMC_DEFINE(test_q, sizeof(uint32_t), 8);
+
+static void mpmc_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	mpmc_init(&test_q);
+}
+
+/*
+ * @brief Put and get one element at a time, around the queue
+ *
+ * @see mpmc_put(), mpmc_get()
+ *
+ * @ingroup tests
+ */
+ZTEST(mpmc, test_put_get)
+{
+	uint32_t val;
+
+	zassert_false(mpmc_get(&test_q, &val), "Get on empty queue should fail");
+
+	for (uint32_t i = 0; i < 20; i++) {
+		zassert_true(mpmc_put(&test_q, &i), "Put should succeed");
+		zassert_true(mpmc_get(&test_q, &val), "Get should succeed");
+		zassert_equal(val, i, "Got %u instead of %u", val, i);
+	}
+
+	for (uint32_t i = 0; i < 8; i++) {
+		zassert_true(mpmc_put(&test_q, &i), "Put should succeed");
+	}
+	zassert_false(mpmc_put(&test_q, &val), "Put on full queue should fail");
+
+	for (uint32_t i = 0; i < 8; i++) {
+		zassert_true(mpmc_get(&test_q, &val), "Get should succeed");
+		zassert_equal(val, i, "Got %u instead of %u", val, i);
+	}
+	zassert_false(mpmc_get(&test_q, &val), "Get on empty queue should fail");
+}
+
+/*
+ * @brief Put and get in batches, limited by the space and data available
+ *
+ * @see mpmc_put_many(), mpmc_get_many()
+ *
+ * @ingroup tests
+ */
+ZTEST(mpmc, test_put_get_many)
+{
+	uint32_t in[12], out[12];
+
+	for (uint32_t i = 0; i < ARRAY_SIZE(in); i++) {
+		in[i] = i;
+	}
+
+	zassert_equal(mpmc_put_many(&test_q, in, 0), 0);
+	zassert_equal(mpmc_put_many(&test_q, in, 5), 5);
+	zassert_equal(mpmc_put_many(&test_q, &in[5], 7), 3, "Only 3 should fit");
+	zassert_equal(mpmc_put_many(&test_q, in, 1), 0);
+
+	zassert_equal(mpmc_get_many(&test_q, out, 0), 0);
+	zassert_equal(mpmc_get_many(&test_q, out, 6), 6);
+	zassert_mem_equal(out, in, 6 * sizeof(in[0]));
+
+	/* Across the end of the array */
+	zassert_equal(mpmc_put_many(&test_q, &in[8], 4), 4);
+	zassert_equal(mpmc_get_many(&test_q, out, ARRAY_SIZE(out)), 6);
+	zassert_mem_equal(out, &in[6], 6 * sizeof(in[0]));
+	zassert_equal(mpmc_get_many(&test_q, out, ARRAY_SIZE(out)), 0);
+}
+
+#define MPMC_ITERATIONS 20000
+#define MPMC_BATCH 3
+#define MPMC_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MPMC_PRODUCERS 2
+#define MPMC_CONSUMERS 2
+#define MPMC_THREADS_NUM (MPMC_PRODUCERS + MPMC_CONSUMERS)
+
+static struct k_thread mpmc_thread[MPMC_THREADS_NUM];
+static K_THREAD_STACK_ARRAY_DEFINE(mpmc_stack, MPMC_THREADS_NUM, MPMC_STACK_SIZE);
+
+/* Next value expected from each producer, by each consumer */
+static uint32_t mpmc_expected[MPMC_CONSUMERS][MPMC_PRODUCERS];
+static atomic_t mpmc_received;
+
+/* The producer in the top byte, and a counter below */
+static void mpmc_producer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	uint32_t id = (uint32_t)(uintptr_t)p1;
+	uint32_t batch[MPMC_BATCH];
+	uint32_t sent = 0;
+
+	while (sent < MPMC_ITERATIONS) {
+		size_t len = MIN(MPMC_BATCH, MPMC_ITERATIONS - sent);
+		size_t put;
+
+		for (size_t i = 0; i < len; i++) {
+			batch[i] = (id << 24) | (sent + i);
+		}
+
+		put = mpmc_put_many(&test_q, batch, len);
+		if (put == 0) {
+			k_yield();
+		}
+		sent += put;
+	}
+}
+
+static void mpmc_consumer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	uint32_t id = (uint32_t)(uintptr_t)p1;
+	uint32_t batch[MPMC_BATCH];
+
+	while (atomic_get(&mpmc_received) < MPMC_ITERATIONS * MPMC_PRODUCERS) {
+		size_t got = mpmc_get_many(&test_q, batch, ARRAY_SIZE(batch));
+
+		if (got == 0) {
+			k_yield();
+			continue;
+		}
+
+		for (size_t i = 0; i < got; i++) {
+			uint32_t producer = batch[i] >> 24;
+			uint32_t count = batch[i] & BIT_MASK(24);
+
+			/* Each consumer sees the values of a producer in order */
+			zassert_true(producer < MPMC_PRODUCERS, "Bad producer %u", producer);
+			zassert_true(count >= mpmc_expected[id][producer],
+				     "Value %u of producer %u out of order", count, producer);
+			mpmc_expected[id][producer] = count + 1;
+		}
+
+		atomic_add(&mpmc_received, got);
+	}
+}
+
+/**
+ * @brief Test that the producers and consumers are indeed thread safe
+ *
+ * This can and should be validated on SMP machines where incoherent
+ * memory could cause issues.
+ */
+ZTEST(mpmc, test_mpmc_threaded)
+{
+	int prio = k_thread_priority_get(k_current_get());
+
+	memset(mpmc_expected, 0, sizeof(mpmc_expected));
+	atomic_clear(&mpmc_received);
+
+	for (int i = 0; i < MPMC_CONSUMERS; i++) {
+		k_thread_create(&mpmc_thread[i], mpmc_stack[i], MPMC_STACK_SIZE,
+				mpmc_consumer, (void *)(uintptr_t)i, NULL, NULL,
+				prio, K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < MPMC_PRODUCERS; i++) {
+		k_thread_create(&mpmc_thread[MPMC_CONSUMERS + i],
+				mpmc_stack[MPMC_CONSUMERS + i], MPMC_STACK_SIZE,
+				mpmc_producer, (void *)(uintptr_t)i, NULL, NULL,
+				prio, K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < MPMC_THREADS_NUM; i++) {
+		k_thread_join(&mpmc_thread[i], K_FOREVER);
+	}
+
+	zassert_equal(atomic_get(&mpmc_received), MPMC_ITERATIONS * MPMC_PRODUCERS);
+	zassert_false(mpmc_get(&test_q, &(uint32_t){0}), "Queue should be empty");
+}
+
+ZTEST_SUITE(mpmc, NULL, NULL, mpmc_before, NULL, NULL);
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/spsc_ring_buf.h>
+
+SPSC_RING_BUF_DEFINE(test_rb, 16);
+
+static void spsc_ring_buf_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	spsc_ring_buf_reset(&test_rb);
+}
+
+/*
+ * @brief Put and get until full and empty
+ *
+ * @see spsc_ring_buf_put(), spsc_ring_buf_get()
+ *
+ * @ingroup tests
+ */
+ZTEST(spsc_ring_buf, test_put_get)
+{
+	uint8_t in[20], out[20];
+
+	for (int i = 0; i < ARRAY_SIZE(in); i++) {
+		in[i] = i;
+	}
+
+	zassert_equal(spsc_ring_buf_capacity_get(&test_rb), 16);
+	zassert_true(spsc_ring_buf_is_empty(&test_rb), "Should be empty");
+	zassert_equal(spsc_ring_buf_get(&test_rb, out, sizeof(out)), 0,
+		      "Get on empty should return 0");
+
+	zassert_equal(spsc_ring_buf_put(&test_rb, in, 10), 10);
+	zassert_equal(spsc_ring_buf_space_get(&test_rb), 6);
+	zassert_equal(spsc_ring_buf_size_get(&test_rb), 10);
+
+	/* Only what fits is put */
+	zassert_equal(spsc_ring_buf_put(&test_rb, &in[10], 10), 6);
+	zassert_equal(spsc_ring_buf_space_get(&test_rb), 0);
+	zassert_equal(spsc_ring_buf_put(&test_rb, in, 1), 0);
+
+	zassert_equal(spsc_ring_buf_get(&test_rb, out, sizeof(out)), 16);
+	zassert_mem_equal(out, in, 16);
+	zassert_true(spsc_ring_buf_is_empty(&test_rb), "Should be empty");
+	zassert_equal(spsc_ring_buf_space_get(&test_rb), 16);
+}
+
+/*
+ * @brief Put and get across the end of the buffer, and discard data
+ *
+ * @see spsc_ring_buf_put(), spsc_ring_buf_get()
+ *
+ * @ingroup tests
+ */
+ZTEST(spsc_ring_buf, test_wrap_around)
+{
+	uint8_t in[7], out[7];
+
+	for (int i = 0; i < 50; i++) {
+		for (int j = 0; j < ARRAY_SIZE(in); j++) {
+			in[j] = i + j;
+		}
+
+		zassert_equal(spsc_ring_buf_put(&test_rb, in, sizeof(in)), sizeof(in));
+		zassert_equal(spsc_ring_buf_get(&test_rb, out, 3), 3);
+		zassert_equal(spsc_ring_buf_get(&test_rb, &out[3], sizeof(out)), 4);
+		zassert_mem_equal(out, in, sizeof(in));
+	}
+
+	zassert_equal(spsc_ring_buf_put(&test_rb, in, sizeof(in)), sizeof(in));
+	zassert_equal(spsc_ring_buf_get(&test_rb, NULL, 5), 5);
+	zassert_equal(spsc_ring_buf_size_get(&test_rb), 2);
+	zassert_equal(spsc_ring_buf_get(&test_rb, out, sizeof(out)), 2);
+	zassert_mem_equal(out, &in[5], 2);
+}
+
+#define SPSC_RING_BUF_BYTES 100000
+#define SPSC_RING_BUF_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_thread spsc_ring_buf_thread;
+static K_THREAD_STACK_DEFINE(spsc_ring_buf_stack, SPSC_RING_BUF_STACK_SIZE);
+
+static void spsc_ring_buf_producer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	uint8_t chunk[5];
+	uint32_t sent = 0;
+
+	while (sent < SPSC_RING_BUF_BYTES) {
+		uint32_t len = MIN(sizeof(chunk), SPSC_RING_BUF_BYTES - sent);
+		uint32_t put;
+
+		for (int i = 0; i < len; i++) {
+			chunk[i] = (uint8_t)(sent + i);
+		}
+
+		put = spsc_ring_buf_put(&test_rb, chunk, len);
+		if (put < len) {
+			/* Full, let the consumer catch up */
+			k_yield();
+		}
+		sent += put;
+	}
+}
+
+/**
+ * @brief Test that the producer and consumer are indeed thread safe
+ *
+ * This can and should be validated on SMP machines where incoherent
+ * memory could cause issues.
+ */
+ZTEST(spsc_ring_buf, test_spsc_ring_buf_threaded)
+{
+	uint8_t chunk[3];
+	uint32_t received = 0;
+
+	/* At the same priority, for the threads to take turns when yielding */
+	k_thread_create(&spsc_ring_buf_thread, spsc_ring_buf_stack,
+			SPSC_RING_BUF_STACK_SIZE, spsc_ring_buf_producer,
+			NULL, NULL, NULL, k_thread_priority_get(k_current_get()),
+			K_INHERIT_PERMS, K_NO_WAIT);
+
+	while (received < SPSC_RING_BUF_BYTES) {
+		uint32_t got = spsc_ring_buf_get(&test_rb, chunk, sizeof(chunk));
+
+		if (got == 0) {
+			k_yield();
+			continue;
+		}
+
+		for (int i = 0; i < got; i++) {
+			zassert_equal(chunk[i], (uint8_t)(received + i),
+				      "Byte %u out of order", received + i);
+		}
+		received += got;
+	}
+
+	k_thread_join(&spsc_ring_buf_thread, K_FOREVER);
+	zassert_true(spsc_ring_buf_is_empty(&test_rb), "Should be empty");
+}
+
+ZTEST_SUITE(spsc_ring_buf, NULL, NULL, spsc_ring_buf_before, NULL, NULL);
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/sys/mpsc_pbuf.h>
+
+#define LEN_BITS 6
+#define PRODUCER_BITS 4
+#define SEQ_BITS (32 - MPSC_PBUF_HDR_BITS - LEN_BITS - PRODUCER_BITS)
+
+struct test_packet {
+	MPSC_PBUF_HDR;
+	uint32_t len : LEN_BITS;
+	uint32_t producer : PRODUCER_BITS;
+	uint32_t seq : SEQ_BITS;
+	uint32_t buf[];
+};
+
+#define NUM_PRODUCERS 8
+#define NUM_PACKETS 2000
+#define MAX_WLEN 8
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static uint32_t buf32[128];
+static struct mpsc_pbuf_buffer buffer;
+
+static ATOMIC_DEFINE(seen, NUM_PRODUCERS * NUM_PACKETS);
+static atomic_t dropped;
+static atomic_t bad;
+static atomic_t done;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_PRODUCERS, STACK_SIZE);
+static struct k_thread threads[NUM_PRODUCERS];
+
+static uint32_t get_wlen(const union mpsc_pbuf_generic *item)
+{
+	return ((const struct test_packet *)item)->len;
+}
+
+static uint32_t payload(uint32_t producer, uint32_t seq, int i)
+{
+	return ((producer << 24) | seq) + i;
+}
+
+/* Record a packet consumed or dropped, which must be intact and seen once */
+static void check(const union mpsc_pbuf_generic *item)
+{
+	const struct test_packet *packet = (const struct test_packet *)item;
+
+	for (int i = 0; i < packet->len - 1; i++) {
+		if (packet->buf[i] != payload(packet->producer, packet->seq, i)) {
+			atomic_inc(&bad);
+		}
+	}
+
+	if (atomic_test_and_set_bit(seen, packet->producer * NUM_PACKETS + packet->seq)) {
+		atomic_inc(&bad);
+	}
+}
+
+static void drop(const struct mpsc_pbuf_buffer *buffer, const union mpsc_pbuf_generic *item)
+{
+	atomic_inc(&dropped);
+	check(item);
+}
+
+static void init(uint32_t size, uint32_t flags)
+{
+	struct mpsc_pbuf_buffer_config config = {
+		.buf = buf32,
+		.size = size,
+		.notify_drop = drop,
+		.get_wlen = get_wlen,
+		.flags = flags,
+	};
+
+	memset(seen, 0, sizeof(seen));
+	atomic_clear(&dropped);
+	atomic_clear(&bad);
+	atomic_clear(&done);
+	mpsc_pbuf_init(&buffer, &config);
+}
+
+static struct test_packet *alloc(uint32_t producer, uint32_t seq, uint32_t wlen)
+{
+	struct test_packet *packet =
+		(struct test_packet *)mpsc_pbuf_alloc(&buffer, wlen, K_NO_WAIT);
+
+	if (packet != NULL) {
+		packet->len = wlen;
+		packet->producer = producer;
+		packet->seq = seq;
+		for (int i = 0; i < wlen - 1; i++) {
+			packet->buf[i] = payload(producer, seq, i);
+		}
+	}
+
+	return packet;
+}
+
+static void commit(struct test_packet *packet)
+{
+	mpsc_pbuf_commit(&buffer, (union mpsc_pbuf_generic *)packet);
+}
+
+static void claim_free(uint32_t producer, uint32_t seq)
+{
+	const struct test_packet *packet = (const struct test_packet *)mpsc_pbuf_claim(&buffer);
+
+	zassert_not_null(packet, "Expected packet %u", seq);
+	zassert_equal(packet->producer, producer);
+	zassert_equal(packet->seq, seq, "Got %u instead of %u", packet->seq, seq);
+	check((const union mpsc_pbuf_generic *)packet);
+	mpsc_pbuf_free(&buffer, (const union mpsc_pbuf_generic *)packet);
+}
+
+static void lockfree_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_MPSC_PBUF_LOCKFREE);
+}
+
+ZTEST(mpsc_pbuf_lockfree, test_alloc_commit)
+{
+	struct test_packet *p0, *p1;
+
+	init(16, MPSC_PBUF_MODE_LOCKFREE);
+	zassert_true(buffer.flags & MPSC_PBUF_MODE_LOCKFREE);
+
+	p0 = alloc(0, 0, 3);
+	p1 = alloc(0, 1, 3);
+	zassert_not_null(p0);
+	zassert_not_null(p1);
+
+	/* Packets are claimed in order, once committed */
+	zassert_false(mpsc_pbuf_is_pending(&buffer));
+	commit(p1);
+	zassert_is_null(mpsc_pbuf_claim(&buffer));
+	commit(p0);
+	zassert_true(mpsc_pbuf_is_pending(&buffer));
+
+	claim_free(0, 0);
+	claim_free(0, 1);
+	zassert_is_null(mpsc_pbuf_claim(&buffer));
+	zassert_false(mpsc_pbuf_is_pending(&buffer));
+	zassert_equal(atomic_get(&bad), 0);
+}
+
+ZTEST(mpsc_pbuf_lockfree, test_wrap)
+{
+	uint32_t size, now, max;
+
+	init(16, MPSC_PBUF_MODE_LOCKFREE | MPSC_PBUF_MAX_UTILIZATION);
+
+	/* 5 words left at the end, skipped by the next packet of 6 */
+	for (uint32_t i = 0; i < 10; i++) {
+		commit(alloc(0, i, (i % 2) ? 5 : 6));
+		claim_free(0, i);
+	}
+
+	mpsc_pbuf_get_utilization(&buffer, &size, &now);
+	zassert_equal(size, 16 * sizeof(int));
+	zassert_equal(now, 0);
+	zassert_ok(mpsc_pbuf_get_max_utilization(&buffer, &max));
+	zassert_true(max >= 6 * sizeof(int));
+
+	zassert_equal(atomic_get(&bad), 0);
+}
+
+ZTEST(mpsc_pbuf_lockfree, test_free_out_of_order)
+{
+	const union mpsc_pbuf_generic *p0, *p1;
+	uint32_t size, now;
+
+	init(16, MPSC_PBUF_MODE_LOCKFREE);
+
+	commit(alloc(0, 0, 4));
+	commit(alloc(0, 1, 4));
+	commit(alloc(0, 2, 4));
+
+	p0 = mpsc_pbuf_claim(&buffer);
+	p1 = mpsc_pbuf_claim(&buffer);
+
+	/* Space is released in order */
+	mpsc_pbuf_free(&buffer, p1);
+	mpsc_pbuf_get_utilization(&buffer, &size, &now);
+	zassert_equal(now, 12 * sizeof(int));
+	mpsc_pbuf_free(&buffer, p0);
+	mpsc_pbuf_get_utilization(&buffer, &size, &now);
+	zassert_equal(now, 4 * sizeof(int));
+
+	claim_free(0, 2);
+}
+
+ZTEST(mpsc_pbuf_lockfree, test_no_overwrite)
+{
+	init(16, MPSC_PBUF_MODE_LOCKFREE);
+
+	for (uint32_t i = 0; i < 4; i++) {
+		commit(alloc(0, i, 4));
+	}
+	zassert_is_null(alloc(0, 4, 1), "Buffer should be full");
+	zassert_equal(atomic_get(&dropped), 0);
+
+	claim_free(0, 0);
+	commit(alloc(0, 4, 4));
+	zassert_is_null(alloc(0, 5, 1), "Buffer should be full");
+}
+
+ZTEST(mpsc_pbuf_lockfree, test_overwrite)
+{
+	const union mpsc_pbuf_generic *claimed;
+
+	init(16, MPSC_PBUF_MODE_LOCKFREE | MPSC_PBUF_MODE_OVERWRITE);
+
+	for (uint32_t i = 0; i < 4; i++) {
+		commit(alloc(0, i, 4));
+	}
+
+	/* The oldest are dropped */
+	commit(alloc(0, 4, 6));
+	zassert_equal(atomic_get(&dropped), 2);
+
+	/* Passing over the claimed one */
+	claimed = mpsc_pbuf_claim(&buffer);
+	zassert_equal(((const struct test_packet *)claimed)->seq, 2);
+	commit(alloc(0, 5, 6));
+	zassert_equal(atomic_get(&dropped), 4);
+	mpsc_pbuf_free(&buffer, claimed);
+
+	claim_free(0, 5);
+	zassert_is_null(mpsc_pbuf_claim(&buffer));
+	zassert_equal(atomic_get(&bad), 0);
+
+	/* Not when not committed */
+	struct test_packet *p = alloc(0, 6, 8);
+
+	commit(alloc(0, 7, 4));
+	zassert_is_null(alloc(0, 8, 4));
+	commit(p);
+	claim_free(0, 6);
+	claim_free(0, 7);
+	zassert_equal(atomic_get(&dropped), 4);
+}
+
+ZTEST(mpsc_pbuf_lockfree, test_overwrite_claimed)
+{
+	const union mpsc_pbuf_generic *claimed;
+
+	init(16, MPSC_PBUF_MODE_LOCKFREE | MPSC_PBUF_MODE_OVERWRITE);
+
+	for (uint32_t i = 0; i < 4; i++) {
+		commit(alloc(0, i, 4));
+	}
+
+	/* The oldest one is claimed, the next one is dropped instead */
+	claimed = mpsc_pbuf_claim(&buffer);
+	zassert_equal(((const struct test_packet *)claimed)->seq, 0);
+	commit(alloc(0, 4, 4));
+	zassert_equal(atomic_get(&dropped), 1);
+	zassert_true(atomic_test_bit(seen, 1));
+	zassert_false(atomic_test_bit(seen, 2));
+
+	/* And the claimed one is kept until freed */
+	commit(alloc(0, 5, 4));
+	zassert_equal(atomic_get(&dropped), 2);
+	zassert_true(atomic_test_bit(seen, 2));
+	mpsc_pbuf_free(&buffer, claimed);
+
+	claim_free(0, 3);
+	claim_free(0, 4);
+	claim_free(0, 5);
+	zassert_is_null(mpsc_pbuf_claim(&buffer));
+	zassert_equal(atomic_get(&bad), 0);
+}
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	uint32_t id = POINTER_TO_UINT(p1);
+	uint32_t seed = id + 1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t seq = 0; seq < NUM_PACKETS; seq++) {
+		struct test_packet *packet;
+
+		seed = seed * 1103515245U + 12345U;
+		while ((packet = alloc(id, seq, 1 + (seed >> 16) % MAX_WLEN)) == NULL) {
+			k_yield();
+		}
+		commit(packet);
+	}
+
+	atomic_inc(&done);
+}
+
+static void stress(const char *name, uint32_t flags)
+{
+	int prio = k_thread_priority_get(k_current_get());
+	uint32_t start, cycles;
+	uint32_t claimed = 0;
+
+	init(ARRAY_SIZE(buf32), flags);
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, producer,
+				UINT_TO_POINTER(i), NULL, NULL, prio, 0, K_NO_WAIT);
+	}
+
+	for (;;) {
+		bool last = atomic_get(&done) == NUM_PRODUCERS;
+		const union mpsc_pbuf_generic *item = mpsc_pbuf_claim(&buffer);
+
+		if (item != NULL) {
+			check(item);
+			mpsc_pbuf_free(&buffer, item);
+			claimed++;
+		} else if (last) {
+			break;
+		} else {
+			k_yield();
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	TC_PRINT("%s: %u claimed, %ld dropped, %u packets/s\n", name, claimed,
+		 atomic_get(&dropped),
+		 (uint32_t)(cycles ? (uint64_t)NUM_PRODUCERS * NUM_PACKETS *
+				     sys_clock_hw_cycles_per_sec() / cycles : 0));
+
+	zassert_equal(atomic_get(&bad), 0, "Packets corrupted or seen twice");
+	zassert_equal(claimed + atomic_get(&dropped), NUM_PRODUCERS * NUM_PACKETS,
+		      "Packets lost");
+	if (!(flags & MPSC_PBUF_MODE_OVERWRITE)) {
+		zassert_equal(atomic_get(&dropped), 0);
+	}
+}
+
+/* Producers on all CPUs, on SMP, consumed by the test thread. */
+ZTEST(mpsc_pbuf_lockfree, test_stress_producers)
+{
+	stress("locked", 0);
+	stress("locked, overwrite", MPSC_PBUF_MODE_OVERWRITE);
+
+	stress("lock-free", MPSC_PBUF_MODE_LOCKFREE);
+	stress("lock-free, overwrite", MPSC_PBUF_MODE_LOCKFREE | MPSC_PBUF_MODE_OVERWRITE);
+}
+
+ZTEST_SUITE(mpsc_pbuf_lockfree, NULL, NULL, lockfree_before, NULL, NULL);
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <aio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_aio.h"
+
+#define CHUNK_SIZE 100
+#define NUM_CHUNKS 4
+
+static K_SEM_DEFINE(notified, 0, NUM_CHUNKS + 1);
+static K_SEM_DEFINE(release, 0, 1);
+
+static void notify(union sigval value)
+{
+	zassert_equal(value.sival_int, 42);
+	k_sem_give(&notified);
+}
+
+static void notify_and_block(union sigval value)
+{
+	ARG_UNUSED(value);
+	k_sem_give(&notified);
+	k_sem_take(&release, K_FOREVER);
+}
+
+static void fill(uint8_t *buf, size_t len, uint8_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = (uint8_t)(seed + i * 7U);
+	}
+}
+
+void test_aio_wait(struct aiocb *cb)
+{
+	const struct aiocb *list[] = {cb};
+
+	while (aio_error(cb) == EINPROGRESS) {
+		zassert_ok(aio_suspend(list, ARRAY_SIZE(list), NULL));
+	}
+}
+
+int test_aio_open(void)
+{
+	int fd = open(TEST_AIO_FILE, O_CREAT | O_RDWR);
+
+	zassert_true(fd >= 0, "open failed: %d", errno);
+
+	return fd;
+}
+
+ZTEST(posix_aio, test_aio_read_write)
+{
+	static uint8_t out[NUM_CHUNKS][CHUNK_SIZE];
+	static uint8_t in[NUM_CHUNKS][CHUNK_SIZE];
+	struct aiocb cbs[NUM_CHUNKS];
+	struct aiocb sync_cb;
+	int fd = test_aio_open();
+
+	k_sem_reset(&notified);
+
+	for (int i = 0; i < NUM_CHUNKS; i++) {
+		fill(out[i], CHUNK_SIZE, i);
+		cbs[i] = (struct aiocb){
+			.aio_fildes = fd,
+			.aio_offset = i * CHUNK_SIZE,
+			.aio_buf = out[i],
+			.aio_nbytes = CHUNK_SIZE,
+			.aio_sigevent = {
+				.sigev_notify = SIGEV_THREAD,
+				.sigev_notify_function = notify,
+				.sigev_value.sival_int = 42,
+			},
+		};
+		zassert_ok(aio_write(&cbs[i]));
+	}
+
+	for (int i = 0; i < NUM_CHUNKS; i++) {
+		test_aio_wait(&cbs[i]);
+		zassert_ok(aio_error(&cbs[i]));
+		zassert_equal(aio_return(&cbs[i]), CHUNK_SIZE);
+		zassert_ok(k_sem_take(&notified, K_SECONDS(1)));
+
+		/* Released by aio_return() */
+		zassert_equal(aio_error(&cbs[i]), -1);
+		zassert_equal(errno, EINVAL);
+		zassert_equal(aio_return(&cbs[i]), -1);
+	}
+
+	sync_cb = (struct aiocb){.aio_fildes = fd};
+	zassert_ok(aio_fsync(O_SYNC, &sync_cb));
+	test_aio_wait(&sync_cb);
+	zassert_ok(aio_return(&sync_cb));
+
+	/* The offset of the file is unchanged */
+	zassert_equal(lseek(fd, 0, SEEK_CUR), 0);
+
+	for (int i = 0; i < NUM_CHUNKS; i++) {
+		cbs[i].aio_buf = in[i];
+		cbs[i].aio_sigevent.sigev_notify = SIGEV_NONE;
+		zassert_ok(aio_read(&cbs[i]));
+	}
+
+	for (int i = 0; i < NUM_CHUNKS; i++) {
+		test_aio_wait(&cbs[i]);
+		zassert_equal(aio_return(&cbs[i]), CHUNK_SIZE);
+		zassert_mem_equal(in[i], out[i], CHUNK_SIZE);
+	}
+
+	/* Short read at the end of the file */
+	cbs[0].aio_offset = NUM_CHUNKS * CHUNK_SIZE - 10;
+	zassert_ok(aio_read(&cbs[0]));
+	test_aio_wait(&cbs[0]);
+	zassert_equal(aio_return(&cbs[0]), 10);
+	zassert_mem_equal(in[0], &out[NUM_CHUNKS - 1][CHUNK_SIZE - 10], 10);
+
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_aio, test_lio_listio)
+{
+	static uint8_t out[NUM_CHUNKS][CHUNK_SIZE];
+	static uint8_t in[NUM_CHUNKS][CHUNK_SIZE];
+	struct aiocb cbs[NUM_CHUNKS];
+	struct aiocb nop = {.aio_lio_opcode = LIO_NOP};
+	struct aiocb *list[NUM_CHUNKS + 2];
+	struct sigevent sig = {
+		.sigev_notify = SIGEV_THREAD,
+		.sigev_notify_function = notify,
+		.sigev_value.sival_int = 42,
+	};
+	int fd = test_aio_open();
+
+	BUILD_ASSERT(ARRAY_SIZE(list) <= AIO_LISTIO_MAX);
+
+	k_sem_reset(&notified);
+
+	for (int i = 0; i < NUM_CHUNKS; i++) {
+		fill(out[i], CHUNK_SIZE, 100 + i);
+		cbs[i] = (struct aiocb){
+			.aio_fildes = fd,
+			.aio_offset = i * CHUNK_SIZE,
+			.aio_buf = out[i],
+			.aio_nbytes = CHUNK_SIZE,
+			.aio_lio_opcode = LIO_WRITE,
+		};
+		list[i] = &cbs[i];
+	}
+	list[NUM_CHUNKS] = NULL;
+	list[NUM_CHUNKS + 1] = &nop;
+
+	/* All done on return */
+	zassert_ok(lio_listio(LIO_WAIT, list, ARRAY_SIZE(list), NULL));
+	for (int i = 0; i < NUM_CHUNKS; i++) {
+		zassert_ok(aio_error(&cbs[i]));
+		zassert_equal(aio_return(&cbs[i]), CHUNK_SIZE);
+	}
+
+	for (int i = 0; i < NUM_CHUNKS; i++) {
+		cbs[i].aio_buf = in[i];
+		cbs[i].aio_lio_opcode = LIO_READ;
+	}
+
+	/* Notified once all are done */
+	zassert_ok(lio_listio(LIO_NOWAIT, list, ARRAY_SIZE(list), &sig));
+	zassert_ok(k_sem_take(&notified, K_SECONDS(1)));
+	for (int i = 0; i < NUM_CHUNKS; i++) {
+		zassert_ok(aio_error(&cbs[i]));
+		zassert_equal(aio_return(&cbs[i]), CHUNK_SIZE);
+		zassert_mem_equal(in[i], out[i], CHUNK_SIZE);
+	}
+	zassert_equal(k_sem_count_get(&notified), 0);
+
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_aio, test_aio_cancel)
+{
+	static uint8_t buf[CHUNK_SIZE];
+	struct aiocb blocking, cbs[2];
+	const struct aiocb *const list[] = {&cbs[0], &cbs[1]};
+	struct timespec timeout = {.tv_nsec = 10000000};
+	int fd = test_aio_open();
+
+	k_sem_reset(&notified);
+
+	/* The single worker is held in the notification, the others stay queued */
+	blocking = (struct aiocb){
+		.aio_fildes = fd,
+		.aio_buf = buf,
+		.aio_nbytes = CHUNK_SIZE,
+		.aio_sigevent = {
+			.sigev_notify = SIGEV_THREAD,
+			.sigev_notify_function = notify_and_block,
+		},
+	};
+	zassert_ok(aio_read(&blocking));
+	zassert_ok(k_sem_take(&notified, K_SECONDS(1)));
+
+	for (int i = 0; i < ARRAY_SIZE(cbs); i++) {
+		cbs[i] = (struct aiocb){
+			.aio_fildes = fd,
+			.aio_buf = buf,
+			.aio_nbytes = CHUNK_SIZE,
+			.aio_sigevent = {
+				.sigev_notify = SIGEV_THREAD,
+				.sigev_notify_function = notify,
+				.sigev_value.sival_int = 42,
+			},
+		};
+		zassert_ok(aio_read(&cbs[i]));
+		zassert_equal(aio_error(&cbs[i]), EINPROGRESS);
+	}
+
+	zassert_equal(aio_suspend(list, ARRAY_SIZE(list), &timeout), -1);
+	zassert_equal(errno, EAGAIN);
+
+	zassert_equal(aio_cancel(fd, &cbs[0]), AIO_CANCELED);
+	zassert_equal(aio_error(&cbs[0]), ECANCELED);
+	zassert_equal(aio_error(&cbs[1]), EINPROGRESS);
+	zassert_equal(aio_cancel(fd, NULL), AIO_CANCELED);
+	zassert_equal(aio_error(&cbs[1]), ECANCELED);
+	zassert_equal(k_sem_count_get(&notified), 2);
+
+	/* Completed, but not reaped yet */
+	zassert_equal(aio_cancel(fd, NULL), AIO_ALLDONE);
+
+	for (int i = 0; i < ARRAY_SIZE(cbs); i++) {
+		zassert_equal(aio_return(&cbs[i]), -1);
+		zassert_equal(errno, ECANCELED);
+	}
+
+	k_sem_give(&release);
+	test_aio_wait(&blocking);
+	zassert_ok(aio_return(&blocking));
+
+	zassert_ok(close(fd));
+}
+
+ZTEST(posix_aio, test_aio_errors)
+{
+	static uint8_t buf[CHUNK_SIZE];
+	struct aiocb cb = {.aio_fildes = -1, .aio_buf = buf, .aio_nbytes = CHUNK_SIZE};
+	struct aiocb *list[AIO_LISTIO_MAX + 1] = {&cb};
+	const struct aiocb *const suspend_list[] = {&cb};
+	struct timespec timeout = {.tv_nsec = 1000000};
+
+	/* Reported on completion */
+	zassert_ok(aio_read(&cb));
+	test_aio_wait(&cb);
+	zassert_equal(aio_error(&cb), EBADF);
+	zassert_equal(aio_return(&cb), -1);
+	zassert_equal(errno, EBADF);
+
+	/* Not submitted, so not in progress */
+	zassert_ok(aio_suspend(suspend_list, ARRAY_SIZE(suspend_list), &timeout));
+	zassert_equal(aio_cancel(-1, NULL), AIO_ALLDONE);
+
+	zassert_equal(aio_read(NULL), -1);
+	zassert_equal(errno, EINVAL);
+
+	cb.aio_offset = -1;
+	zassert_equal(aio_write(&cb), -1);
+	zassert_equal(errno, EINVAL);
+
+	cb.aio_offset = 0;
+	cb.aio_reqprio = AIO_PRIO_DELTA_MAX + 1;
+	zassert_equal(aio_read(&cb), -1);
+	zassert_equal(errno, EINVAL);
+
+	cb.aio_reqprio = 0;
+	cb.aio_sigevent.sigev_notify = SIGEV_THREAD;
+	zassert_equal(aio_read(&cb), -1);
+	zassert_equal(errno, EINVAL);
+
+	cb.aio_sigevent.sigev_notify = SIGEV_SIGNAL;
+	cb.aio_sigevent.sigev_signo = SIGUSR1;
+	zassert_equal(aio_read(&cb), -1);
+	zassert_equal(errno, EINVAL);
+
+	cb.aio_sigevent.sigev_notify = SIGEV_NONE;
+	zassert_equal(aio_cancel(0, &cb), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(lio_listio(LIO_WAIT + LIO_NOWAIT + 1, list, 1, NULL), -1);
+	zassert_equal(errno, EINVAL);
+	zassert_equal(lio_listio(LIO_WAIT, list, ARRAY_SIZE(list), NULL), -1);
+	zassert_equal(errno, EINVAL);
+	cb.aio_lio_opcode = LIO_NOP + 1;
+	zassert_equal(lio_listio(LIO_WAIT, list, 1, NULL), -1);
+	zassert_equal(errno, EINVAL);
+
+	/* Failed operation of a list */
+	cb.aio_lio_opcode = LIO_READ;
+	zassert_equal(lio_listio(LIO_WAIT, list, 1, NULL), -1);
+	zassert_equal(errno, EIO);
+	zassert_equal(aio_error(&cb), EBADF);
+	zassert_equal(aio_return(&cb), -1);
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	(void)unlink(TEST_AIO_FILE);
+}
+
+ZTEST_SUITE(posix_aio, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Writes then reads a file block by block, computing each block before it is
+ * written and after it is read. This is done with write() and read(), then
+ * with the I/O of a block overlapped with the computation of the next one.
+ *
+ * The computation is modelled with a busy wait, so that it takes the same time
+ * on all targets, including native_sim where time only advances when waiting.
+ */
+
+#include <aio.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_aio.h"
+
+#define BLOCK_SIZE 1024
+#define NUM_BLOCKS 32
+#define COMPUTE_US 500
+
+static uint8_t bufs[2][BLOCK_SIZE];
+static struct aiocb cbs[2];
+
+static void produce(uint8_t *buf, int block)
+{
+	k_busy_wait(COMPUTE_US);
+
+	for (size_t i = 0; i < BLOCK_SIZE; i++) {
+		buf[i] = (uint8_t)(block * 31 + i);
+	}
+}
+
+static void consume(const uint8_t *buf, int block)
+{
+	k_busy_wait(COMPUTE_US);
+
+	for (size_t i = 0; i < BLOCK_SIZE; i++) {
+		zassert_equal(buf[i], (uint8_t)(block * 31 + i), "block %d byte %zu", block, i);
+	}
+}
+
+static void write_sync(int fd)
+{
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		produce(bufs[0], i);
+		zassert_equal(write(fd, bufs[0], BLOCK_SIZE), BLOCK_SIZE);
+	}
+
+	zassert_ok(fsync(fd));
+}
+
+static void read_sync(int fd)
+{
+	zassert_equal(lseek(fd, 0, SEEK_SET), 0);
+
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		zassert_equal(read(fd, bufs[0], BLOCK_SIZE), BLOCK_SIZE);
+		consume(bufs[0], i);
+	}
+}
+
+static void submit(int fd, int block, bool is_write)
+{
+	struct aiocb *cb = &cbs[block % 2];
+
+	*cb = (struct aiocb){
+		.aio_fildes = fd,
+		.aio_offset = block * BLOCK_SIZE,
+		.aio_buf = bufs[block % 2],
+		.aio_nbytes = BLOCK_SIZE,
+	};
+
+	zassert_ok(is_write ? aio_write(cb) : aio_read(cb));
+}
+
+static void complete(int block)
+{
+	struct aiocb *cb = &cbs[block % 2];
+
+	test_aio_wait(cb);
+	zassert_equal(aio_return(cb), BLOCK_SIZE, "block %d: %d", block, aio_error(cb));
+}
+
+/* Each block is written while the next one is computed in the other buffer */
+static void write_overlapped(int fd)
+{
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		if (i >= 2) {
+			complete(i - 2);
+		}
+
+		produce(bufs[i % 2], i);
+		submit(fd, i, true);
+	}
+
+	complete(NUM_BLOCKS - 2);
+	complete(NUM_BLOCKS - 1);
+	zassert_ok(fsync(fd));
+}
+
+/* Each block is read while the previous one is used in the other buffer */
+static void read_overlapped(int fd)
+{
+	submit(fd, 0, false);
+
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		complete(i);
+		if (i + 1 < NUM_BLOCKS) {
+			submit(fd, i + 1, false);
+		}
+
+		consume(bufs[i % 2], i);
+	}
+}
+
+static uint32_t measure(void (*func)(int fd), int fd)
+{
+	uint32_t start = k_cycle_get_32();
+
+	func(fd);
+
+	return MAX((uint32_t)k_cyc_to_us_ceil64(k_cycle_get_32() - start), 1);
+}
+
+static void report(const char *name, uint32_t sync_us, uint32_t overlapped_us)
+{
+	uint64_t bytes = (uint64_t)NUM_BLOCKS * BLOCK_SIZE;
+
+	TC_PRINT("%s %llu bytes: sync %u us (%llu KiB/s), overlapped %u us (%llu KiB/s), "
+		 "gain %d%%\n", name, bytes, sync_us, bytes * 1000000U / 1024U / sync_us,
+		 overlapped_us, bytes * 1000000U / 1024U / overlapped_us,
+		 (int)(((int64_t)sync_us - overlapped_us) * 100 / overlapped_us));
+}
+
+ZTEST(posix_aio, test_aio_overlap)
+{
+	uint32_t sync_us, overlapped_us;
+	int fd;
+
+	fd = test_aio_open();
+	sync_us = measure(write_sync, fd);
+	zassert_ok(close(fd));
+
+	zassert_ok(unlink(TEST_AIO_FILE));
+	fd = test_aio_open();
+	overlapped_us = measure(write_overlapped, fd);
+	report("write", sync_us, overlapped_us);
+
+	sync_us = measure(read_sync, fd);
+	overlapped_us = measure(read_overlapped, fd);
+	report("read", sync_us, overlapped_us);
+
+	zassert_ok(close(fd));
+}
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTS_POSIX_AIO_SRC_TEST_AIO_H_
+#define ZEPHYR_TESTS_POSIX_AIO_SRC_TEST_AIO_H_
+
+#include <aio.h>
+
+#define TEST_AIO_FILE "/lfs/aio"
+
+int test_aio_open(void);
+void test_aio_wait(struct aiocb *cb);
+
+#endif /* ZEPHYR_TESTS_POSIX_AIO_SRC_TEST_AIO_H_ */
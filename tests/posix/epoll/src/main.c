@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/posix/arpa/inet.h>
+#include <zephyr/posix/netinet/in.h>
+#include <zephyr/posix/sys/epoll.h>
+#include <zephyr/posix/sys/eventfd.h>
+#include <zephyr/posix/sys/socket.h>
+#include <zephyr/posix/unistd.h>
+#include <zephyr/ztest.h>
+
+#define NUM_FDS  3
+#define WAIT_MS  50
+#define UDP_PORT 4242
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct epoll_fixture {
+	int epfd;
+	int fds[NUM_FDS];
+};
+
+static struct epoll_fixture fixture;
+
+static void add(int epfd, int fd, uint32_t events)
+{
+	struct epoll_event ev = {
+		.events = events,
+		.data.fd = fd,
+	};
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev), "errno %d", errno);
+}
+
+static void epoll_before(void *arg)
+{
+	struct epoll_fixture *f = arg;
+
+	f->epfd = epoll_create1(0);
+	zassert_true(f->epfd >= 0, "epoll_create1() failed: %d", errno);
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		f->fds[i] = eventfd(0, EFD_NONBLOCK);
+		zassert_true(f->fds[i] >= 0, "eventfd() failed: %d", errno);
+		add(f->epfd, f->fds[i], EPOLLIN);
+	}
+}
+
+static void epoll_after(void *arg)
+{
+	struct epoll_fixture *f = arg;
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		if (f->fds[i] >= 0) {
+			zassert_ok(close(f->fds[i]));
+		}
+	}
+	zassert_ok(close(f->epfd));
+}
+
+ZTEST_F(epoll, test_epoll_ctl)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN,
+	};
+	int fd = fixture->fds[0];
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fd, &ev), -1);
+	zassert_equal(errno, EEXIST);
+
+	zassert_ok(epoll_ctl(fixture->epfd, EPOLL_CTL_DEL, fd, NULL));
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_DEL, fd, NULL), -1);
+	zassert_equal(errno, ENOENT);
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_MOD, fd, &ev), -1);
+	zassert_equal(errno, ENOENT);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fixture->epfd,
+				&ev), -1);
+	zassert_equal(errno, EINVAL);
+	zassert_equal(epoll_ctl(fd, EPOLL_CTL_ADD, fixture->fds[1], &ev), -1);
+	zassert_equal(errno, EINVAL);
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, -1, &ev), -1);
+	zassert_equal(errno, EBADF);
+}
+
+ZTEST_F(epoll, test_epoll_wait_ready)
+{
+	struct epoll_event events[NUM_FDS];
+
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, 0), 0);
+
+	zassert_ok(eventfd_write(fixture->fds[1], 1));
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, 0), 1);
+	zassert_equal(events[0].events, EPOLLIN);
+	zassert_equal(events[0].data.fd, fixture->fds[1]);
+
+	/* Level-triggered: reported as long as it is readable */
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, 0), 1);
+	zassert_equal(events[0].data.fd, fixture->fds[1]);
+
+	zassert_ok(eventfd_write(fixture->fds[2], 1));
+	zassert_ok(eventfd_write(fixture->fds[0], 1));
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, 0), 3);
+
+	/* The file descriptors ready take turns */
+	zassert_equal(epoll_wait(fixture->epfd, events, 1, 0), 1);
+	zassert_equal(events[0].data.fd, fixture->fds[1]);
+	zassert_equal(epoll_wait(fixture->epfd, events, 1, 0), 1);
+	zassert_equal(events[0].data.fd, fixture->fds[2]);
+	zassert_equal(epoll_wait(fixture->epfd, events, 1, 0), 1);
+	zassert_equal(events[0].data.fd, fixture->fds[0]);
+
+	for (int i = 0; i < NUM_FDS; i++) {
+		eventfd_t val;
+
+		zassert_ok(eventfd_read(fixture->fds[i], &val));
+	}
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, 0), 0);
+}
+
+ZTEST_F(epoll, test_epoll_mod)
+{
+	struct epoll_event events[NUM_FDS];
+	struct epoll_event ev = {
+		.events = EPOLLIN | EPOLLOUT,
+		.data.u32 = 42,
+	};
+
+	zassert_ok(epoll_ctl(fixture->epfd, EPOLL_CTL_MOD, fixture->fds[0],
+			     &ev));
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, 0), 1);
+	zassert_equal(events[0].events, EPOLLOUT);
+	zassert_equal(events[0].data.u32, 42);
+
+	zassert_ok(eventfd_write(fixture->fds[0], 1));
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, 0), 1);
+	zassert_equal(events[0].events, EPOLLIN | EPOLLOUT);
+}
+
+ZTEST_F(epoll, test_epoll_close)
+{
+	struct epoll_event events[NUM_FDS];
+
+	zassert_ok(eventfd_write(fixture->fds[0], 1));
+
+	/* A file descriptor closed leaves the instance */
+	zassert_ok(close(fixture->fds[0]));
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, 0), 0);
+
+	fixture->fds[0] = eventfd(0, EFD_NONBLOCK);
+	zassert_true(fixture->fds[0] >= 0);
+	add(fixture->epfd, fixture->fds[0], EPOLLIN);
+}
+
+/* A UDP socket is always writable, so is checked on each wait without
+ * waiting: its other events must not be reported from an earlier wait.
+ */
+ZTEST_F(epoll, test_epoll_always)
+{
+	struct epoll_event events[NUM_FDS];
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(UDP_PORT),
+		.sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+	};
+	char buf[4] = "ping";
+	int sock;
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	zassert_true(sock >= 0, "socket() failed: %d", errno);
+	zassert_ok(bind(sock, (struct sockaddr *)&addr, sizeof(addr)));
+	add(fixture->epfd, sock, EPOLLIN | EPOLLOUT);
+
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, 0), 1);
+	zassert_equal(events[0].events, EPOLLOUT);
+
+	zassert_equal(sendto(sock, buf, sizeof(buf), 0, (struct sockaddr *)&addr,
+			     sizeof(addr)), sizeof(buf));
+	k_msleep(WAIT_MS);
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, 0), 1);
+	zassert_equal(events[0].events, EPOLLIN | EPOLLOUT);
+
+	zassert_equal(recv(sock, buf, sizeof(buf), 0), sizeof(buf));
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, 0), 1);
+	zassert_equal(events[0].events, EPOLLOUT, "stale events 0x%x", events[0].events);
+
+	zassert_ok(close(sock));
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	k_msleep(WAIT_MS);
+	zassert_ok(eventfd_write(POINTER_TO_INT(p1), 1));
+}
+
+static K_THREAD_STACK_DEFINE(writer_stack, STACK_SIZE);
+static struct k_thread writer;
+
+ZTEST_F(epoll, test_epoll_wait_block)
+{
+	struct epoll_event events[NUM_FDS];
+
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, WAIT_MS), 0);
+
+	k_thread_create(&writer, writer_stack, STACK_SIZE, writer_entry,
+			INT_TO_POINTER(fixture->fds[2]), NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(epoll_wait(fixture->epfd, events, NUM_FDS, -1), 1);
+	zassert_equal(events[0].data.fd, fixture->fds[2]);
+
+	zassert_ok(k_thread_join(&writer, K_FOREVER));
+}
+
+static void *epoll_setup(void)
+{
+	return &fixture;
+}
+
+ZTEST_SUITE(epoll, NULL, epoll_setup, epoll_before, epoll_after, NULL);
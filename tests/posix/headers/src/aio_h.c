@@ -22,6 +22,16 @@ ZTEST(posix_headers, test_aio_h)
 	zassert_not_equal(offsetof(struct aiocb, aio_sigevent), -1);
 	zassert_not_equal(offsetof(struct aiocb, aio_lio_opcode), -1);
 
+	zassert_not_equal(AIO_ALLDONE, AIO_CANCELED);
+	zassert_not_equal(AIO_ALLDONE, AIO_NOTCANCELED);
+	zassert_not_equal(AIO_CANCELED, AIO_NOTCANCELED);
+
+	zassert_not_equal(LIO_NOP, LIO_READ);
+	zassert_not_equal(LIO_NOP, LIO_WRITE);
+	zassert_not_equal(LIO_READ, LIO_WRITE);
+
+	zassert_not_equal(LIO_NOWAIT, LIO_WAIT);
+
 	if (IS_ENABLED(CONFIG_POSIX_API)) {
 		zassert_not_null(aio_cancel);
 		zassert_not_null(aio_error);
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/debug/sampling_profiler.h>
+
+#define FREQUENCY 100
+#define BUSY_MS   300
+/* Larger than the code of profiled_busy() */
+#define BUSY_CODE_SIZE 256
+
+static struct sampling_profiler_sample samples[CONFIG_SAMPLING_PROFILER_BUFFER_SIZE];
+
+static __attribute__((noinline)) void profiled_busy(int ms)
+{
+	for (int i = 0; i < ms; i++) {
+		k_busy_wait(USEC_PER_MSEC);
+	}
+}
+
+static bool in_profiled_busy(const struct sampling_profiler_sample *sample)
+{
+	for (int i = 0; (i < CONFIG_SAMPLING_PROFILER_DEPTH) &&
+			(sample->pc[i] != 0U); i++) {
+		uintptr_t offset = sample->pc[i] - (uintptr_t)profiled_busy;
+
+		if (offset < BUSY_CODE_SIZE) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+ZTEST(sampling_profiler, test_start_stop)
+{
+	zassert_equal(sampling_profiler_start(0), -EINVAL);
+	zassert_equal(sampling_profiler_start(CONFIG_SYS_CLOCK_TICKS_PER_SEC + 1),
+		      -EINVAL);
+
+	zassert_ok(sampling_profiler_start(FREQUENCY));
+	zassert_equal(sampling_profiler_start(FREQUENCY), -EALREADY);
+	sampling_profiler_stop();
+
+	/* Nothing is sampled once stopped */
+	(void)sampling_profiler_read(0, samples, ARRAY_SIZE(samples));
+	k_msleep(BUSY_MS);
+	zassert_equal(sampling_profiler_read(0, samples, ARRAY_SIZE(samples)), 0);
+}
+
+ZTEST(sampling_profiler, test_samples)
+{
+	size_t num_samples;
+	size_t num_busy = 0;
+
+	zassert_ok(sampling_profiler_start(FREQUENCY));
+	profiled_busy(BUSY_MS);
+	sampling_profiler_stop();
+
+	num_samples = sampling_profiler_read(0, samples, ARRAY_SIZE(samples));
+	zassert_true(num_samples >= BUSY_MS * FREQUENCY / MSEC_PER_SEC / 2,
+		     "%zu samples only", num_samples);
+	zassert_equal(sampling_profiler_dropped(0), 0);
+
+	for (size_t i = 0; i < num_samples; i++) {
+		zassert_equal_ptr(samples[i].thread, k_current_get());
+		num_busy += in_profiled_busy(&samples[i]) ? 1 : 0;
+	}
+
+	/* The function busy is found in the stacks sampled */
+	zassert_true(num_busy >= num_samples / 2, "%zu of %zu samples",
+		     num_busy, num_samples);
+	zassert_equal(sampling_profiler_read(0, samples, ARRAY_SIZE(samples)), 0);
+}
+
+ZTEST(sampling_profiler, test_dropped)
+{
+	zassert_ok(sampling_profiler_start(FREQUENCY));
+	profiled_busy(2 * ARRAY_SIZE(samples) * MSEC_PER_SEC / FREQUENCY);
+	sampling_profiler_stop();
+
+	/* The oldest samples are kept */
+	zassert_equal(sampling_profiler_read(0, samples, ARRAY_SIZE(samples)),
+		      ARRAY_SIZE(samples));
+	zassert_true(sampling_profiler_dropped(0) > 0);
+	zassert_equal(sampling_profiler_read(0, samples, ARRAY_SIZE(samples)), 0);
+}
+
+ZTEST_SUITE(sampling_profiler, NULL, NULL, NULL, NULL, NULL);
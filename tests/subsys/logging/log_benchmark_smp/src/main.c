@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Deferred logging from several CPUs
+ *
+ * A thread per CPU logs at once, and the cycles taken by a LOG_INF call are
+ * reported for 1 to 4 CPUs, along with the messages dropped. Compare with and
+ * without CONFIG_LOG_PER_CPU_BUFFERS.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_internal.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define MAX_CPUS 4
+#define ITERATIONS 1000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_CPUS, STACK_SIZE);
+static struct k_thread threads[MAX_CPUS];
+static uint32_t cycles[MAX_CPUS];
+static atomic_t ready;
+
+static uint32_t processed;
+static uint32_t dropped;
+static uint32_t unordered;
+static log_timestamp_t prev_timestamp;
+
+static void process(struct log_backend const *const backend,
+		    union log_msg_generic *msg)
+{
+	log_timestamp_t timestamp = log_msg_get_timestamp(&msg->log);
+
+	ARG_UNUSED(backend);
+
+	if (timestamp < prev_timestamp) {
+		unordered++;
+	}
+	prev_timestamp = timestamp;
+	processed++;
+}
+
+static void drop(struct log_backend const *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	dropped += cnt;
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	ARG_UNUSED(backend);
+}
+
+static const struct log_backend_api backend_api = {
+	.process = process,
+	.panic = panic,
+	.dropped = drop,
+};
+
+LOG_BACKEND_DEFINE(backend, backend_api, false);
+
+static void logger(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	int num = POINTER_TO_INT(p2);
+	uint32_t start;
+
+	ARG_UNUSED(p3);
+
+	/* Start together, each on a CPU */
+	atomic_inc(&ready);
+	while (atomic_get(&ready) < num) {
+		arch_spin_relax();
+	}
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		LOG_INF("thread %d message %d", id, i);
+	}
+
+	cycles[id] = k_cycle_get_32() - start;
+}
+
+static void run(int num)
+{
+	uint32_t cpu_dropped[MAX_CPUS];
+	uint32_t total = 0;
+
+	for (int i = 0; i < MAX_CPUS; i++) {
+		cpu_dropped[i] = log_cpu_dropped_get(i);
+	}
+
+	atomic_clear(&ready);
+	processed = 0;
+	dropped = 0;
+	unordered = 0;
+	prev_timestamp = 0;
+
+	for (int i = 0; i < num; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, logger,
+				INT_TO_POINTER(i), INT_TO_POINTER(num), NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < num; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total += cycles[i];
+	}
+
+	while (log_process()) {
+	}
+	/* Not reported yet to the backend */
+	dropped += z_log_dropped_read_and_clear();
+
+	TC_PRINT("%d CPU(s): %u cycles per LOG_INF, %u processed, %u dropped, %u unordered\n",
+		 num, total / (num * ITERATIONS), processed, dropped, unordered);
+
+	if (IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) {
+		for (int i = 0; i < num; i++) {
+			TC_PRINT("\tCPU %d: %u dropped\n", i,
+				 log_cpu_dropped_get(i) - cpu_dropped[i]);
+		}
+	}
+
+	zassert_equal(processed + dropped, num * ITERATIONS, "Messages lost");
+}
+
+ZTEST(test_log_benchmark_smp, test_log_inf_cycles)
+{
+	int num_cpus = MIN(MAX_CPUS, arch_num_cpus());
+
+	for (int num = 1; num <= num_cpus; num++) {
+		run(num);
+	}
+}
+
+static void *log_benchmark_smp_setup(void)
+{
+	TC_PRINT("CPUS: %u, PER_CPU_BUFFERS: %d, LOCKFREE: %d, BUFFER_SIZE: %d\n",
+		 arch_num_cpus(), IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS),
+		 IS_ENABLED(CONFIG_MPSC_PBUF_LOCKFREE), CONFIG_LOG_BUFFER_SIZE);
+
+	log_backend_enable(&backend, NULL, LOG_LEVEL_DBG);
+	while (log_process()) {
+	}
+	z_log_dropped_read_and_clear();
+
+	return NULL;
+}
+
+ZTEST_SUITE(test_log_benchmark_smp, NULL, log_benchmark_smp_setup, NULL, NULL, NULL);
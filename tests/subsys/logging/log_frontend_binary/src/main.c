@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_frontend_binary.h>
+
+#define MODULE_NAME test
+LOG_MODULE_REGISTER(MODULE_NAME, LOG_LEVEL_DBG);
+
+TYPE_SECTION_START_EXTERN(char, log_strings);
+
+#define ITERATIONS 50
+
+static uint32_t records[8][64];
+static size_t num_records;
+
+static int capture(const uint8_t *data, size_t len, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	zassert_true(len <= sizeof(records[0]));
+	zassert_true(num_records < ARRAY_SIZE(records));
+	memcpy(records[num_records++], data, len);
+
+	return len;
+}
+
+static const struct log_frontend_binary_hdr *hdr_get(size_t i)
+{
+	return (const struct log_frontend_binary_hdr *)records[i];
+}
+
+static const uint32_t *args_get(size_t i)
+{
+	return &records[i][sizeof(struct log_frontend_binary_hdr) / sizeof(uint32_t)];
+}
+
+static void check_hdr(size_t i, uint32_t level, const char *fmt, uint32_t desc)
+{
+	const struct log_frontend_binary_hdr *hdr = hdr_get(i);
+
+	zassert_equal(hdr->level, level);
+	zassert_equal(hdr->source,
+		      IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
+		      log_dynamic_source_id(__log_current_dynamic_data) :
+		      log_const_source_id(__log_current_const_data));
+	zassert_equal(hdr->desc, desc, "desc 0x%08x", hdr->desc);
+	if (fmt != NULL) {
+		zassert_str_equal(&TYPE_SECTION_START(log_strings)[hdr->fmt], fmt);
+	}
+}
+
+static void flush(size_t expected)
+{
+	num_records = 0;
+	zassert_equal(log_frontend_binary_flush(), expected);
+	zassert_equal(num_records, expected);
+}
+
+static int count(const uint8_t *data, size_t len, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	memcpy(records[0], data, MIN(len, sizeof(records[0])));
+	num_records++;
+
+	return len;
+}
+
+static void drain(void)
+{
+	log_frontend_binary_output_set(count, NULL);
+	num_records = 0;
+	while (log_frontend_binary_flush() > 0) {
+	}
+}
+
+ZTEST(log_frontend_binary, test_words)
+{
+	LOG_INF("no arguments");
+	LOG_WRN("%d %u %c", -1, 2U, 'a');
+	flush(2);
+
+	check_hdr(0, LOG_LEVEL_INF, "no arguments", 0);
+	zassert_equal(hdr_get(0)->wlen, 4);
+
+	check_hdr(1, LOG_LEVEL_WRN, "%d %u %c", 3U << 28);
+	zassert_equal(hdr_get(1)->wlen, 7);
+	zassert_equal((int32_t)args_get(1)[0], -1);
+	zassert_equal(args_get(1)[1], 2);
+	zassert_equal(args_get(1)[2], 'a');
+}
+
+ZTEST(log_frontend_binary, test_double_words)
+{
+	long long ll = -5000000000LL;
+	double d = 1.5;
+	float f = -0.25f;
+	void *ptr = &ll;
+	uint32_t ptr_type = sizeof(void *) > sizeof(uint32_t) ?
+			    LOG_FRONTEND_BINARY_ARG_DWORD : LOG_FRONTEND_BINARY_ARG_WORD;
+	const uint32_t *args;
+	long long ll_out;
+	double d_out;
+	uintptr_t ptr_out = 0;
+
+	LOG_ERR("%lld %f %f %p", ll, d, (double)f, ptr);
+	flush(1);
+
+	check_hdr(0, LOG_LEVEL_ERR, "%lld %f %f %p",
+		  (4U << 28) | LOG_FRONTEND_BINARY_ARG_DWORD |
+		  (LOG_FRONTEND_BINARY_ARG_DOUBLE << 2) |
+		  (LOG_FRONTEND_BINARY_ARG_DOUBLE << 4) | (ptr_type << 6));
+
+	args = args_get(0);
+	memcpy(&ll_out, &args[0], sizeof(ll_out));
+	zassert_equal(ll_out, ll);
+	memcpy(&d_out, &args[2], sizeof(d_out));
+	zassert_equal(d_out, d);
+	memcpy(&d_out, &args[4], sizeof(d_out));
+	zassert_equal(d_out, (double)f);
+	memcpy(&ptr_out, &args[6], sizeof(void *));
+	zassert_equal(ptr_out, (uintptr_t)ptr);
+}
+
+/* Character pointers may be strings or not, only the format string tells */
+ZTEST(log_frontend_binary, test_strings)
+{
+	char str[] = "hello";
+	uint8_t buf[] = { 'a', 'b' };
+	const char *null_str = NULL;
+	char expected[32];
+	const uint32_t *args;
+
+	LOG_INF("%s %d", str, 7);
+	/* Copied when logged */
+	str[0] = 'j';
+	LOG_INF("%p", (void *)buf);
+	LOG_INF("%p", buf);
+	LOG_INF("%s", null_str);
+	flush(4);
+
+	check_hdr(0, LOG_LEVEL_INF, NULL, (1U << 28) | LOG_FRONTEND_BINARY_ARG_STR);
+	zassert_equal(hdr_get(0)->fmt, LOG_FRONTEND_BINARY_FMT_TEXT);
+	args = args_get(0);
+	zassert_equal(args[0], strlen("hello 7"));
+	zassert_mem_equal(&args[1], "hello 7", strlen("hello 7"));
+
+	/* Not a string, a binary record with the pointer */
+	zassert_not_equal(hdr_get(1)->fmt, LOG_FRONTEND_BINARY_FMT_TEXT);
+
+	/* Only the pointer is printed, not the unterminated buffer */
+	zassert_equal(hdr_get(2)->fmt, LOG_FRONTEND_BINARY_FMT_TEXT);
+	snprintk(expected, sizeof(expected), "%p", (void *)buf);
+	args = args_get(2);
+	zassert_equal(args[0], strlen(expected));
+	zassert_mem_equal(&args[1], expected, strlen(expected));
+
+	zassert_equal(hdr_get(3)->fmt, LOG_FRONTEND_BINARY_FMT_TEXT);
+}
+
+ZTEST(log_frontend_binary, test_hexdump)
+{
+	static const uint8_t data[] = { 1, 2, 3, 4, 5 };
+	const uint32_t *args;
+
+	LOG_HEXDUMP_INF(data, sizeof(data), "data");
+	flush(1);
+
+	zassert_equal(hdr_get(0)->fmt, LOG_FRONTEND_BINARY_FMT_TEXT);
+	check_hdr(0, LOG_LEVEL_INF, NULL,
+		  (2U << 28) | (LOG_FRONTEND_BINARY_ARG_STR << 2) | LOG_FRONTEND_BINARY_ARG_STR);
+
+	args = args_get(0);
+	zassert_equal(args[0], strlen("data"));
+	zassert_mem_equal(&args[1], "data", strlen("data"));
+	zassert_equal(args[2], sizeof(data));
+	zassert_mem_equal(&args[3], data, sizeof(data));
+}
+
+ZTEST(log_frontend_binary, test_dropped)
+{
+	int logged = 0;
+
+	/* Until the buffer is full, and more */
+	for (int i = 0; i < CONFIG_LOG_FRONTEND_BINARY_BUFFER_SIZE / 8; i++) {
+		LOG_INF("fill");
+		logged++;
+	}
+
+	/* The number of records dropped is reported last */
+	log_frontend_binary_output_set(count, NULL);
+	num_records = 0;
+	zassert_equal(log_frontend_binary_flush(), num_records);
+	zassert_equal(hdr_get(0)->fmt, LOG_FRONTEND_BINARY_FMT_DROPPED);
+	zassert_equal(hdr_get(0)->desc, 1U << 28);
+	zassert_equal(args_get(0)[0] + num_records - 1, logged);
+
+	flush(0);
+}
+
+/* Written to the console, to be decoded by log_parser.py */
+ZTEST(log_frontend_binary, test_output)
+{
+	log_frontend_binary_output_set(NULL, NULL);
+
+	LOG_INF("Hello from the binary frontend");
+	LOG_WRN("int %d, unsigned %u, hex 0x%x", -3, 3U, 0xbeefU);
+	LOG_ERR("long long %lld, double %.2f, string %s", -5000000000LL, 3.25, "abc");
+	LOG_HEXDUMP_INF("\x01\x02\x03", 3, "hexdump");
+
+	zassert_equal(log_frontend_binary_flush(), 4);
+}
+
+ZTEST(log_frontend_binary, test_cycles)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		LOG_INF("%d %d", i, 2 * i);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("%u cycles per LOG_INF with 2 arguments\n", cycles / ITERATIONS);
+
+	drain();
+	zassert_equal(num_records, ITERATIONS);
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	drain();
+	log_frontend_binary_output_set(capture, NULL);
+	num_records = 0;
+}
+
+ZTEST_SUITE(log_frontend_binary, NULL, NULL, before, NULL, NULL);
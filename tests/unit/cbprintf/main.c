@@ -172,6 +172,37 @@ static int out(int c, void *dest)
 	return rv;
 }
 
+static char bulk_buf[sizeof(buf)];
+static size_t bulk_idx;
+
+static int bulk_out(const char *data, size_t len, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	if (len > (sizeof(bulk_buf) - bulk_idx)) {
+		return EOF;
+	}
+	memcpy(&bulk_buf[bulk_idx], data, len);
+	bulk_idx += len;
+
+	return (int)len;
+}
+
+/* Output through a bulk callback must be identical to the output one
+ * character at a time, which is in outbuf.
+ */
+static void check_bulk(int rv, int bulk_rv)
+{
+	if (rv < 0) {
+		return;
+	}
+
+	zassert_equal(bulk_rv, rv, "bulk rv %d, expected %d", bulk_rv, rv);
+	zassert_equal(bulk_idx, outbuf.idx, "bulk output length %zu, expected %zu",
+		      bulk_idx, outbuf.idx);
+	zassert_mem_equal(bulk_buf, outbuf.buf, bulk_idx, "bulk output differs");
+}
+
 __printf_like(2, 3)
 static int prf(char *static_package_str, const char *format, ...)
 {
@@ -187,12 +218,20 @@ static int prf(char *static_package_str, const char *format, ...)
 	rv = cbvprintf_package(packaged, sizeof(packaged), PACKAGE_FLAGS, format, ap);
 	if (rv >= 0) {
 		rv = cbpprintf(out, &outbuf, packaged);
+		bulk_idx = 0;
+		check_bulk(rv, cbpprintf_bulk(bulk_out, NULL, packaged));
 		if (rv == 0 && static_package_str) {
 			rv = strcmp(static_package_str, outbuf.buf);
 		}
 	}
 #else
+	va_list ap2;
+
+	va_copy(ap2, ap);
 	rv = cbvprintf(out, &outbuf, format, ap);
+	bulk_idx = 0;
+	check_bulk(rv, cbvprintf_bulk(bulk_out, NULL, format, ap2));
+	va_end(ap2);
 #endif
 	outbuf_null_terminate(&outbuf);
 #endif
@@ -221,10 +260,23 @@ static int rawprf(const char *format, ...)
 		rv = len;
 	}
 	if (rv >= 0) {
+		size_t idx = outbuf.idx;
+
 		rv = cbpprintf(out, &outbuf, pkg_buf);
+		bulk_idx = idx;
+		memcpy(bulk_buf, outbuf.buf, idx);
+		check_bulk(rv, cbpprintf_bulk(bulk_out, NULL, pkg_buf));
 	}
 #else
+	va_list ap2;
+	size_t idx = outbuf.idx;
+
+	va_copy(ap2, ap);
 	rv = cbvprintf(out, &outbuf, format, ap);
+	bulk_idx = idx;
+	memcpy(bulk_buf, outbuf.buf, idx);
+	check_bulk(rv, cbvprintf_bulk(bulk_out, NULL, format, ap2));
+	va_end(ap2);
 #endif
 	va_end(ap);
 
@@ -965,6 +1017,32 @@ ZTEST(prf, test_star_width)
 	PRF_CHECK("/  a/a  /", rc);
 }
 
+/* Bulk output gathers short sequences in a 32 byte buffer, which must be
+ * flushed before the characters emitted one at a time that follow.
+ */
+ZTEST(prf, test_bulk_full_buffer)
+{
+	static const char s32[] = "0123456789abcdef0123456789ABCDEF";
+	int rc;
+
+	TEST_PRF(&rc, "%s%5d|", s32, 42);
+	PRF_CHECK("0123456789abcdef0123456789ABCDEF   42|", rc);
+
+	TEST_PRF(&rc, "%s%40d|", s32, 7);
+	PRF_CHECK("0123456789abcdef0123456789ABCDEF"
+		  "                                       7|", rc);
+
+	TEST_PRF(&rc, "%s%c", s32, 'x');
+	PRF_CHECK("0123456789abcdef0123456789ABCDEFx", rc);
+
+	if (IS_ENABLED(CONFIG_CBPRINTF_NANO)) {
+		return;
+	}
+
+	TEST_PRF(&rc, "%s%+d", s32, 5);
+	PRF_CHECK("0123456789abcdef0123456789ABCDEF+5", rc);
+}
+
 ZTEST(prf, test_star_precision)
 {
 	int rc;
@@ -278,4 +278,52 @@ ZTEST(crc, test_crc8)
 	zassert_equal(fcs, expected, "0x%02x vs 0x%02x", fcs, expected);
 }
 
+static uint32_t crc32_bitwise(uint32_t poly, uint32_t crc, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+
+		for (int j = 0; j < 8; j++) {
+			crc = (crc >> 1) ^ ((crc & 1U) ? poly : 0U);
+		}
+	}
+
+	return crc;
+}
+
+/* Whatever the tables, against bit by bit computations */
+ZTEST(crc, test_crc_lengths)
+{
+	static uint8_t data[300];
+	uint32_t rnd = 1;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		rnd = rnd * 1103515245U + 12345U;
+		data[i] = (uint8_t)(rnd >> 16);
+	}
+
+	for (size_t off = 0; off < 8; off++) {
+		for (size_t len = 0; len <= sizeof(data) - off; len += (len < 80) ? 1 : 7) {
+			const uint8_t *buf = &data[off];
+			size_t half = len / 2;
+
+			zassert_equal(crc32_ieee(buf, len),
+				      ~crc32_bitwise(0xedb88320U, ~0U, buf, len),
+				      "offset %zu length %zu", off, len);
+			zassert_equal(crc32_ieee_update(crc32_ieee(buf, half), &buf[half],
+							len - half),
+				      crc32_ieee(buf, len), "offset %zu length %zu", off, len);
+			zassert_equal(crc32_c(0, buf, len, true, true),
+				      ~crc32_bitwise(0x82f63b78U, ~0U, buf, len),
+				      "offset %zu length %zu", off, len);
+			zassert_equal(crc16_ccitt(0x1234, buf, len),
+				      crc16_reflect(0x8408, 0x1234, buf, len),
+				      "offset %zu length %zu", off, len);
+			zassert_equal(crc16_itu_t(0x1234, buf, len),
+				      crc16(0x1021, 0x1234, buf, len),
+				      "offset %zu length %zu", off, len);
+		}
+	}
+}
+
 ZTEST_SUITE(crc, NULL, NULL, NULL, NULL, NULL);